@@ -35,10 +35,12 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 Data::Data(const Name& name)
   : m_name(name)
   , m_content(tlv::Content)
+  , m_hasLazyFields(false)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_hasLazyFields(false)
 {
   wireDecode(wire);
 }
@@ -57,15 +59,17 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool wantUnsignedPortionOnly) const
   size_t totalLength = 0;
 
   // SignatureValue
+  const Signature& signature = getSignature();
+
   if (!wantUnsignedPortionOnly) {
-    if (!m_signature) {
+    if (!signature) {
       BOOST_THROW_EXCEPTION(Error("Requested wire format, but Data has not been signed"));
     }
-    totalLength += encoder.prependBlock(m_signature.getValue());
+    totalLength += encoder.prependBlock(signature.getValue());
   }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   // Content
   totalLength += encoder.prependBlock(getContent());
@@ -120,6 +124,18 @@ Data::wireEncode() const
 
 void
 Data::wireDecode(const Block& wire)
+{
+  decode(wire, false);
+}
+
+void
+Data::wireDecodeLazy(const Block& wire)
+{
+  decode(wire, true);
+}
+
+void
+Data::decode(const Block& wire, bool isLazy)
 {
   m_wire = wire;
   m_wire.parse();
@@ -129,6 +145,7 @@ Data::wireDecode(const Block& wire)
   m_content = Block(tlv::Content);
   m_signature = Signature();
   m_fullName.clear();
+  m_hasLazyFields = false;
 
   int lastEle = 0; // last recognized element index, in spec order
   for (const Block& ele : m_wire.elements()) {
@@ -146,7 +163,9 @@ Data::wireDecode(const Block& wire)
         if (lastEle >= 2) {
           BOOST_THROW_EXCEPTION(Error("MetaInfo element is out of order"));
         }
-        m_metaInfo.wireDecode(ele);
+        if (!isLazy) {
+          m_metaInfo.wireDecode(ele);
+        }
         lastEle = 2;
         break;
       }
@@ -163,7 +182,9 @@ Data::wireDecode(const Block& wire)
           BOOST_THROW_EXCEPTION(Error("SignatureInfo element is out of order"));
         }
         hasSigInfo = true;
-        m_signature.setInfo(ele);
+        if (!isLazy) {
+          m_signature.setInfo(ele);
+        }
         lastEle = 4;
         break;
       }
@@ -171,7 +192,9 @@ Data::wireDecode(const Block& wire)
         if (lastEle >= 5) {
           BOOST_THROW_EXCEPTION(Error("SignatureValue element is out of order"));
         }
-        m_signature.setValue(ele);
+        if (!isLazy) {
+          m_signature.setValue(ele);
+        }
         lastEle = 5;
         break;
       }
@@ -191,6 +214,35 @@ Data::wireDecode(const Block& wire)
   if (!hasSigInfo) {
     BOOST_THROW_EXCEPTION(Error("SignatureInfo element is missing"));
   }
+
+  m_hasLazyFields = isLazy;
+}
+
+void
+Data::decodeLazyFieldsFromWire()
+{
+  BOOST_ASSERT(m_hasLazyFields && m_wire.hasWire());
+
+  // element order has been checked in decode()
+  MetaInfo metaInfo;
+  Signature signature;
+  for (const Block& ele : m_wire.elements()) {
+    switch (ele.type()) {
+      case tlv::MetaInfo:
+        metaInfo.wireDecode(ele);
+        break;
+      case tlv::SignatureInfo:
+        signature.setInfo(ele);
+        break;
+      case tlv::SignatureValue:
+        signature.setValue(ele);
+        break;
+    }
+  }
+
+  m_metaInfo = std::move(metaInfo);
+  m_signature = std::move(signature);
+  m_hasLazyFields = false;
 }
 
 const Name&
@@ -210,6 +262,7 @@ Data::getFullName() const
 void
 Data::resetWire()
 {
+  decodeLazyFields();
   m_wire.reset();
   m_fullName.clear();
 }
@@ -313,7 +366,7 @@ Data::setFinalBlock(optional<name::Component> finalBlockId)
 name::Component
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 Data&
@@ -106,6 +106,42 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /** @brief Decode from @p wire, deferring the decoding of MetaInfo and SignatureInfo.
+   *
+   *  Name and Content are decoded immediately, and the presence and order of all elements are
+   *  checked as in wireDecode(). MetaInfo and SignatureInfo, including the KeyLocator, are left
+   *  for decodeLazyFields(). This reduces the cost of receiving a packet that is dropped after
+   *  inspecting its Name only.
+   *
+   *  Until decodeLazyFields() is called, getters of MetaInfo and Signature fields throw Error,
+   *  while setters call it implicitly. Const member functions never decode, so that a Data
+   *  shared between threads through a pointer to const is never modified.
+   *
+   *  @throw Error the Data element is malformed
+   */
+  void
+  wireDecodeLazy(const Block& wire);
+
+  /** @brief Decode MetaInfo and SignatureInfo, if their decoding was deferred by
+   *         wireDecodeLazy()
+   *  @throw tlv::Error MetaInfo or SignatureInfo is malformed
+   */
+  void
+  decodeLazyFields()
+  {
+    if (m_hasLazyFields) {
+      decodeLazyFieldsFromWire();
+    }
+  }
+
+  /** @brief Check if MetaInfo and SignatureInfo are yet to be decoded by decodeLazyFields()
+   */
+  bool
+  hasLazyFields() const
+  {
+    return m_hasLazyFields;
+  }
+
   /** @brief Check if this instance has cached wire encoding.
    */
   bool
@@ -141,6 +177,7 @@ public: // Data fields
   const MetaInfo&
   getMetaInfo() const
   {
+    requireDecoded();
     return m_metaInfo;
   }
 
@@ -188,6 +225,7 @@ public: // Data fields
   const Signature&
   getSignature() const
   {
+    requireDecoded();
     return m_signature;
   }
 
@@ -207,7 +245,7 @@ public: // MetaInfo fields
   uint32_t
   getContentType() const
   {
-    return m_metaInfo.getType();
+    return getMetaInfo().getType();
   }
 
   Data&
@@ -216,7 +254,7 @@ public: // MetaInfo fields
   time::milliseconds
   getFreshnessPeriod() const
   {
-    return m_metaInfo.getFreshnessPeriod();
+    return getMetaInfo().getFreshnessPeriod();
   }
 
   Data&
@@ -225,7 +263,7 @@ public: // MetaInfo fields
   const optional<name::Component>&
   getFinalBlock() const
   {
-    return m_metaInfo.getFinalBlock();
+    return getMetaInfo().getFinalBlock();
   }
 
   Data&
@@ -252,6 +290,24 @@ protected:
   void
   resetWire();
 
+private:
+  void
+  decode(const Block& wire, bool isLazy);
+
+  /** @throw Error MetaInfo and SignatureInfo are yet to be decoded by decodeLazyFields()
+   */
+  void
+  requireDecoded() const
+  {
+    if (m_hasLazyFields) {
+      BOOST_THROW_EXCEPTION(Error("MetaInfo and SignatureInfo have not been decoded, "
+                                  "call decodeLazyFields() first"));
+    }
+  }
+
+  void
+  decodeLazyFieldsFromWire();
+
 private:
   Name m_name;
   MetaInfo m_metaInfo;
@@ -260,6 +316,7 @@ private:
 
   mutable Block m_wire;
   mutable Name m_fullName; ///< cached FullName computed from m_wire
+  bool m_hasLazyFields; ///< MetaInfo and SignatureInfo are yet to be decoded from m_wire
 };
 
 #ifndef DOXYGEN
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -34,8 +34,10 @@
 #include "../transport/tcp-transport.hpp"
 #include "../transport/unix-transport.hpp"
 #include "../util/config-file.hpp"
+#include "../util/face-metrics.hpp"
 #include "../util/logger.hpp"
 #include "../util/scheduler.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
 #include "../util/signal.hpp"
 
 NDN_LOG_INIT(ndn.Face);
@@ -59,7 +61,7 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  using PendingInterestTable = ContainerWithOnEmptySignal<shared_ptr<PendingInterest>>;
+  using PendingInterestTable = ndn::PendingInterestTable;
   using InterestFilterTable = std::list<shared_ptr<InterestFilterRecord>>;
   using RegisteredPrefixTable = ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>>;
 
@@ -68,6 +70,9 @@ public:
     : m_face(face)
     , m_scheduler(m_face.getIoService())
     , m_processEventsTimeoutEvent(m_scheduler)
+    , m_expiryEvent(m_scheduler)
+    , m_aggregationBuckets(16)
+    , m_aggregationIndex({m_aggregationBuckets.data(), m_aggregationBuckets.size()})
   {
     auto postOnEmptyPitOrNoRegisteredPrefixes = [this] {
       this->m_face.getIoService().post([this] { this->onEmptyPitOrNoRegisteredPrefixes(); });
@@ -78,6 +83,11 @@ public:
     };
 
     m_pendingInterestTable.onEmpty.connect(postOnEmptyPitOrNoRegisteredPrefixes);
+    m_pendingInterestTable.onEmpty.connect([this] {
+      // the sweep timer must not keep io_service running when nothing is pending
+      m_expiryEvent.cancel();
+      m_nextExpirySweep = nullopt;
+    });
     m_registeredPrefixTable.onEmpty.connect(postOnEmptyPitOrNoRegisteredPrefixes);
   }
 
@@ -88,38 +98,110 @@ public: // consumer
                        const NackCallback& afterNacked,
                        const TimeoutCallback& afterTimeout)
   {
-    NDN_LOG_DEBUG("<I " << *interest);
-    this->ensureConnected(true);
-
     const Interest& interest2 = *interest;
-    auto i = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      std::move(interest), afterSatisfied, afterNacked, afterTimeout, ref(m_scheduler))).first;
     // In dispatchInterest, an InterestCallback may respond with Data right away and delete
-    // the PendingInterestTable entry. shared_ptr is retained to ensure PendingInterest instance
+    // the PendingInterestTable entry. A reference is retained to ensure PendingInterest instance
     // remains valid in this case.
-    shared_ptr<PendingInterest> entry = *i;
-    entry->setDeleter([this, i] { m_pendingInterestTable.erase(i); });
+    PendingInterestPtr entry = PendingInterest::create(m_pendingInterestPool, std::move(interest),
+                                                       afterSatisfied, afterNacked, afterTimeout);
+
+    if (m_wantInterestAggregation) {
+      const PendingInterest* leader = findAggregatableEntry(*entry);
+      if (leader != nullptr) {
+        NDN_LOG_DEBUG("   aggregating " << interest2 << " onto " << *leader->getInterest());
+        entry->aggregateOnto(*leader);
+        m_pendingInterestTable.insert(entry);
+        insertIntoExpiryQueue(*entry);
+        m_metrics.recordPitSize(m_pendingInterestTable.size());
+        m_metrics.recordSuppressedInterest();
+        return;
+      }
+    }
+
+    NDN_LOG_DEBUG("<I " << interest2);
+    this->ensureConnected(true);
+
+    m_pendingInterestTable.insert(entry);
+    insertIntoExpiryQueue(*entry);
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
 
     lp::Packet lpPacket;
     addFieldFromTag<lp::NextHopFaceIdField, lp::NextHopFaceIdTag>(lpPacket, interest2);
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, interest2);
 
     entry->recordForwarding();
+    entry->recordSentToForwarder();
     m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest2.wireEncode(),
                                             'I', interest2.getName()));
+    m_metrics.recordOutInterest();
+    if (m_wantInterestAggregation) {
+      insertIntoAggregationIndex(*entry);
+    }
     dispatchInterest(*entry, interest2);
   }
 
+  /** @return a pending Interest record that has been sent to the forwarder, whose Interest is
+   *          equivalent to that of @p entry and which does not expire before @p entry,
+   *          or nullptr if there is none
+   *
+   *  Two Interests are equivalent if they have the same Name, Selectors, ForwardingHint, and
+   *  NextHopFaceId tag, so that the forwarder would treat them in the same way.
+   */
+  const PendingInterest*
+  findAggregatableEntry(const PendingInterest& entry) const
+  {
+    const Interest& interest = *entry.getInterest();
+    auto nextHopTag = interest.getTag<lp::NextHopFaceIdTag>();
+    auto range = m_aggregationIndex.equal_range(interest.getName(), PendingInterestNameHash(),
+                                                PendingInterestNameEqual());
+    for (auto i = range.first; i != range.second; ++i) {
+      const PendingInterest& leader = *i;
+      BOOST_ASSERT(leader.isSentToForwarder());
+      if (leader.getExpiry() < entry.getExpiry()) {
+        // the forwarder could drop its PIT entry before the new Interest times out
+        continue;
+      }
+
+      const Interest& other = *leader.getInterest();
+      auto otherNextHopTag = other.getTag<lp::NextHopFaceIdTag>();
+      if (other.matchesInterest(interest) &&
+          other.getForwardingHint() == interest.getForwardingHint() &&
+          (nextHopTag == nullptr ? otherNextHopTag == nullptr :
+           otherNextHopTag != nullptr && otherNextHopTag->get() == nextHopTag->get())) {
+        return &leader;
+      }
+    }
+    return nullptr;
+  }
+
+  /** @brief make a pending Interest that has been sent to the forwarder available for
+   *         aggregation, until it leaves the PendingInterestTable
+   */
+  void
+  insertIntoAggregationIndex(PendingInterest& entry)
+  {
+    // the index holds no more records than the PIT, so this keeps the load factor at most one
+    if (m_pendingInterestTable.size() > m_aggregationBuckets.size()) {
+      std::vector<PendingInterestAggregationIndex::bucket_type> buckets(
+        std::max(m_aggregationBuckets.size() * 2, m_pendingInterestTable.size()));
+      m_aggregationIndex.rehash({buckets.data(), buckets.size()});
+      m_aggregationBuckets = std::move(buckets);
+    }
+    m_aggregationIndex.insert(entry);
+  }
+
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
     m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
   }
 
   void
   asyncRemoveAllPendingInterests()
   {
     m_pendingInterestTable.clear();
+    m_metrics.recordPitSize(0);
   }
 
   /** @return whether the Data should be sent to the forwarder, if it does not come from the forwarder
@@ -128,8 +210,9 @@ public: // consumer
   satisfyPendingInterests(const Data& data)
   {
     bool hasAppMatch = false, hasForwarderMatch = false;
+    optional<time::steady_clock::TimePoint> now;
     for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
-      shared_ptr<PendingInterest> entry = *i;
+      PendingInterestPtr entry(&*i);
       if (!entry->getInterest()->matchesData(data)) {
         ++i;
         continue;
@@ -140,12 +223,17 @@ public: // consumer
 
       if (entry->getOrigin() == PendingInterestOrigin::APP) {
         hasAppMatch = true;
+        if (!now) {
+          now = time::steady_clock::now();
+        }
+        m_metrics.recordSatisfiedInterest(*now - entry->getExpressTime());
         entry->invokeDataCallback(data);
       }
       else {
         hasForwarderMatch = true;
       }
     }
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
     // if Data matches no pending Interest record, it is sent to the forwarder as unsolicited Data
     return hasForwarderMatch || !hasAppMatch;
   }
@@ -157,7 +245,7 @@ public: // consumer
   {
     optional<lp::Nack> outNack;
     for (auto i = m_pendingInterestTable.begin(); i != m_pendingInterestTable.end(); ) {
-      shared_ptr<PendingInterest> entry = *i;
+      PendingInterestPtr entry(&*i);
       if (!nack.getInterest().matchesInterest(*entry->getInterest())) {
         ++i;
         continue;
@@ -172,6 +260,7 @@ public: // consumer
       }
 
       if (entry->getOrigin() == PendingInterestOrigin::APP) {
+        m_metrics.recordNackedInterest();
         entry->invokeNackCallback(*outNack1);
       }
       else {
@@ -179,12 +268,59 @@ public: // consumer
       }
       i = m_pendingInterestTable.erase(i);
     }
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
     // send "least severe" Nack from any PendingInterest record originated from forwarder, because
     // it is unimportant to consider Nack reason for the unlikely case when forwarder sends multiple
     // Interests to an app in a short while
     return outNack;
   }
 
+  /** @brief link a pending Interest into the expiry queue, and reschedule the sweep timer
+   *         if it expires before all other pending Interests
+   */
+  void
+  insertIntoExpiryQueue(PendingInterest& entry)
+  {
+    m_expiryQueue.insert(entry);
+    if (!m_nextExpirySweep || entry.getExpiry() < *m_nextExpirySweep) {
+      scheduleExpirySweep(entry.getExpiry());
+    }
+  }
+
+  void
+  scheduleExpirySweep(time::steady_clock::TimePoint when)
+  {
+    m_nextExpirySweep = when;
+    m_expiryEvent = m_scheduler.scheduleEvent(std::max(time::steady_clock::duration::zero(),
+                                                       when - time::steady_clock::now()),
+                                              [this] { this->sweepExpiredInterests(); });
+  }
+
+  /** @brief time out all pending Interests whose expiry time has been reached
+   */
+  void
+  sweepExpiredInterests()
+  {
+    m_nextExpirySweep = nullopt;
+    auto now = time::steady_clock::now();
+
+    while (!m_expiryQueue.empty() && m_expiryQueue.begin()->getExpiry() <= now) {
+      PendingInterestPtr entry(&*m_expiryQueue.begin());
+      m_expiryQueue.erase(m_expiryQueue.begin());
+      m_pendingInterestTable.erase(m_pendingInterestTable.iterator_to(*entry));
+
+      if (entry->getOrigin() == PendingInterestOrigin::APP) {
+        m_metrics.recordTimedOutInterest();
+        entry->invokeTimeoutCallback();
+      }
+    }
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
+
+    if (!m_expiryQueue.empty()) {
+      scheduleExpirySweep(m_expiryQueue.begin()->getExpiry());
+    }
+  }
+
 public: // producer
   void
   asyncSetInterestFilter(shared_ptr<InterestFilterRecord> interestFilterRecord)
@@ -209,13 +345,13 @@ public: // producer
   processIncomingInterest(shared_ptr<const Interest> interest)
   {
     const Interest& interest2 = *interest;
-    auto i = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      std::move(interest), ref(m_scheduler))).first;
     // In dispatchInterest, an InterestCallback may respond with Data right away and delete
-    // the PendingInterestTable entry. shared_ptr is retained to ensure PendingInterest instance
+    // the PendingInterestTable entry. A reference is retained to ensure PendingInterest instance
     // remains valid in this case.
-    shared_ptr<PendingInterest> entry = *i;
-    entry->setDeleter([this, i] { m_pendingInterestTable.erase(i); });
+    PendingInterestPtr entry = PendingInterest::create(m_pendingInterestPool, std::move(interest));
+    m_pendingInterestTable.insert(entry);
+    insertIntoExpiryQueue(*entry);
+    m_metrics.recordPitSize(m_pendingInterestTable.size());
 
     this->dispatchInterest(*entry, interest2);
   }
@@ -249,6 +385,7 @@ public: // producer
 
     m_face.m_transport->send(finishEncoding(std::move(lpPacket), data.wireEncode(),
                                             'D', data.getName()));
+    m_metrics.recordOutData();
   }
 
   void
@@ -269,6 +406,7 @@ public: // producer
     const Interest& interest = outNack->getInterest();
     m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest.wireEncode(),
                                             'N', interest.getName()));
+    m_metrics.recordOutNack();
   }
 
 public: // prefix registration
@@ -315,6 +453,84 @@ public: // prefix registration
     }
   }
 
+  /** @brief state of a registerPrefixes operation
+   */
+  struct BulkRegistration
+  {
+    std::vector<Name> prefixes;
+    RegisterPrefixesCallback onComplete;
+    RegisterPrefixesOptions options;
+    nfd::CommandOptions commandOptions;
+    size_t nextPrefix = 0;
+    size_t nOutstanding = 0;
+    RegisterPrefixesResult result;
+  };
+
+  void
+  registerPrefixes(std::vector<Name> prefixes,
+                   const RegisterPrefixesCallback& onComplete,
+                   const RegisterPrefixesOptions& options)
+  {
+    NDN_LOG_INFO("registering " << prefixes.size() << " prefixes with window " << options.window);
+    auto bulk = make_shared<BulkRegistration>();
+    bulk->prefixes = std::move(prefixes);
+    bulk->onComplete = onComplete;
+    bulk->options = options;
+    bulk->commandOptions.setSigningInfo(options.signingInfo);
+
+    fillRegistrationWindow(bulk);
+  }
+
+  void
+  fillRegistrationWindow(const shared_ptr<BulkRegistration>& bulk)
+  {
+    while (bulk->nOutstanding < bulk->options.window && bulk->nextPrefix < bulk->prefixes.size()) {
+      ++bulk->nOutstanding;
+      sendBulkRegisterCommand(bulk, bulk->nextPrefix++, bulk->options.maxRetries);
+    }
+
+    if (bulk->nOutstanding == 0) {
+      NDN_LOG_INFO("registered " << bulk->result.registered.size() << " prefixes, "
+                   << bulk->result.failed.size() << " failed");
+      if (bulk->onComplete != nullptr) {
+        bulk->onComplete(bulk->result);
+      }
+      bulk->onComplete = nullptr;
+    }
+  }
+
+  void
+  sendBulkRegisterCommand(const shared_ptr<BulkRegistration>& bulk, size_t index, int nRetriesLeft)
+  {
+    nfd::ControlParameters params;
+    params.setName(bulk->prefixes[index]);
+    params.setFlags(bulk->options.flags);
+    m_face.m_nfdController->start<nfd::RibRegisterCommand>(
+      params,
+      [=] (const nfd::ControlParameters&) {
+        const Name& prefix = bulk->prefixes[index];
+        auto record = make_shared<RegisteredPrefix>(prefix, nullptr, bulk->commandOptions);
+        this->afterPrefixRegistered(record, nullptr);
+        auto id = reinterpret_cast<const RegisteredPrefixId*>(record.get());
+        bulk->result.registered.emplace_back(prefix, id);
+        --bulk->nOutstanding;
+        this->fillRegistrationWindow(bulk);
+      },
+      [=] (const nfd::ControlResponse& resp) {
+        const Name& prefix = bulk->prefixes[index];
+        if (resp.getCode() == nfd::Controller::ERROR_TIMEOUT && nRetriesLeft > 0) {
+          NDN_LOG_DEBUG("register prefix timed out, retrying: " << prefix);
+          this->sendBulkRegisterCommand(bulk, index, nRetriesLeft - 1);
+          return;
+        }
+        NDN_LOG_INFO("register prefix failed: " << prefix);
+        bulk->result.failed.emplace_back(prefix, resp.getText());
+        --bulk->nOutstanding;
+        this->fillRegistrationWindow(bulk);
+      },
+      bulk->commandOptions);
+  }
+
   void
   asyncUnregisterPrefix(const RegisteredPrefixId* registeredPrefixId,
                         const UnregisterPrefixSuccessCallback& onSuccess,
@@ -400,18 +616,23 @@ private:
    *  @throw Face::OversizedPacketError wire encoding exceeds limit
    */
   Block
-  finishEncoding(lp::Packet&& lpPacket, Block wire, char pktType, const Name& name)
+  finishEncoding(lp::Packet&& lpPacket, const Block& wire, char pktType, const Name& name)
   {
+    Block outWire;
     if (!lpPacket.empty()) {
       lpPacket.add<lp::FragmentField>(std::make_pair(wire.begin(), wire.end()));
-      wire = lpPacket.wireEncode();
+      outWire = lpPacket.wireEncode();
+    }
+    else {
+      // share the wire buffer without copying the parsed sub-elements of the packet
+      outWire = Block(wire.getBuffer(), wire.begin(), wire.end(), false);
     }
 
-    if (wire.size() > MAX_NDN_PACKET_SIZE) {
-      BOOST_THROW_EXCEPTION(Face::OversizedPacketError(pktType, name, wire.size()));
+    if (outWire.size() > MAX_NDN_PACKET_SIZE) {
+      BOOST_THROW_EXCEPTION(Face::OversizedPacketError(pktType, name, outWire.size()));
     }
 
-    return wire;
+    return outWire;
   }
 
 private:
@@ -419,12 +640,22 @@ private:
   util::Scheduler m_scheduler;
   util::scheduler::ScopedEventId m_processEventsTimeoutEvent;
 
+  PendingInterestPool m_pendingInterestPool;
+  PendingInterestExpiryQueue m_expiryQueue;
+  util::scheduler::ScopedEventId m_expiryEvent;
+  optional<time::steady_clock::TimePoint> m_nextExpirySweep; ///< when m_expiryEvent fires
+  std::vector<PendingInterestAggregationIndex::bucket_type> m_aggregationBuckets;
+  PendingInterestAggregationIndex m_aggregationIndex;
+  // declared after the indexes, so that it is destroyed first
   PendingInterestTable m_pendingInterestTable;
   InterestFilterTable m_interestFilterTable;
   RegisteredPrefixTable m_registeredPrefixTable;
 
   unique_ptr<boost::asio::io_service::work> m_ioServiceWork; // if thread needs to be preserved
 
+  util::FaceMetricsCollector m_metrics;
+  bool m_wantInterestAggregation = false;
+
   friend class Face;
 };
 
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_OBJECT_POOL_HPP
+#define NDN_DETAIL_OBJECT_POOL_HPP
+
+#include "../common.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace ndn {
+
+/**
+ * @brief Allocates objects of type T from slabs of fixed-size slots
+ *
+ * Freed slots are kept on a free list and reused by later allocations, so that a workload with
+ * a steady number of live objects stops calling the global allocator once enough slabs exist.
+ * Slabs are released only when the pool is destroyed.  ObjectPool is not thread-safe.
+ *
+ * @tparam T object type
+ */
+template<typename T>
+class ObjectPool : noncopyable
+{
+public:
+  /**
+   * @param slabSize number of objects in each slab
+   */
+  explicit
+  ObjectPool(size_t slabSize = 256)
+    : m_slabSize(slabSize)
+  {
+    BOOST_ASSERT(slabSize > 0);
+  }
+
+  /**
+   * @pre every object constructed by this pool has been destroyed
+   */
+  ~ObjectPool()
+  {
+    BOOST_ASSERT(m_nObjects == 0);
+  }
+
+  /**
+   * @brief Construct an object in a free slot
+   */
+  template<typename... Args>
+  T*
+  construct(Args&&... args)
+  {
+    Slot* slot = allocate();
+    try {
+      T* obj = new (&slot->storage) T(std::forward<Args>(args)...);
+      ++m_nObjects;
+      return obj;
+    }
+    catch (...) {
+      deallocate(slot);
+      throw;
+    }
+  }
+
+  /**
+   * @brief Destroy an object and return its slot to the pool
+   * @param obj an object constructed by this pool
+   */
+  void
+  destroy(T* obj)
+  {
+    obj->~T();
+    --m_nObjects;
+    deallocate(reinterpret_cast<Slot*>(obj));
+  }
+
+  /**
+   * @return number of live objects
+   */
+  size_t
+  size() const
+  {
+    return m_nObjects;
+  }
+
+  /**
+   * @return number of slots in all slabs
+   */
+  size_t
+  capacity() const
+  {
+    return m_slabs.size() * m_slabSize;
+  }
+
+private:
+  union Slot
+  {
+    Slot* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  Slot*
+  allocate()
+  {
+    if (m_freeList == nullptr) {
+      // the slab is owned before it is added, so that it is freed if the vector cannot grow
+      unique_ptr<Slot[]> slab(new Slot[m_slabSize]);
+      Slot* slots = slab.get();
+      m_slabs.push_back(std::move(slab));
+      for (size_t i = 0; i < m_slabSize; ++i) {
+        slots[i].next = m_freeList;
+        m_freeList = &slots[i];
+      }
+    }
+
+    Slot* slot = m_freeList;
+    m_freeList = slot->next;
+    return slot;
+  }
+
+  void
+  deallocate(Slot* slot)
+  {
+    slot->next = m_freeList;
+    m_freeList = slot;
+  }
+
+private:
+  size_t m_slabSize;
+  std::vector<unique_ptr<Slot[]>> m_slabs;
+  Slot* m_freeList = nullptr;
+  size_t m_nObjects = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_OBJECT_POOL_HPP
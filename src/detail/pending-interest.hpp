@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -22,10 +22,18 @@
 #ifndef NDN_DETAIL_PENDING_INTEREST_HPP
 #define NDN_DETAIL_PENDING_INTEREST_HPP
 
+#include "object-pool.hpp"
 #include "../data.hpp"
+#include "../face.hpp"
 #include "../interest.hpp"
 #include "../lp/nack.hpp"
-#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/signal.hpp"
+#include "../util/time.hpp"
+
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive/set.hpp>
+#include <boost/intrusive/unordered_set.hpp>
+#include <boost/intrusive_ptr.hpp>
 
 namespace ndn {
 
@@ -38,7 +46,7 @@ enum class PendingInterestOrigin
   FORWARDER ///< Interest was received from the forwarder via Transport
 };
 
-std::ostream&
+inline std::ostream&
 operator<<(std::ostream& os, PendingInterestOrigin origin)
 {
   switch (origin) {
@@ -51,53 +59,98 @@ operator<<(std::ostream& os, PendingInterestOrigin origin)
   return os;
 }
 
+class PendingInterest;
+
+using PendingInterestPool = ObjectPool<PendingInterest>;
+
+/**
+ * @brief Reference-counted pointer to a PendingInterest
+ */
+using PendingInterestPtr = boost::intrusive_ptr<PendingInterest>;
+
+struct PendingInterestAggregationTag;
+
+/**
+ * @brief Hook that links a PendingInterest into a PendingInterestAggregationIndex
+ */
+using PendingInterestAggregationHook = boost::intrusive::unordered_set_base_hook<
+  boost::intrusive::tag<PendingInterestAggregationTag>,
+  boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
 /**
  * @brief Stores a pending Interest and associated callbacks
+ *
+ * Records are allocated from a PendingInterestPool with create(), and are reference-counted
+ * with PendingInterestPtr.  A record is linked intrusively into the PendingInterestTable, and
+ * into a PendingInterestExpiryQueue which Face::Impl sweeps from a single timer, so that
+ * neither container allocates memory of its own.  The record is automatically unlinked from
+ * the expiry queue when it is destroyed.  A record that has been sent to the forwarder may also
+ * be linked into a PendingInterestAggregationIndex, from which it is unlinked when it leaves
+ * the PendingInterestTable.
+ *
+ * The callbacks are stored in the record, so that a callback small enough for the internal
+ * buffer of std::function, such as a lambda that captures a pointer, is not allocated
+ * separately.
  */
-class PendingInterest : noncopyable
+class PendingInterest : noncopyable,
+                        public boost::intrusive::list_base_hook<>,
+                        public boost::intrusive::set_base_hook<
+                          boost::intrusive::link_mode<boost::intrusive::auto_unlink>>,
+                        public PendingInterestAggregationHook
 {
 public:
+  /**
+   * @brief Construct a record in @p pool
+   * @param pool the pool that will reclaim the record when its last reference is released
+   * @param args arguments of a PendingInterest constructor
+   */
+  template<typename... Args>
+  static PendingInterestPtr
+  create(PendingInterestPool& pool, Args&&... args)
+  {
+    PendingInterest* record = pool.construct(std::forward<Args>(args)...);
+    record->m_pool = &pool;
+    return PendingInterestPtr(record);
+  }
+
   /**
    * @brief Construct a pending Interest record for an Interest from Face::expressInterest
    *
-   * The timeout is set based on the current time and InterestLifetime.
-   * This class will invoke the timeout callback unless the record is deleted before timeout.
+   * The expiry time is set based on the current time and InterestLifetime.
    *
    * @param interest the Interest
    * @param dataCallback invoked when matching Data packet is received
    * @param nackCallback invoked when Nack matching Interest is received
    * @param timeoutCallback invoked when Interest times out
-   * @param scheduler Scheduler for scheduling the timeout event
    */
   PendingInterest(shared_ptr<const Interest> interest,
-                  const DataCallback& dataCallback,
-                  const NackCallback& nackCallback,
-                  const TimeoutCallback& timeoutCallback,
-                  Scheduler& scheduler)
+                  DataCallback dataCallback,
+                  NackCallback nackCallback,
+                  TimeoutCallback timeoutCallback)
     : m_interest(std::move(interest))
     , m_origin(PendingInterestOrigin::APP)
-    , m_dataCallback(dataCallback)
-    , m_nackCallback(nackCallback)
-    , m_timeoutCallback(timeoutCallback)
-    , m_timeoutEvent(scheduler)
+    , m_dataCallback(std::move(dataCallback))
+    , m_nackCallback(std::move(nackCallback))
+    , m_timeoutCallback(std::move(timeoutCallback))
+    , m_expressTime(time::steady_clock::now())
+    , m_expiry(m_expressTime + m_interest->getInterestLifetime())
     , m_nNotNacked(0)
   {
-    scheduleTimeoutEvent(scheduler);
   }
 
   /**
    * @brief Construct a pending Interest record for an Interest from NFD
    *
    * @param interest the Interest
-   * @param scheduler Scheduler for scheduling the timeout event
    */
-  PendingInterest(shared_ptr<const Interest> interest, Scheduler& scheduler)
+  explicit
+  PendingInterest(shared_ptr<const Interest> interest)
     : m_interest(std::move(interest))
     , m_origin(PendingInterestOrigin::FORWARDER)
-    , m_timeoutEvent(scheduler)
+    , m_expressTime(time::steady_clock::now())
+    , m_expiry(m_expressTime + m_interest->getInterestLifetime())
     , m_nNotNacked(0)
   {
-    scheduleTimeoutEvent(scheduler);
   }
 
   /**
@@ -115,6 +168,24 @@ public:
     return m_origin;
   }
 
+  /**
+   * @brief Get the time when this record was created
+   */
+  time::steady_clock::TimePoint
+  getExpressTime() const
+  {
+    return m_expressTime;
+  }
+
+  /**
+   * @brief Get the time when the Interest times out
+   */
+  time::steady_clock::TimePoint
+  getExpiry() const
+  {
+    return m_expiry;
+  }
+
   /**
    * @brief Record that the Interest has been forwarded to one destination
    *
@@ -126,6 +197,27 @@ public:
     ++m_nNotNacked;
   }
 
+  /**
+   * @brief Record that the Interest has been sent to the forwarder
+   */
+  void
+  recordSentToForwarder()
+  {
+    m_isSentToForwarder = true;
+  }
+
+  /**
+   * @return whether the Interest has been sent to the forwarder
+   *
+   * This is false for an Interest from the forwarder, and for an Interest expressed by the
+   * application that has been aggregated onto another pending Interest.
+   */
+  bool
+  isSentToForwarder() const
+  {
+    return m_isSentToForwarder;
+  }
+
   /**
    * @brief Record an incoming Nack against a forwarded Interest
    * @return least severe Nack if all destinations where the Interest was forwarded have Nacked;
@@ -144,6 +236,24 @@ public:
     return m_nNotNacked > 0 ? nullopt : m_leastSevereNack;
   }
 
+  /**
+   * @brief Aggregate this record onto @p leader, a pending record of an equivalent Interest
+   *
+   * This record is not forwarded by itself.  It takes over the forwarding state of @p leader,
+   * so that incoming Nacks affect both records in the same way.
+   *
+   * @pre this record has not been forwarded
+   * @pre @p leader has been sent to the forwarder, and does not expire before this record
+   */
+  void
+  aggregateOnto(const PendingInterest& leader)
+  {
+    BOOST_ASSERT(m_nNotNacked == 0);
+    BOOST_ASSERT(leader.isSentToForwarder() && leader.getExpiry() >= m_expiry);
+    m_nNotNacked = leader.m_nNotNacked;
+    m_leastSevereNack = leader.m_leastSevereNack;
+  }
+
   /**
    * @brief Invoke the Data callback
    * @note This method does nothing if the Data callback is empty
@@ -169,48 +279,218 @@ public:
   }
 
   /**
-   * @brief Set cleanup function to be invoked when Interest times out
+   * @brief Invoke the timeout callback
+   * @note This method does nothing if the timeout callback is empty
    */
   void
-  setDeleter(const std::function<void()>& deleter)
+  invokeTimeoutCallback()
   {
-    m_deleter = deleter;
+    if (m_timeoutCallback != nullptr) {
+      m_timeoutCallback(*m_interest);
+    }
   }
 
 private:
-  void
-  scheduleTimeoutEvent(Scheduler& scheduler)
+  shared_ptr<const Interest> m_interest;
+  PendingInterestOrigin m_origin;
+  DataCallback m_dataCallback;
+  NackCallback m_nackCallback;
+  TimeoutCallback m_timeoutCallback;
+  time::steady_clock::TimePoint m_expressTime;
+  time::steady_clock::TimePoint m_expiry;
+  int m_nNotNacked; ///< number of Interest destinations that have not Nacked
+  optional<lp::Nack> m_leastSevereNack;
+  bool m_isSentToForwarder = false;
+
+  PendingInterestPool* m_pool = nullptr;
+  size_t m_refCount = 0;
+
+  friend void
+  intrusive_ptr_add_ref(PendingInterest* record)
+  {
+    ++record->m_refCount;
+  }
+
+  friend void
+  intrusive_ptr_release(PendingInterest* record)
   {
-    m_timeoutEvent = scheduler.scheduleEvent(m_interest->getInterestLifetime(),
-                                             [=] { this->invokeTimeoutCallback(); });
+    BOOST_ASSERT(record->m_refCount > 0);
+    if (--record->m_refCount == 0) {
+      BOOST_ASSERT(record->m_pool != nullptr);
+      record->m_pool->destroy(record);
+    }
+  }
+};
+
+/**
+ * @brief Container of pending Interests, which holds a reference to each record
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  using Base = boost::intrusive::list<PendingInterest>;
+  using iterator = Base::iterator;
+
+  ~PendingInterestTable()
+  {
+    m_container.clear_and_dispose(Release());
+  }
+
+  iterator
+  begin()
+  {
+    return m_container.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_container.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_container.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_container.empty();
   }
 
   /**
-   * @brief Invoke the timeout callback (if non-empty) and the deleter
+   * @return position of @p record, which must be in this table
    */
-  void
-  invokeTimeoutCallback()
+  iterator
+  iterator_to(PendingInterest& record)
   {
-    if (m_timeoutCallback) {
-      m_timeoutCallback(*m_interest);
+    return m_container.iterator_to(record);
+  }
+
+  iterator
+  insert(PendingInterestPtr record)
+  {
+    return m_container.insert(m_container.end(), *record.detach());
+  }
+
+  iterator
+  erase(iterator item)
+  {
+    iterator next = m_container.erase_and_dispose(item, Release());
+    if (empty()) {
+      this->onEmpty();
     }
+    return next;
+  }
 
-    BOOST_ASSERT(m_deleter);
-    m_deleter();
+  void
+  clear()
+  {
+    m_container.clear_and_dispose(Release());
+    this->onEmpty();
+  }
+
+  template<typename Predicate>
+  void
+  remove_if(Predicate p)
+  {
+    m_container.remove_and_dispose_if(p, Release());
+    if (empty()) {
+      this->onEmpty();
+    }
   }
 
+public:
+  /** @brief signals when container becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
 private:
-  shared_ptr<const Interest> m_interest;
-  PendingInterestOrigin m_origin;
-  DataCallback m_dataCallback;
-  NackCallback m_nackCallback;
-  TimeoutCallback m_timeoutCallback;
-  util::scheduler::ScopedEventId m_timeoutEvent;
-  int m_nNotNacked; ///< number of Interest destinations that have not Nacked
-  optional<lp::Nack> m_leastSevereNack;
-  std::function<void()> m_deleter;
+  struct Release
+  {
+    void
+    operator()(PendingInterest* record) const
+    {
+      // a record that is no longer pending must not be aggregated onto
+      record->PendingInterestAggregationHook::unlink();
+      intrusive_ptr_release(record);
+    }
+  };
+
+private:
+  Base m_container;
+};
+
+/**
+ * @brief Orders pending Interests by expiry time
+ */
+struct PendingInterestExpiryCompare
+{
+  bool
+  operator()(const PendingInterest& a, const PendingInterest& b) const
+  {
+    return a.getExpiry() < b.getExpiry();
+  }
 };
 
+/**
+ * @brief Pending Interests ordered by expiry time, linked intrusively through their records
+ *
+ * Records with the same expiry time are kept in insertion order.
+ */
+using PendingInterestExpiryQueue = boost::intrusive::multiset<PendingInterest,
+  boost::intrusive::compare<PendingInterestExpiryCompare>,
+  boost::intrusive::constant_time_size<false>>;
+
+/**
+ * @brief Hashes pending Interests by Interest name
+ */
+struct PendingInterestNameHash
+{
+  size_t
+  operator()(const Name& name) const
+  {
+    return std::hash<Name>()(name);
+  }
+
+  size_t
+  operator()(const PendingInterest& record) const
+  {
+    return (*this)(record.getInterest()->getName());
+  }
+};
+
+/**
+ * @brief Compares pending Interests by Interest name
+ */
+struct PendingInterestNameEqual
+{
+  bool
+  operator()(const Name& name, const PendingInterest& record) const
+  {
+    return name == record.getInterest()->getName();
+  }
+
+  bool
+  operator()(const PendingInterest& a, const PendingInterest& b) const
+  {
+    return (*this)(a.getInterest()->getName(), b);
+  }
+};
+
+/**
+ * @brief Pending Interests that have been sent to the forwarder, indexed by Interest name
+ *
+ * The bucket array is supplied and grown by the owner of the index.
+ */
+using PendingInterestAggregationIndex = boost::intrusive::unordered_multiset<PendingInterest,
+  boost::intrusive::base_hook<PendingInterestAggregationHook>,
+  boost::intrusive::hash<PendingInterestNameHash>,
+  boost::intrusive::equal<PendingInterestNameEqual>,
+  boost::intrusive::constant_time_size<false>>;
+
 /**
  * @brief Opaque type to identify a PendingInterest
  */
@@ -229,9 +509,9 @@ public:
   }
 
   bool
-  operator()(const shared_ptr<const PendingInterest>& pendingInterest) const
+  operator()(const PendingInterest& pendingInterest) const
   {
-    return reinterpret_cast<const PendingInterestId*>(pendingInterest->getInterest().get()) == m_id;
+    return reinterpret_cast<const PendingInterestId*>(pendingInterest.getInterest().get()) == m_id;
   }
 
 private:
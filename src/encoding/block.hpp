@@ -455,6 +455,12 @@ protected:
    */
   friend std::ostream&
   operator<<(std::ostream& os, const Block& block);
+
+  /** @brief Name encodes its components in place into a reserved buffer, and updates its
+   *         wire Block without discarding sub elements
+   *  @sa Name::reserve
+   */
+  friend class Name;
 };
 
 inline
@@ -240,6 +240,14 @@ sizeOfVarNumber(uint64_t number) noexcept;
 size_t
 writeVarNumber(std::ostream& os, uint64_t number);
 
+/**
+ * @brief Write VAR-NUMBER to the specified buffer.
+ * @param dest a buffer with room for at least `sizeOfVarNumber(number)` octets
+ * @return length of written VAR-NUMBER
+ */
+size_t
+writeVarNumber(uint8_t* dest, uint64_t number) noexcept;
+
 /**
  * @brief Read nonNegativeInteger in NDN-TLV encoding.
  * @tparam Iterator an iterator or pointer that dereferences to uint8_t or compatible type
@@ -471,6 +479,33 @@ writeVarNumber(std::ostream& os, uint64_t number)
   }
 }
 
+inline size_t
+writeVarNumber(uint8_t* dest, uint64_t number) noexcept
+{
+  if (number < 253) {
+    dest[0] = static_cast<uint8_t>(number);
+    return 1;
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    dest[0] = 253;
+    uint16_t value = boost::endian::native_to_big(static_cast<uint16_t>(number));
+    std::memcpy(dest + 1, &value, 2);
+    return 3;
+  }
+  else if (number <= std::numeric_limits<uint32_t>::max()) {
+    dest[0] = 254;
+    uint32_t value = boost::endian::native_to_big(static_cast<uint32_t>(number));
+    std::memcpy(dest + 1, &value, 4);
+    return 5;
+  }
+  else {
+    dest[0] = 255;
+    uint64_t value = boost::endian::native_to_big(number);
+    std::memcpy(dest + 1, &value, 8);
+    return 9;
+  }
+}
+
 template<typename Iterator>
 uint64_t
 readNonNegativeInteger(size_t size, Iterator& begin, Iterator end)
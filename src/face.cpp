@@ -206,6 +206,14 @@ Face::removeAllPendingInterests()
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::setInterestAggregation(bool wantAggregation)
+{
+  IO_CAPTURE_WEAK_IMPL(post) {
+    impl->m_wantInterestAggregation = wantAggregation;
+  } IO_CAPTURE_WEAK_IMPL_END
+}
+
 size_t
 Face::getNPendingInterests() const
 {
@@ -281,6 +289,18 @@ Face::registerPrefix(const Name& prefix,
   return m_impl->registerPrefix(prefix, nullptr, onSuccess, onFailure, flags, options);
 }
 
+void
+Face::registerPrefixList(std::vector<Name> prefixes,
+                         const RegisterPrefixesCallback& onComplete,
+                         const RegisterPrefixesOptions& options)
+{
+  if (options.window == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("registerPrefixes window must be positive"));
+  }
+
+  m_impl->registerPrefixes(std::move(prefixes), onComplete, options);
+}
+
 void
 Face::unsetInterestFilter(const RegisteredPrefixId* registeredPrefixId)
 {
@@ -346,6 +366,15 @@ Face::doProcessEvents(time::milliseconds timeout, bool keepThread)
   }
 }
 
+util::FaceMetrics
+Face::getMetrics() const
+{
+  util::FaceMetrics metrics = m_impl->m_metrics.snapshot();
+  metrics.sendQueueLength = m_transport->getSendQueueLength();
+  metrics.sendQueueBytes = m_transport->getSendQueueBytes();
+  return metrics;
+}
+
 void
 Face::shutdown()
 {
@@ -394,11 +423,13 @@ Face::onReceiveElement(const Block& blockFromDaemon)
         nack->setHeader(lpPacket.get<lp::NackField>());
         extractLpLocalFields(*nack, lpPacket);
         NDN_LOG_DEBUG(">N " << nack->getInterest() << '~' << nack->getHeader().getReason());
+        m_impl->m_metrics.recordInNack();
         m_impl->nackPendingInterests(*nack);
       }
       else {
         extractLpLocalFields(*interest, lpPacket);
         NDN_LOG_DEBUG(">I " << *interest);
+        m_impl->m_metrics.recordInInterest();
         m_impl->processIncomingInterest(std::move(interest));
       }
       break;
@@ -407,6 +438,7 @@ Face::onReceiveElement(const Block& blockFromDaemon)
       auto data = make_shared<Data>(netPacket);
       extractLpLocalFields(*data, lpPacket);
       NDN_LOG_DEBUG(">D " << data->getName());
+      m_impl->m_metrics.recordInData();
       m_impl->satisfyPendingInterests(*data);
       break;
     }
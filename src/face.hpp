@@ -31,6 +31,7 @@
 #include "net/asio-fwd.hpp"
 #include "security/key-chain.hpp"
 #include "security/signing-info.hpp"
+#include "util/face-metrics.hpp"
 
 namespace ndn {
 
@@ -84,6 +85,58 @@ typedef function<void()> UnregisterPrefixSuccessCallback;
  */
 typedef function<void(const std::string&)> UnregisterPrefixFailureCallback;
 
+/**
+ * @brief Options for Face::registerPrefixes
+ */
+class RegisterPrefixesOptions
+{
+public:
+  /**
+   * @brief max number of outstanding prefix registration commands, must be positive
+   */
+  size_t window = 64;
+
+  /**
+   * @brief max number of retransmissions of a command after it times out
+   */
+  int maxRetries = 2;
+
+  /**
+   * @brief signing parameters of the commands
+   */
+  security::SigningInfo signingInfo;
+
+  /**
+   * @brief prefix registration flags
+   * @sa nfd::RouteFlags
+   */
+  uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT;
+};
+
+/**
+ * @brief Aggregated outcome of Face::registerPrefixes
+ *
+ * Prefixes appear in the order in which their registration completed.
+ */
+class RegisterPrefixesResult
+{
+public:
+  /**
+   * @brief registered prefixes, with IDs that can be used with unregisterPrefix
+   */
+  std::vector<std::pair<Name, const RegisteredPrefixId*>> registered;
+
+  /**
+   * @brief prefixes that could not be registered, with the reason of the failure
+   */
+  std::vector<std::pair<Name, std::string>> failed;
+};
+
+/**
+ * @brief Callback invoked when registerPrefixes completes
+ */
+typedef function<void(const RegisterPrefixesResult&)> RegisterPrefixesCallback;
+
 /**
  * @brief Provide a communication channel with local or remote NDN forwarder
  */
@@ -254,6 +307,22 @@ public: // consumer
   void
   removeAllPendingInterests();
 
+  /**
+   * @brief Enable or disable aggregation of equivalent Interests
+   *
+   * When aggregation is enabled, an Interest expressed while an equivalent Interest from this
+   * face has been sent and is pending is not sent to the forwarder.  Instead, its callbacks are
+   * invoked when the pending Interest is satisfied or Nacked.  An Interest is not aggregated
+   * if the pending Interest would expire before it.  Two Interests are equivalent if they have
+   * the same Name, Selectors, ForwardingHint, and NextHopFaceId tag.  The number of Interests
+   * that were not sent is reported as util::FaceMetrics::nSuppressedInterests.
+   *
+   * Aggregation is disabled by default.  The setting applies to Interests expressed after
+   * this call.
+   */
+  void
+  setInterestAggregation(bool wantAggregation);
+
   /**
    * @brief Get number of pending Interests
    */
@@ -357,6 +426,32 @@ public: // producer
                  const security::SigningInfo& signingInfo = security::SigningInfo(),
                  uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
 
+  /**
+   * @brief Register many prefixes with the connected NDN forwarder
+   *
+   * Prefix registration commands are sent in the order of @p prefixes, keeping at most
+   * @p options.window of them outstanding.  A command that times out is retransmitted up to
+   * @p options.maxRetries times; other failures are not retried.  Like registerPrefix, this
+   * method does not associate any onInterest callbacks.
+   *
+   * @param prefixes    A range of Names to register with the connected NDN forwarder
+   * @param onComplete  A callback to be called once, after every prefix has either been
+   *                    registered or failed
+   * @param options     Window, retransmission, signing, and flags of the registration
+   *
+   * @throw std::invalid_argument @p options.window is zero
+   */
+  template<typename Range>
+  void
+  registerPrefixes(const Range& prefixes,
+                   const RegisterPrefixesCallback& onComplete,
+                   const RegisterPrefixesOptions& options = RegisterPrefixesOptions())
+  {
+    using std::begin;
+    using std::end;
+    registerPrefixList(std::vector<Name>(begin(prefixes), end(prefixes)), onComplete, options);
+  }
+
   /**
    * @brief Remove the registered prefix entry with the registeredPrefixId
    *
@@ -475,6 +570,16 @@ public: // IO routine
   void
   shutdown();
 
+  /**
+   * @brief Get a snapshot of packet, pending Interest, latency, and send queue metrics
+   *
+   * Unlike other methods of Face, this method can be called from any thread.
+   *
+   * @sa util::makeFaceMetricsDatasetHandler
+   */
+  util::FaceMetrics
+  getMetrics() const;
+
   /**
    * @return reference to io_service object
    */
@@ -512,6 +617,11 @@ private:
   void
   onReceiveElement(const Block& blockFromDaemon);
 
+  void
+  registerPrefixList(std::vector<Name> prefixes,
+                     const RegisterPrefixesCallback& onComplete,
+                     const RegisterPrefixesOptions& options);
+
   void
   asyncShutdown();
 
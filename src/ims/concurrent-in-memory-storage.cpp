@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "concurrent-in-memory-storage.hpp"
+#include "in-memory-storage-lru.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+ConcurrentInMemoryStorage::ConcurrentInMemoryStorage(size_t limit, size_t nShards,
+                                                     size_t nKeyComponents,
+                                                     const StorageCreator& createStorage)
+  : m_limit(limit)
+  , m_nKeyComponents(nKeyComponents)
+  , m_nPackets(0)
+{
+  if (nShards == 0) {
+    BOOST_THROW_EXCEPTION(Error("ConcurrentInMemoryStorage must contain at least one shard"));
+  }
+
+  m_shards.reserve(nShards);
+  for (size_t i = 0; i < nShards; ++i) {
+    auto shard = make_unique<Shard>();
+    if (createStorage != nullptr) {
+      shard->storage = createStorage(limit);
+    }
+    else {
+      shard->storage = make_unique<InMemoryStorageLru>(limit);
+    }
+    shard->nPackets = 0;
+    m_shards.push_back(std::move(shard));
+  }
+}
+
+ConcurrentInMemoryStorage::~ConcurrentInMemoryStorage() = default;
+
+size_t
+ConcurrentInMemoryStorage::getShardIndex(const Name& name) const
+{
+  size_t seed = 0;
+  size_t nComponents = std::min(m_nKeyComponents, name.size());
+  for (size_t i = 0; i < nComponents; ++i) {
+    const name::Component& component = name[i];
+    boost::hash_combine(seed, component.type());
+    boost::hash_combine(seed, boost::hash_range(component.value_begin(), component.value_end()));
+  }
+  return seed % m_shards.size();
+}
+
+template<typename F>
+void
+ConcurrentInMemoryStorage::modifyShard(Shard& shard, const F& f)
+{
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  size_t nBefore = shard.storage->size();
+  f(*shard.storage);
+  size_t nAfter = shard.storage->size();
+
+  shard.nPackets = nAfter;
+  if (nAfter > nBefore) {
+    m_nPackets += nAfter - nBefore;
+  }
+  else {
+    m_nPackets -= nBefore - nAfter;
+  }
+}
+
+template<typename F>
+void
+ConcurrentInMemoryStorage::forEachShard(const Name& name, const F& f)
+{
+  if (name.size() >= m_nKeyComponents) {
+    modifyShard(*m_shards[getShardIndex(name)], f);
+  }
+  else {
+    for (const auto& shard : m_shards) {
+      modifyShard(*shard, f);
+    }
+  }
+}
+
+bool
+ConcurrentInMemoryStorage::insert(const Data& data,
+                                  const time::milliseconds& mustBeFreshProcessingWindow)
+{
+  // a full name shorter than the shard key selects its shard by all of its components,
+  // like the Names that can match it
+  bool isInserted = false;
+  modifyShard(*m_shards[getShardIndex(data.getFullName())], [&] (InMemoryStorage& storage) {
+    isInserted = storage.insert(data, mustBeFreshProcessingWindow);
+  });
+
+  evictOverLimit();
+  return isInserted;
+}
+
+shared_ptr<const Data>
+ConcurrentInMemoryStorage::find(const Interest& interest)
+{
+  // like InMemoryStorage, the rightmost match is the leftmost packet under the rightmost child
+  bool isRightmost = interest.getChildSelector() == 1;
+  size_t childIndex = interest.getName().size();
+  shared_ptr<const Data> match;
+  forEachShard(interest.getName(), [&] (InMemoryStorage& storage) {
+    auto data = storage.find(interest);
+    if (data == nullptr) {
+      return;
+    }
+    if (match == nullptr) {
+      match = std::move(data);
+      return;
+    }
+
+    const Name& fullName = data->getFullName();
+    const Name& matchFullName = match->getFullName();
+    if (isRightmost) {
+      int order = fullName.getPrefix(childIndex + 1)
+                    .compare(matchFullName.getPrefix(childIndex + 1));
+      if (order > 0 || (order == 0 && fullName < matchFullName)) {
+        match = std::move(data);
+      }
+    }
+    else if (fullName < matchFullName) {
+      match = std::move(data);
+    }
+  });
+  return match;
+}
+
+shared_ptr<const Data>
+ConcurrentInMemoryStorage::find(const Name& name)
+{
+  shared_ptr<const Data> match;
+  forEachShard(name, [&] (InMemoryStorage& storage) {
+    auto data = storage.find(name);
+    if (data != nullptr && (match == nullptr || data->getFullName() < match->getFullName())) {
+      match = std::move(data);
+    }
+  });
+  return match;
+}
+
+void
+ConcurrentInMemoryStorage::erase(const Name& prefix, bool isPrefix)
+{
+  forEachShard(prefix, [&] (InMemoryStorage& storage) {
+    storage.erase(prefix, isPrefix);
+  });
+}
+
+void
+ConcurrentInMemoryStorage::evictOverLimit()
+{
+  // each thread claims one excess packet at a time, so that concurrent insertions
+  // do not evict more packets than necessary
+  size_t nPackets = m_nPackets;
+  while (nPackets > m_limit) {
+    if (!m_nPackets.compare_exchange_weak(nPackets, nPackets - 1)) {
+      continue;
+    }
+    if (!evictFromLargestShard()) {
+      ++m_nPackets;
+      return;
+    }
+    nPackets = m_nPackets;
+  }
+}
+
+bool
+ConcurrentInMemoryStorage::evictFromLargestShard()
+{
+  // another thread may empty the chosen shard before its mutex is acquired
+  for (size_t nAttempts = 0; nAttempts < m_shards.size(); ++nAttempts) {
+    auto largest = std::max_element(m_shards.begin(), m_shards.end(),
+      [] (const unique_ptr<Shard>& a, const unique_ptr<Shard>& b) {
+        return a->nPackets < b->nPackets;
+      });
+    Shard& shard = **largest;
+    if (shard.nPackets == 0) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.storage->size() > 0 && shard.storage->evictItem()) {
+      shard.nPackets = shard.storage->size();
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace ndn
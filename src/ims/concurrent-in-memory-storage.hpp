@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_CONCURRENT_IN_MEMORY_STORAGE_HPP
+#define NDN_IMS_CONCURRENT_IN_MEMORY_STORAGE_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace ndn {
+
+/** @brief Represents in-memory storage that can be used from multiple threads
+ *
+ *  Packets are partitioned into shards by a hash of the first few components of their full
+ *  names.  Each shard is an InMemoryStorage protected by its own mutex, so that operations on
+ *  different shards, such as producers inserting Data under different namespaces and a Face
+ *  thread answering Interests, never wait for each other.  An Interest or Name that has at
+ *  least as many components as the shard key is looked up in a single shard; a shorter one is
+ *  looked up in every shard.
+ *
+ *  The packet limit applies to the storage as a whole.  When an insertion exceeds it, a packet
+ *  is evicted from the largest shard, chosen by the replacement policy of that shard.
+ *
+ *  @note All member functions may be called from any thread.
+ *  @note Readers do not take any lock other than the mutex of the shard being searched.  Lookups
+ *        are not lock-free, because the replacement policy of the shard is updated on every hit.
+ */
+class ConcurrentInMemoryStorage : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** @brief a function that creates the InMemoryStorage of one shard
+   *
+   *  The function receives the packet limit of the whole storage.
+   */
+  using StorageCreator = function<unique_ptr<InMemoryStorage>(size_t limit)>;
+
+  /** @brief Create a ConcurrentInMemoryStorage with up to @p limit entries
+   *  @param limit maximum number of packets in the storage
+   *  @param nShards number of shards, must be positive
+   *  @param nKeyComponents number of leading name components that determine the shard
+   *  @param createStorage creates the InMemoryStorage of each shard; if empty, shards employ
+   *                       LRU replacement policy
+   *  @throw Error nShards is zero
+   *
+   *  MustBeFresh is handled in Interest processing if @p createStorage creates InMemoryStorage
+   *  with an io_service.
+   */
+  explicit
+  ConcurrentInMemoryStorage(size_t limit = std::numeric_limits<size_t>::max(),
+                            size_t nShards = 16, size_t nKeyComponents = 2,
+                            const StorageCreator& createStorage = nullptr);
+
+  ~ConcurrentInMemoryStorage();
+
+  /** @brief Inserts a Data packet
+   *  @return whether @p data is stored in its shard
+   *  @sa InMemoryStorage::insert
+   */
+  bool
+  insert(const Data& data,
+         const time::milliseconds& mustBeFreshProcessingWindow = InMemoryStorage::INFINITE_WINDOW);
+
+  /** @brief Finds the best match Data for an Interest
+   *  @sa InMemoryStorage::find(const Interest&)
+   *
+   *  If the Interest name is shorter than the shard key, and multiple shards have a match,
+   *  the leftmost or rightmost match is returned according to the ChildSelector.
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Finds the best match Data for a Name with or without the implicit digest
+   *  @sa InMemoryStorage::find(const Name&)
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Deletes in-memory storage entry by prefix by default
+   *  @sa InMemoryStorage::erase
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /** @return{ maximum number of packets that can be allowed to store in the storage }
+   */
+  size_t
+  getLimit() const
+  {
+    return m_limit;
+  }
+
+  /** @return{ number of packets stored in the storage }
+   *  @note Concurrent insertions may be reflected after a short delay.
+   */
+  size_t
+  size() const
+  {
+    return m_nPackets;
+  }
+
+  /** @return{ number of shards }
+   */
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @return{ index of the shard that holds packets whose full names start with the first
+   *           nKeyComponents components of @p name, or whose full name is @p name if it is
+   *           shorter than that }
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** @return{ number of packets stored in the index-th shard }
+   */
+  size_t
+  getShardSize(size_t index) const
+  {
+    return m_shards.at(index)->nPackets;
+  }
+
+private:
+  struct Shard
+  {
+    std::mutex mutex;
+    unique_ptr<InMemoryStorage> storage;
+    /// number of packets in storage, readable without the mutex
+    std::atomic<size_t> nPackets;
+  };
+
+  /** @brief invoke @p f on the storage of @p shard while holding its mutex,
+   *         and update the packet counts
+   */
+  template<typename F>
+  void
+  modifyShard(Shard& shard, const F& f);
+
+  /** @brief invoke @p f on every shard that may hold packets whose names start with @p name,
+   *         with modifyShard()
+   */
+  template<typename F>
+  void
+  forEachShard(const Name& name, const F& f);
+
+  /** @brief evict packets until the storage is within its limit
+   */
+  void
+  evictOverLimit();
+
+  /** @brief evict one packet from the largest shard
+   *  @return whether a packet was evicted
+   */
+  bool
+  evictFromLargestShard();
+
+private:
+  const size_t m_limit;
+  const size_t m_nKeyComponents;
+  std::vector<unique_ptr<Shard>> m_shards;
+  std::atomic<size_t> m_nPackets;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_CONCURRENT_IN_MEMORY_STORAGE_HPP
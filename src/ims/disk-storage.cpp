@@ -0,0 +1,958 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "disk-storage.hpp"
+#include "../encoding/buffer-stream.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+
+namespace fs = boost::filesystem;
+
+const size_t DiskStorage::DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+static const size_t MAX_SEGMENT_SIZE = size_t(1) << 40;
+
+namespace {
+
+/** @brief a file mapped into memory with a shared mapping
+ */
+class MappedFile : noncopyable
+{
+public:
+  ~MappedFile()
+  {
+    close();
+  }
+
+  /** @brief map the file at @p path
+   *  @param size if the file is writable, it is extended to at least this size
+   */
+  void
+  open(const std::string& path, bool isWritable, size_t size = 0)
+  {
+    close();
+
+    int fd = ::open(path.c_str(), isWritable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (fd < 0) {
+      BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot open " + path + ": " +
+                                               std::strerror(errno)));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot stat " + path + ": " +
+                                               std::strerror(error)));
+    }
+    if (isWritable && size > static_cast<size_t>(st.st_size)) {
+      if (::ftruncate(fd, size) != 0) {
+        int error = errno;
+        ::close(fd);
+        BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot extend " + path + ": " +
+                                                 std::strerror(error)));
+      }
+    }
+    else {
+      size = static_cast<size_t>(st.st_size);
+    }
+
+    if (size > 0) {
+      void* addr = ::mmap(nullptr, size, isWritable ? PROT_READ | PROT_WRITE : PROT_READ,
+                          MAP_SHARED, fd, 0);
+      if (addr == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot map " + path + ": " +
+                                                 std::strerror(error)));
+      }
+      m_data = static_cast<uint8_t*>(addr);
+    }
+    m_size = size;
+    m_isOpen = true;
+    ::close(fd);
+  }
+
+  void
+  close()
+  {
+    if (m_data != nullptr) {
+      ::munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+  }
+
+  void
+  sync()
+  {
+    if (m_data != nullptr) {
+      ::msync(m_data, m_size, MS_SYNC);
+    }
+  }
+
+  bool
+  isOpen() const
+  {
+    return m_isOpen;
+  }
+
+  uint8_t*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+private:
+  uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_isOpen = false;
+};
+
+} // namespace
+
+/** @return{ size of the TLV element at [begin, end), or zero if it is truncated or its type is
+ *           not @p expectedType }
+ */
+static size_t
+getElementSize(const uint8_t* begin, const uint8_t* end, uint32_t expectedType)
+{
+  const uint8_t* pos = begin;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, end, type) || type != expectedType ||
+      !tlv::readVarNumber(pos, end, length) ||
+      length > static_cast<uint64_t>(end - pos)) {
+    return 0;
+  }
+  return static_cast<size_t>(pos - begin + length);
+}
+
+/** @brief write @p buffer to the file at @p path
+ *
+ *  The buffer is written to a temporary file, which is synced before it is renamed, so that a
+ *  crash leaves either the complete new file or the old one.
+ */
+static void
+writeFileAtomically(const std::string& path, const Buffer& buffer)
+{
+  std::string tmpPath = path + ".tmp";
+  int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot open " + tmpPath + ": " +
+                                             std::strerror(errno)));
+  }
+  const uint8_t* pos = buffer.data();
+  size_t remaining = buffer.size();
+  while (remaining > 0) {
+    ssize_t nWritten = ::write(fd, pos, remaining);
+    if (nWritten < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nWritten < 0) {
+      int error = errno;
+      ::close(fd);
+      BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot write " + tmpPath + ": " +
+                                               std::strerror(error)));
+    }
+    pos += nWritten;
+    remaining -= static_cast<size_t>(nWritten);
+  }
+  if (::fsync(fd) != 0) {
+    int error = errno;
+    ::close(fd);
+    BOOST_THROW_EXCEPTION(DiskStorage::Error("Cannot sync " + tmpPath + ": " +
+                                             std::strerror(error)));
+  }
+  ::close(fd);
+  fs::rename(tmpPath, path);
+}
+
+/** @brief compare @p prefix with a Name in wire encoding
+ *  @return{ negative if @p prefix is less than the Name, zero if it is a prefix of the Name,
+ *           positive if it is greater than the Name }
+ *
+ *  The canonical order of Names is the lexical order of the TLV-VALUE of their wire encodings,
+ *  in which a Name is a prefix of another if its TLV-VALUE is a prefix of the other's.
+ */
+static int
+comparePrefix(const Block& prefix, const uint8_t* name, size_t nameSize)
+{
+  const uint8_t* pos = name;
+  const uint8_t* end = name + nameSize;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  tlv::readType(pos, end, type);
+  tlv::readVarNumber(pos, end, length);
+
+  size_t prefixSize = prefix.value_size();
+  int cmp = std::memcmp(prefix.value(), pos, std::min<size_t>(prefixSize, length));
+  if (cmp != 0) {
+    return cmp;
+  }
+  return prefixSize <= length ? 0 : 1;
+}
+
+/** @brief a log segment and its index
+ *
+ *  The log is a sequence of Data packets in wire encoding.  An active log is extended in
+ *  advance to the size of the segment, and packets are copied into the mapping; the unused
+ *  tail consists of zeros, which do not form a valid TLV element.
+ *
+ *  The index file of a sealed segment contains, in network byte order:
+ *    - the number of entries, as a 64-bit integer;
+ *    - for each entry in order of full names, the offset of the packet in the log and the
+ *      offset of its full name in the index file, as 64-bit integers;
+ *    - the full names in wire encoding.
+ */
+class DiskStorage::Segment : noncopyable
+{
+public:
+  Segment(const std::string& dir, uint64_t seq)
+    : m_seq(seq)
+    , m_logSize(0)
+    , m_nEntries(0)
+    , m_isSealed(true)
+  {
+    std::ostringstream os;
+    os << std::setw(10) << std::setfill('0') << seq;
+    m_logPath = (fs::path(dir) / (os.str() + ".log")).string();
+    m_indexPath = (fs::path(dir) / (os.str() + ".idx")).string();
+  }
+
+  uint64_t
+  getSeq() const
+  {
+    return m_seq;
+  }
+
+  bool
+  isSealed() const
+  {
+    return m_isSealed;
+  }
+
+  bool
+  hasIndexFile() const
+  {
+    return fs::exists(m_indexPath);
+  }
+
+  /** @return{ offset of the next packet to be appended }
+   */
+  size_t
+  getLogSize() const
+  {
+    return m_logSize;
+  }
+
+  /** @brief map the log for appending, and index the packets it already contains
+   *  @param capacity the log is extended to at least this size
+   */
+  void
+  openForAppend(size_t capacity)
+  {
+    m_log.open(m_logPath, true, capacity);
+    scanLog();
+    m_isSealed = false;
+  }
+
+  /** @brief copy a packet into the log
+   *  @return{ whether the log had enough room }
+   */
+  bool
+  append(const Data& data)
+  {
+    BOOST_ASSERT(!m_isSealed);
+    const Block& wire = data.wireEncode();
+    if (m_logSize + wire.size() > m_log.size()) {
+      return false;
+    }
+
+    std::memcpy(m_log.data() + m_logSize, wire.wire(), wire.size());
+    // a packet inserted again after being erased replaces the erased copy in the index
+    m_entries[data.getFullName()] = m_logSize;
+    m_logSize += wire.size();
+    return true;
+  }
+
+  /** @brief write the index file, and shrink the log to its packets
+   */
+  void
+  seal()
+  {
+    writeIndex();
+    m_entries.clear();
+    m_log.close();
+    fs::resize_file(m_logPath, m_logSize);
+    m_isSealed = true;
+  }
+
+  void
+  sync()
+  {
+    m_log.sync();
+  }
+
+  /** @brief rewrite a sealed segment with only @p entries, given as full names and offsets
+   *         in order of insertion
+   *
+   *  The index file is removed before the log is replaced, so that a crash in between leaves
+   *  the old log to be indexed again.
+   */
+  void
+  rewrite(const std::vector<std::pair<Name, size_t>>& entries)
+  {
+    BOOST_ASSERT(m_isSealed);
+    OBufferStream os;
+    size_t newOffset = 0;
+    for (const auto& entry : entries) {
+      size_t size = 0;
+      const uint8_t* wire = getPacketWire(entry.second, size);
+      os.write(reinterpret_cast<const char*>(wire), size);
+      m_entries.emplace(entry.first, newOffset);
+      newOffset += size;
+    }
+
+    m_log.close();
+    m_index.close();
+    fs::remove(m_indexPath);
+    writeFileAtomically(m_logPath, *os.buf());
+    writeIndex();
+    m_entries.clear();
+  }
+
+  /** @brief remove the log and index files of a sealed segment
+   */
+  void
+  remove()
+  {
+    m_log.close();
+    m_index.close();
+    fs::remove(m_indexPath);
+    fs::remove(m_logPath);
+  }
+
+  /** @brief decode the packet at @p offset of the log
+   */
+  shared_ptr<const Data>
+  readData(size_t offset)
+  {
+    size_t size = 0;
+    const uint8_t* wire = getPacketWire(offset, size);
+    // a Block must own its buffer, so the packet is copied out of the mapping
+    return make_shared<Data>(Block(wire, size));
+  }
+
+  /** @brief invoke @p f(fullName, offset) with every packet whose full name starts with
+   *         @p prefix, in order of full names, until @p f returns true
+   *  @return{ whether @p f returned true }
+   */
+  template<typename F>
+  bool
+  forEachEntry(const Name& prefix, bool isReverse, const F& f)
+  {
+    if (!m_isSealed) {
+      auto first = m_entries.lower_bound(prefix);
+      if (!isReverse) {
+        for (auto it = first; it != m_entries.end() && prefix.isPrefixOf(it->first); ++it) {
+          if (f(it->first, it->second)) {
+            return true;
+          }
+        }
+      }
+      else {
+        auto last = prefix.empty() ? m_entries.end() :
+                                     m_entries.lower_bound(prefix.getSuccessor());
+        for (auto it = last; it != first; ) {
+          --it;
+          if (f(it->first, it->second)) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    loadIndex();
+    const Block& prefixWire = prefix.wireEncode();
+    size_t first = partitionPoint([&] (size_t i) { return compareEntry(prefixWire, i) > 0; });
+    size_t last = partitionPoint([&] (size_t i) { return compareEntry(prefixWire, i) >= 0; });
+    if (!isReverse) {
+      for (size_t i = first; i < last; ++i) {
+        if (f(getEntryName(i), getEntryOffset(i))) {
+          return true;
+        }
+      }
+    }
+    else {
+      for (size_t i = last; i > first; --i) {
+        if (f(getEntryName(i - 1), getEntryOffset(i - 1))) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  /** @return{ the wire encoding of the packet at @p offset of the log, whose size is stored
+   *           in @p size }
+   */
+  const uint8_t*
+  getPacketWire(size_t offset, size_t& size)
+  {
+    if (!m_log.isOpen()) {
+      m_log.open(m_logPath, false);
+    }
+    if (offset >= m_log.size()) {
+      BOOST_THROW_EXCEPTION(Error("Packet offset out of range in " + m_logPath));
+    }
+    const uint8_t* begin = m_log.data() + offset;
+    size = getElementSize(begin, m_log.data() + m_log.size(), tlv::Data);
+    if (size == 0) {
+      BOOST_THROW_EXCEPTION(Error("Corrupted packet in " + m_logPath));
+    }
+    return begin;
+  }
+
+  /** @brief index the packets at the beginning of the log, which ends at the first position
+   *         that does not contain a valid Data packet
+   */
+  void
+  scanLog()
+  {
+    m_entries.clear();
+    const uint8_t* begin = m_log.data();
+    const uint8_t* end = begin + m_log.size();
+    size_t offset = 0;
+    while (offset < m_log.size()) {
+      size_t size = getElementSize(begin + offset, end, tlv::Data);
+      if (size == 0) {
+        break;
+      }
+      try {
+        Data data(Block(begin + offset, size));
+        m_entries[data.getFullName()] = offset;
+      }
+      catch (const tlv::Error&) {
+        // the packet was partially written before a crash
+        break;
+      }
+      offset += size;
+    }
+    m_logSize = offset;
+  }
+
+  void
+  writeIndex()
+  {
+    uint64_t nEntries = m_entries.size();
+    uint64_t nameOffset = sizeof(uint64_t) + nEntries * 2 * sizeof(uint64_t);
+    OBufferStream os;
+    auto writeNumber = [&os] (uint64_t number) {
+      boost::endian::native_to_big_inplace(number);
+      os.write(reinterpret_cast<const char*>(&number), sizeof(number));
+    };
+
+    writeNumber(nEntries);
+    for (const auto& entry : m_entries) {
+      writeNumber(entry.second);
+      writeNumber(nameOffset);
+      nameOffset += entry.first.wireEncode().size();
+    }
+    for (const auto& entry : m_entries) {
+      const Block& wire = entry.first.wireEncode();
+      os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+    }
+
+    // an index file is either complete or absent
+    writeFileAtomically(m_indexPath, *os.buf());
+  }
+
+  /** @brief map the index file, creating it if the segment was not sealed properly
+   */
+  void
+  loadIndex()
+  {
+    if (m_index.isOpen()) {
+      return;
+    }
+
+    if (!hasIndexFile()) {
+      m_log.open(m_logPath, false);
+      scanLog();
+      writeIndex();
+      m_entries.clear();
+    }
+    m_index.open(m_indexPath, false);
+    // each entry occupies two numbers after the number of entries
+    if (m_index.size() < sizeof(uint64_t) ||
+        readNumber(0) > (m_index.size() - sizeof(uint64_t)) / (2 * sizeof(uint64_t))) {
+      m_index.close();
+      BOOST_THROW_EXCEPTION(Error("Truncated index " + m_indexPath));
+    }
+    m_nEntries = static_cast<size_t>(readNumber(0));
+  }
+
+  uint64_t
+  readNumber(size_t offset) const
+  {
+    uint64_t number = 0;
+    std::memcpy(&number, m_index.data() + offset, sizeof(number));
+    return boost::endian::big_to_native(number);
+  }
+
+  size_t
+  getEntryOffset(size_t i) const
+  {
+    return static_cast<size_t>(readNumber(sizeof(uint64_t) + i * 2 * sizeof(uint64_t)));
+  }
+
+  const uint8_t*
+  getEntryNameWire(size_t i, size_t& size) const
+  {
+    uint64_t nameOffset = readNumber(sizeof(uint64_t) * (2 + i * 2));
+    if (nameOffset >= m_index.size()) {
+      BOOST_THROW_EXCEPTION(Error("Corrupted index " + m_indexPath));
+    }
+    const uint8_t* begin = m_index.data() + nameOffset;
+    size = getElementSize(begin, m_index.data() + m_index.size(), tlv::Name);
+    if (size == 0) {
+      BOOST_THROW_EXCEPTION(Error("Corrupted index " + m_indexPath));
+    }
+    return begin;
+  }
+
+  Name
+  getEntryName(size_t i) const
+  {
+    size_t size = 0;
+    const uint8_t* wire = getEntryNameWire(i, size);
+    return Name(Block(wire, size));
+  }
+
+  int
+  compareEntry(const Block& prefixWire, size_t i) const
+  {
+    size_t size = 0;
+    const uint8_t* wire = getEntryNameWire(i, size);
+    return comparePrefix(prefixWire, wire, size);
+  }
+
+  /** @return{ the first entry for which @p pred is false, where @p pred is true for a prefix of
+   *           the entries }
+   */
+  template<typename Pred>
+  size_t
+  partitionPoint(const Pred& pred) const
+  {
+    size_t first = 0;
+    size_t count = m_nEntries;
+    while (count > 0) {
+      size_t step = count / 2;
+      if (pred(first + step)) {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+private:
+  uint64_t m_seq;
+  std::string m_logPath;
+  std::string m_indexPath;
+  MappedFile m_log;
+  size_t m_logSize;
+  /// index of an active segment
+  std::map<Name, size_t> m_entries;
+  /// index of a sealed segment
+  MappedFile m_index;
+  size_t m_nEntries;
+  bool m_isSealed;
+};
+
+DiskStorage::DiskStorage(const std::string& path, size_t segmentSize)
+  : m_path(path)
+  , m_segmentSize(std::min(segmentSize, MAX_SEGMENT_SIZE))
+{
+  try {
+    fs::create_directories(m_path);
+
+    std::vector<uint64_t> seqs;
+    for (fs::directory_iterator it(m_path); it != fs::directory_iterator(); ++it) {
+      fs::path file = it->path();
+      std::string stem = file.stem().string();
+      if (file.extension() == ".log" && !stem.empty() &&
+          stem.find_first_not_of("0123456789") == std::string::npos) {
+        seqs.push_back(std::stoull(stem));
+      }
+    }
+    std::sort(seqs.begin(), seqs.end());
+    for (uint64_t seq : seqs) {
+      m_segments.push_back(make_unique<Segment>(m_path, seq));
+    }
+  }
+  catch (const fs::filesystem_error& e) {
+    BOOST_THROW_EXCEPTION(Error(e.what()));
+  }
+
+  // the last segment remains active unless it was sealed
+  if (!m_segments.empty() && !m_segments.back()->hasIndexFile()) {
+    m_segments.back()->openForAppend(m_segmentSize);
+  }
+
+  loadErased();
+}
+
+DiskStorage::~DiskStorage() = default;
+
+DiskStorage::Position
+DiskStorage::getNextPosition() const
+{
+  if (m_segments.empty()) {
+    return makePosition(0, 0);
+  }
+
+  const Segment& last = *m_segments.back();
+  if (last.isSealed()) {
+    return makePosition(last.getSeq() + 1, 0);
+  }
+  return makePosition(last.getSeq(), last.getLogSize());
+}
+
+template<typename F>
+void
+DiskStorage::forEachPacket(const Name& prefix, bool isReverse, const F& f)
+{
+  for (const auto& segment : m_segments) {
+    segment->forEachEntry(prefix, isReverse, [&] (const Name& fullName, size_t offset) {
+      return f(*segment, fullName, makePosition(segment->getSeq(), offset), offset);
+    });
+  }
+}
+
+void
+DiskStorage::insert(const Data& data)
+{
+  const Name& fullName = data.getFullName();
+  bool isDuplicate = false;
+  forEachPacket(fullName, false, [&] (Segment&, const Name&, Position position, size_t) {
+    isDuplicate = !isErased(fullName, position);
+    return isDuplicate;
+  });
+  if (isDuplicate) {
+    return;
+  }
+
+  if (!m_segments.empty() && !m_segments.back()->isSealed()) {
+    if (m_segments.back()->append(data)) {
+      return;
+    }
+    m_segments.back()->seal();
+  }
+
+  uint64_t seq = m_segments.empty() ? 0 : m_segments.back()->getSeq() + 1;
+  auto segment = make_unique<Segment>(m_path, seq);
+  segment->openForAppend(std::max(m_segmentSize, data.wireEncode().size()));
+  segment->append(data);
+  m_segments.push_back(std::move(segment));
+}
+
+bool
+DiskStorage::matches(const Interest& interest, Segment& segment, const Name& fullName,
+                     Position position, size_t offset) const
+{
+  if (!interest.matchesName(fullName) || isErased(fullName, position)) {
+    return false;
+  }
+  // only PublisherPublicKeyLocator needs more than the full name
+  return interest.getPublisherPublicKeyLocator().empty() ||
+         interest.matchesData(*segment.readData(offset));
+}
+
+shared_ptr<const Data>
+DiskStorage::find(const Interest& interest)
+{
+  if (interest.getChildSelector() != 1) {
+    return findLeftmost(interest, interest.getName());
+  }
+
+  // like InMemoryStorage, the rightmost match is the leftmost packet under the rightmost child
+  // that has a match
+  size_t childIndex = interest.getName().size();
+  Name child;
+  bool hasChild = false;
+  forEachPacket(interest.getName(), true,
+    [&] (Segment& segment, const Name& fullName, Position position, size_t offset) {
+      // packets are visited in reverse order within each segment, so that no later packet of
+      // this segment can be under a greater child
+      Name candidate = fullName.getPrefix(childIndex + 1);
+      if (hasChild && candidate <= child) {
+        return true;
+      }
+      if (!matches(interest, segment, fullName, position, offset)) {
+        return false;
+      }
+      child = std::move(candidate);
+      hasChild = true;
+      return true;
+    });
+  return hasChild ? findLeftmost(interest, child) : nullptr;
+}
+
+shared_ptr<const Data>
+DiskStorage::findLeftmost(const Interest& interest, const Name& prefix)
+{
+  Segment* matchSegment = nullptr;
+  size_t matchOffset = 0;
+  Name matchName;
+  forEachPacket(prefix, false,
+    [&] (Segment& segment, const Name& fullName, Position position, size_t offset) {
+      // packets are visited in order within each segment, so that no later packet of this
+      // segment can be a better match
+      if (matchSegment != nullptr && matchName <= fullName) {
+        return true;
+      }
+      if (!matches(interest, segment, fullName, position, offset)) {
+        return false;
+      }
+      matchSegment = &segment;
+      matchOffset = offset;
+      matchName = fullName;
+      return true;
+    });
+  return matchSegment == nullptr ? nullptr : matchSegment->readData(matchOffset);
+}
+
+shared_ptr<const Data>
+DiskStorage::find(const Name& name)
+{
+  Segment* matchSegment = nullptr;
+  size_t matchOffset = 0;
+  Name matchName;
+  forEachPacket(name, false,
+    [&] (Segment& segment, const Name& fullName, Position position, size_t offset) {
+      if (matchSegment != nullptr && matchName <= fullName) {
+        return true;
+      }
+      if (isErased(fullName, position)) {
+        return false;
+      }
+      matchSegment = &segment;
+      matchOffset = offset;
+      matchName = fullName;
+      return true;
+    });
+  return matchSegment == nullptr ? nullptr : matchSegment->readData(matchOffset);
+}
+
+void
+DiskStorage::erase(const Name& prefix, bool isPrefix)
+{
+  Position position = getNextPosition();
+  if (isPrefix) {
+    m_erasedPrefixes[prefix] = position;
+  }
+  else {
+    m_erasedNames[prefix] = position;
+  }
+  recordErased(prefix, isPrefix, position);
+}
+
+bool
+DiskStorage::isErased(const Name& fullName, Position position) const
+{
+  auto it = m_erasedNames.find(fullName);
+  if (it != m_erasedNames.end() && position < it->second) {
+    return true;
+  }
+
+  // a prefix erases the packets whose names (without implicit digest) start with it
+  if (!m_erasedPrefixes.empty()) {
+    Name prefix;
+    for (size_t i = 0; i < fullName.size(); ++i) {
+      it = m_erasedPrefixes.find(prefix);
+      if (it != m_erasedPrefixes.end() && position < it->second) {
+        return true;
+      }
+      prefix.append(fullName[i]);
+    }
+  }
+  return false;
+}
+
+// The erase log is a sequence of records, each of which contains the erased Name in wire
+// encoding, a byte that is 1 if the Name is a prefix, and the position of the next packet to be
+// inserted at the time of erasure as a 64-bit integer in network byte order.
+
+void
+DiskStorage::loadErased()
+{
+  std::ifstream file((fs::path(m_path) / "erased").string(), std::ios::binary);
+  if (!file) {
+    return;
+  }
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const uint8_t* pos = reinterpret_cast<const uint8_t*>(content.data());
+  const uint8_t* end = pos + content.size();
+  while (pos < end) {
+    size_t nameSize = getElementSize(pos, end, tlv::Name);
+    if (nameSize == 0 || static_cast<size_t>(end - pos) < nameSize + 1 + sizeof(uint64_t)) {
+      // the record was partially written before a crash
+      break;
+    }
+    Name name(Block(pos, nameSize));
+    bool isPrefix = pos[nameSize] != 0;
+    uint64_t position = 0;
+    std::memcpy(&position, pos + nameSize + 1, sizeof(position));
+    boost::endian::big_to_native_inplace(position);
+
+    auto& erased = isPrefix ? m_erasedPrefixes : m_erasedNames;
+    erased[name] = std::max(erased[name], position);
+    pos += nameSize + 1 + sizeof(uint64_t);
+  }
+}
+
+void
+DiskStorage::recordErased(const Name& name, bool isPrefix, Position position)
+{
+  std::ofstream file((fs::path(m_path) / "erased").string(), std::ios::binary | std::ios::app);
+  const Block& wire = name.wireEncode();
+  file.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+  file.put(isPrefix ? 1 : 0);
+  boost::endian::native_to_big_inplace(position);
+  file.write(reinterpret_cast<const char*>(&position), sizeof(position));
+  file.close();
+  if (!file) {
+    BOOST_THROW_EXCEPTION(Error("Cannot write erase record in " + m_path));
+  }
+}
+
+void
+DiskStorage::compact()
+{
+  bool hasActiveSegment = !m_segments.empty() && !m_segments.back()->isSealed();
+  size_t nSealed = m_segments.size() - (hasActiveSegment ? 1 : 0);
+  Position sealedEnd = hasActiveSegment ? makePosition(m_segments.back()->getSeq(), 0) :
+                                          getNextPosition();
+
+  for (size_t i = 0; i < nSealed; ) {
+    Segment& segment = *m_segments[i];
+    std::vector<std::pair<Name, size_t>> live;
+    bool hasErased = false;
+    segment.forEachEntry(Name(), false, [&] (const Name& fullName, size_t offset) {
+      if (isErased(fullName, makePosition(segment.getSeq(), offset))) {
+        hasErased = true;
+      }
+      else {
+        live.emplace_back(fullName, offset);
+      }
+      return false;
+    });
+
+    // an empty segment is dropped, unless it is the last one, whose sequence number
+    // must not be reused
+    if (live.empty() && i + 1 < m_segments.size()) {
+      segment.remove();
+      m_segments.erase(m_segments.begin() + i);
+      --nSealed;
+      continue;
+    }
+
+    if (hasErased) {
+      // the new log keeps the order of insertion
+      std::sort(live.begin(), live.end(),
+                [] (const auto& a, const auto& b) { return a.second < b.second; });
+      segment.rewrite(live);
+    }
+    ++i;
+  }
+
+  // an erase record affects only packets inserted before it; those in sealed segments are gone
+  pruneErased(sealedEnd);
+}
+
+void
+DiskStorage::pruneErased(Position sealedEnd)
+{
+  size_t nRecords = m_erasedPrefixes.size() + m_erasedNames.size();
+  for (auto* erased : {&m_erasedPrefixes, &m_erasedNames}) {
+    for (auto it = erased->begin(); it != erased->end(); ) {
+      if (it->second <= sealedEnd) {
+        it = erased->erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+  if (m_erasedPrefixes.size() + m_erasedNames.size() == nRecords) {
+    return;
+  }
+
+  OBufferStream os;
+  for (const auto* erased : {&m_erasedPrefixes, &m_erasedNames}) {
+    for (const auto& record : *erased) {
+      const Block& wire = record.first.wireEncode();
+      os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+      os.put(erased == &m_erasedPrefixes ? 1 : 0);
+      uint64_t position = boost::endian::native_to_big(record.second);
+      os.write(reinterpret_cast<const char*>(&position), sizeof(position));
+    }
+  }
+  writeFileAtomically((fs::path(m_path) / "erased").string(), *os.buf());
+}
+
+void
+DiskStorage::flush()
+{
+  if (!m_segments.empty() && !m_segments.back()->isSealed()) {
+    m_segments.back()->sync();
+  }
+}
+
+} // namespace ndn
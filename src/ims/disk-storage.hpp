@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_DISK_STORAGE_HPP
+#define NDN_IMS_DISK_STORAGE_HPP
+
+#include "../data.hpp"
+#include "../interest.hpp"
+
+#include <map>
+
+namespace ndn {
+
+/** @brief Represents a persistent storage of Data packets in memory-mapped files
+ *
+ *  DiskStorage offers the insert/find/erase interface of InMemoryStorage, but keeps packets in
+ *  a directory instead of the heap, so that a producer can serve a publication larger than its
+ *  memory, and find its packets again after a restart.  Like InMemoryStoragePersistent, it
+ *  never evicts packets.
+ *
+ *  Wire encodings of inserted packets are appended to a log segment, which is a file mapped
+ *  into memory.  When a segment is full, it is sealed: an index file listing its packets in
+ *  order of full names is written next to it, and a new segment is started.  The index of the
+ *  active segment is kept in memory, and is rebuilt from the segment at startup.  Sealed
+ *  segments and their index files are mapped on first use, so that opening a storage only
+ *  reads the active segment.
+ *
+ *  Erased packets are recorded in a separate log, and remain in their segments until compact()
+ *  rewrites the sealed segments without them.
+ *
+ *  @note MustBeFresh is ignored in Interest processing, as with InMemoryStorage(size_t).
+ *  @note Packets are written through a shared mapping, so that they survive a crash of the
+ *        process; use flush() to write them to the disk.
+ */
+class DiskStorage : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** @brief Open or create a storage
+   *  @param path directory of the storage, which is created if it does not exist
+   *  @param segmentSize size of log segments in bytes; a packet larger than this is placed
+   *                     in a segment of its own
+   *  @throw Error the storage cannot be opened
+   */
+  explicit
+  DiskStorage(const std::string& path, size_t segmentSize = DEFAULT_SEGMENT_SIZE);
+
+  ~DiskStorage();
+
+  /** @brief Inserts a Data packet
+   *
+   *  @param data the packet to insert, must be signed and have wire encoding
+   *  @note Packets are considered duplicate if the name with implicit digest matches.
+   *  @throw Error the packet cannot be written
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the best match Data for an Interest
+   *
+   *  Like InMemoryStorage, the rightmost match is the leftmost packet under the rightmost child
+   *  of the Interest name that has a match.
+   *
+   *  @return{ the best match, if any; otherwise a null shared_ptr }
+   *  @note Candidates are matched by their full names in the index.  Only the returned Data is
+   *        decoded from a copy of its wire encoding in the mapped segment, unless the Interest
+   *        has a PublisherPublicKeyLocator, which requires decoding each candidate.
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Finds the first Data whose full name starts with @p name
+   *
+   *  @return{ the one matched the Name; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Deletes packets by prefix by default
+   *  @param prefix Exact name of a prefix of the data to remove
+   *  @param isPrefix If false, the function will only delete the packet whose full name is
+   *                  @p prefix
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /** @brief Reclaims the space of erased packets
+   *
+   *  Sealed segments that contain erased packets are rewritten without them, and segments
+   *  left empty are removed.  Erase records that only affect sealed segments are then
+   *  dropped.  The active segment is not compacted; erased packets in it are reclaimed by a
+   *  later call, after it is sealed.
+   *
+   *  @throw Error a segment or the erase log cannot be written
+   */
+  void
+  compact();
+
+  /** @brief Writes packets in the active segment to the disk
+   *
+   *  Erase records are written when erase() is called.
+   */
+  void
+  flush();
+
+  /** @return{ number of log segments }
+   */
+  size_t
+  getNSegments() const
+  {
+    return m_segments.size();
+  }
+
+public:
+  static const size_t DEFAULT_SEGMENT_SIZE;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  class Segment;
+
+  /** @brief position of a packet in the storage, which increases with each insertion
+   *
+   *  The upper 24 bits are the sequence number of the segment, and the lower 40 bits are the
+   *  offset of the packet in the segment.
+   */
+  using Position = uint64_t;
+
+  static Position
+  makePosition(uint64_t seq, uint64_t offset)
+  {
+    return (seq << 40) | offset;
+  }
+
+  /** @return{ position of the next packet to be inserted }
+   */
+  Position
+  getNextPosition() const;
+
+  /** @return{ whether the packet named @p fullName at @p position has been erased }
+   */
+  bool
+  isErased(const Name& fullName, Position position) const;
+
+  void
+  loadErased();
+
+  /** @brief drop erase records at or before @p sealedEnd, and rewrite the erase log
+   */
+  void
+  pruneErased(Position sealedEnd);
+
+  void
+  recordErased(const Name& name, bool isPrefix, Position position);
+
+  /** @brief invoke @p f with every packet whose full name starts with @p prefix, in order of
+   *         full names within each segment, until @p f returns true
+   */
+  template<typename F>
+  void
+  forEachPacket(const Name& prefix, bool isReverse, const F& f);
+
+  /** @return{ whether the packet named @p fullName at @p position, stored at @p offset of
+   *           @p segment, has not been erased and satisfies @p interest }
+   */
+  bool
+  matches(const Interest& interest, Segment& segment, const Name& fullName,
+          Position position, size_t offset) const;
+
+  /** @return{ the leftmost packet under @p prefix that matches @p interest }
+   */
+  shared_ptr<const Data>
+  findLeftmost(const Interest& interest, const Name& prefix);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::string m_path;
+  size_t m_segmentSize;
+  /// log segments ordered by sequence number; the last one may be active
+  std::vector<unique_ptr<Segment>> m_segments;
+  /// erased prefixes, and when they were erased
+  std::map<Name, Position> m_erasedPrefixes;
+  /// erased full names, and when they were erased
+  std::map<Name, Position> m_erasedNames;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_DISK_STORAGE_HPP
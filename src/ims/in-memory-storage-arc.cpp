@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-arc.hpp"
+
+namespace ndn {
+
+InMemoryStorageArc::InMemoryStorageArc(size_t limit)
+  : InMemoryStorage(limit)
+  , m_target(0)
+{
+}
+
+InMemoryStorageArc::InMemoryStorageArc(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+  , m_target(0)
+{
+}
+
+void
+InMemoryStorageArc::afterInsert(InMemoryStorageEntry* entry)
+{
+  bool isFrequent = false;
+
+  auto ghost = m_ghosts.find(entry->getFullName());
+  if (ghost != m_ghosts.end()) {
+    // a ghost hit in B1 means T1 was too small, a ghost hit in B2 means T2 was too small
+    if (!ghost->second.isFrequent) {
+      size_t delta = std::max<size_t>(1, m_b2.size() / m_b1.size());
+      m_target = std::min(getCapacity(), m_target + delta);
+      m_b1.erase(ghost->second.it);
+    }
+    else {
+      size_t delta = std::max<size_t>(1, m_b1.size() / m_b2.size());
+      m_target -= std::min(m_target, delta);
+      m_b2.erase(ghost->second.it);
+    }
+    m_ghosts.erase(ghost);
+    isFrequent = true;
+  }
+
+  Queue& queue = isFrequent ? m_t2 : m_t1;
+  queue.push_back(entry);
+  m_positions[entry] = {isFrequent, std::prev(queue.end())};
+  updateQuotaOrder(entry, isFrequent);
+  trimGhosts();
+}
+
+bool
+InMemoryStorageArc::evictItem()
+{
+  if (m_t1.empty() && m_t2.empty()) {
+    return false;
+  }
+
+  bool isFromT1 = !m_t1.empty() && (m_t1.size() > m_target || m_t2.empty());
+  evictEntry(isFromT1 ? m_t1.front() : m_t2.front());
+  return true;
+}
+
+bool
+InMemoryStorageArc::evictEntry(InMemoryStorageEntry* entry)
+{
+  bool isFrequent = m_positions.at(entry).isFrequent;
+  GhostQueue& ghosts = isFrequent ? m_b2 : m_b1;
+  ghosts.push_back(entry->getFullName());
+  m_ghosts[ghosts.back()] = {isFrequent, std::prev(ghosts.end())};
+
+  beforeErase(entry);
+  eraseImpl(entry->getFullName());
+  trimGhosts();
+  return true;
+}
+
+void
+InMemoryStorageArc::trimGhosts()
+{
+  size_t capacity = getCapacity();
+
+  auto dropOldest = [this] (GhostQueue& ghosts) {
+    m_ghosts.erase(ghosts.front());
+    ghosts.pop_front();
+  };
+
+  while (!m_b1.empty() && m_t1.size() + m_b1.size() > capacity) {
+    dropOldest(m_b1);
+  }
+  while (m_b1.size() + m_b2.size() > capacity) {
+    dropOldest(m_b2.empty() ? m_b1 : m_b2);
+  }
+}
+
+void
+InMemoryStorageArc::afterAccess(InMemoryStorageEntry* entry)
+{
+  Position& pos = m_positions.at(entry);
+  m_t2.splice(m_t2.end(), pos.isFrequent ? m_t2 : m_t1, pos.it);
+  pos.isFrequent = true;
+  updateQuotaOrder(entry, 1);
+}
+
+void
+InMemoryStorageArc::beforeErase(InMemoryStorageEntry* entry)
+{
+  auto pos = m_positions.find(entry);
+  if (pos == m_positions.end()) {
+    return;
+  }
+
+  (pos->second.isFrequent ? m_t2 : m_t1).erase(pos->second.it);
+  m_positions.erase(pos);
+}
+
+} // namespace ndn
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
+#define NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/** @brief Provides in-memory storage employing Adaptive Replacement Cache (ARC) policy.
+ *
+ *  Packets found once are kept in a recency list (T1), and packets found at least twice are
+ *  kept in a frequency list (T2).  The full names of packets evicted from either list are
+ *  remembered in ghost lists (B1 and B2).  Reinserting a packet that is in a ghost list adapts
+ *  the target size of T1, so that the storage balances recency and frequency according to the
+ *  workload.  A sequence of packets that are never found again only cycles through T1.
+ *
+ *  ARC decides which list to evict from by knowing the packet being inserted.  Because
+ *  evictItem() runs before the packet is inserted, this implementation evicts from T1 only
+ *  when T1 exceeds its target size, without the tie-breaking rule for ghost hits in B2.
+ *
+ *  @sa Nimrod Megiddo, Dharmendra S. Modha, "ARC: A Self-Tuning, Low Overhead Replacement
+ *      Cache", USENIX FAST 2003
+ */
+class InMemoryStorageArc : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageArc(size_t limit = 10);
+
+  explicit
+  InMemoryStorageArc(boost::asio::io_service& ioService, size_t limit = 10);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on ARC, i.e. evict the least
+   *  recently used packet of T1 if T1 exceeds its target size, otherwise of T2
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictItem() override;
+
+  /** @brief Removes @p entry from in-memory storage and remembers its name in B1 or B2;
+   *  entries under a prefix quota are evicted from T1 before T2, least recently used first
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictEntry(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  move it to the most recently used end of T2
+   */
+  void
+  afterAccess(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry after a entry is successfully inserted, add it to T2 if it was
+   *  remembered in a ghost list, otherwise to T1
+   */
+  void
+  afterInsert(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  remove it from T1 or T2
+   */
+  void
+  beforeErase(InMemoryStorageEntry* entry) override;
+
+private:
+  using Queue = std::list<InMemoryStorageEntry*>;
+  using GhostQueue = std::list<Name>;
+
+  struct Position
+  {
+    bool isFrequent; ///< whether the entry is in T2
+    Queue::iterator it;
+  };
+
+  struct GhostPosition
+  {
+    bool isFrequent; ///< whether the name is in B2
+    GhostQueue::iterator it;
+  };
+
+  /** @brief drop the oldest ghost names so that T1 + B1 and B1 + B2 stay within the capacity
+   */
+  void
+  trimGhosts();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// least recently used entries or names are at the front of each queue
+  Queue m_t1;
+  Queue m_t2;
+  GhostQueue m_b1;
+  GhostQueue m_b2;
+  std::unordered_map<InMemoryStorageEntry*, Position> m_positions;
+  std::unordered_map<Name, GhostPosition> m_ghosts;
+  /// target size of T1
+  size_t m_target;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
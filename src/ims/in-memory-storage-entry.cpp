@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,7 +24,10 @@
 namespace ndn {
 
 InMemoryStorageEntry::InMemoryStorageEntry()
-  : m_isFresh(true)
+  : m_wireSize(0)
+  , m_isFresh(true)
+  , m_staleTime(time::steady_clock::TimePoint::max())
+  , m_quota(nullptr)
 {
 }
 
@@ -32,26 +35,23 @@ void
 InMemoryStorageEntry::release()
 {
   m_dataPacket.reset();
-  m_markStaleEventId.reset();
+  m_wireSize = 0;
+  m_staleTime = time::steady_clock::TimePoint::max();
 }
 
 void
 InMemoryStorageEntry::setData(const Data& data)
 {
   m_dataPacket = data.shared_from_this();
+  m_wireSize = data.wireEncode().size();
   m_isFresh = true;
 }
 
-void
-InMemoryStorageEntry::setMarkStaleEventId(unique_ptr<util::scheduler::ScopedEventId> markStaleEventId)
-{
-  m_markStaleEventId = std::move(markStaleEventId);
-}
-
 void
 InMemoryStorageEntry::markStale()
 {
   m_isFresh = false;
+  m_staleTime = time::steady_clock::TimePoint::max();
 }
 
 } // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,10 +24,12 @@
 
 #include "../data.hpp"
 #include "../interest.hpp"
-#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/time.hpp"
 
 namespace ndn {
 
+struct InMemoryStoragePrefixQuota;
+
 /** @brief Represents an in-memory storage entry
  */
 class InMemoryStorageEntry : noncopyable
@@ -67,6 +69,14 @@ public:
     return *m_dataPacket;
   }
 
+  /** @brief Returns the size of the wire encoding of the Data packet
+   */
+  size_t
+  getWireSize() const
+  {
+    return m_wireSize;
+  }
+
   /** @brief Changes the content of in-memory storage entry
    *
    *  This method also allows data to satisfy Interest with MustBeFresh
@@ -74,10 +84,25 @@ public:
   void
   setData(const Data& data);
 
-  /** @brief Set eventId for the markStale event.
+  /** @brief Returns the time when the entry should be marked stale
+   *
+   *  This is TimePoint::max() if the entry never becomes stale, or is already stale.
+   */
+  time::steady_clock::TimePoint
+  getStaleTime() const
+  {
+    return m_staleTime;
+  }
+
+  /** @brief Set the time when the entry should be marked stale
+   *
+   *  @warning This must not be changed while the entry is indexed by stale time.
    */
   void
-  setMarkStaleEventId(unique_ptr<util::scheduler::ScopedEventId> eventId);
+  setStaleTime(time::steady_clock::TimePoint staleTime)
+  {
+    m_staleTime = staleTime;
+  }
 
   /** @brief Disable the data from satisfying interest with MustBeFresh
    */
@@ -94,9 +119,18 @@ public:
 
 private:
   shared_ptr<const Data> m_dataPacket;
+  size_t m_wireSize;
 
   bool m_isFresh;
-  unique_ptr<util::scheduler::ScopedEventId> m_markStaleEventId;
+  time::steady_clock::TimePoint m_staleTime;
+
+  /// prefix quota that the packet is counted against, maintained by InMemoryStorage
+  InMemoryStoragePrefixQuota* m_quota;
+  /// group and sequence number that order the entry within m_quota
+  std::pair<uint64_t, uint64_t> m_quotaOrder;
+
+  friend class InMemoryStorage;
+  friend struct InMemoryStoragePrefixQuota;
 };
 
 } // namespace ndn
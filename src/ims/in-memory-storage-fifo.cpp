@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -53,6 +53,14 @@ InMemoryStorageFifo::evictItem()
   return false;
 }
 
+bool
+InMemoryStorageFifo::evictEntry(InMemoryStorageEntry* entry)
+{
+  beforeErase(entry);
+  eraseImpl(entry->getFullName());
+  return true;
+}
+
 void
 InMemoryStorageFifo::beforeErase(InMemoryStorageEntry* entry)
 {
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -48,6 +48,13 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   bool
   evictItem() override;
 
+  /** @brief Removes @p entry from in-memory storage to enforce its prefix quota; entries
+   *  under a prefix quota are evicted in insertion order
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictEntry(InMemoryStorageEntry* entry) override;
+
   /** @brief Update the entry after a entry is successfully inserted, add it to the cleanupIndex
    */
   void
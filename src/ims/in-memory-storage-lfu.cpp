@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -56,6 +56,14 @@ InMemoryStorageLfu::evictItem()
   return false;
 }
 
+bool
+InMemoryStorageLfu::evictEntry(InMemoryStorageEntry* entry)
+{
+  beforeErase(entry);
+  eraseImpl(entry->getFullName());
+  return true;
+}
+
 void
 InMemoryStorageLfu::beforeErase(InMemoryStorageEntry* entry)
 {
@@ -69,6 +77,7 @@ InMemoryStorageLfu::afterAccess(InMemoryStorageEntry* entry)
 {
   CleanupIndex::index<byEntity>::type::iterator it = m_cleanupIndex.get<byEntity>().find(entry);
   m_cleanupIndex.get<byEntity>().modify(it, &incrementFrequency);
+  updateQuotaOrder(entry, it->frequency);
 }
 
 } // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -55,6 +55,14 @@ InMemoryStorageLru::evictItem()
   return false;
 }
 
+bool
+InMemoryStorageLru::evictEntry(InMemoryStorageEntry* entry)
+{
+  beforeErase(entry);
+  eraseImpl(entry->getFullName());
+  return true;
+}
+
 void
 InMemoryStorageLru::beforeErase(InMemoryStorageEntry* entry)
 {
@@ -68,6 +76,7 @@ InMemoryStorageLru::afterAccess(InMemoryStorageEntry* entry)
 {
   beforeErase(entry);
   afterInsert(entry);
+  updateQuotaOrder(entry);
 }
 
 } // namespace ndn
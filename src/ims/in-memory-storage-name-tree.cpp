@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-name-tree.hpp"
+
+namespace ndn {
+
+class InMemoryStorageNameTree::Node
+{
+public:
+  size_t
+  countEntries(bool mustBeFresh) const
+  {
+    return mustBeFresh ? nFreshEntries : nEntries;
+  }
+
+public:
+  std::map<name::Component, unique_ptr<Node>> children;
+  std::map<name::Component, Node*> freshChildren; ///< children with fresh entries in subtrees
+  InMemoryStorageEntry* entry = nullptr;
+  size_t nEntries = 0;      ///< number of entries in the subtree
+  size_t nFreshEntries = 0; ///< number of fresh entries in the subtree
+};
+
+InMemoryStorageNameTree::InMemoryStorageNameTree()
+  : m_root(make_unique<Node>())
+  , m_nNodes(1)
+{
+}
+
+InMemoryStorageNameTree::~InMemoryStorageNameTree() = default;
+
+void
+InMemoryStorageNameTree::insert(InMemoryStorageEntry* entry)
+{
+  bool isFresh = entry->isFresh();
+  Node* node = m_root.get();
+  for (const name::Component& component : entry->getFullName()) {
+    ++node->nEntries;
+    node->nFreshEntries += isFresh;
+
+    unique_ptr<Node>& child = node->children[component];
+    if (child == nullptr) {
+      child = make_unique<Node>();
+      ++m_nNodes;
+    }
+    if (isFresh && child->nFreshEntries == 0) {
+      node->freshChildren.emplace(component, child.get());
+    }
+    node = child.get();
+  }
+
+  BOOST_ASSERT(node->entry == nullptr);
+  node->entry = entry;
+  ++node->nEntries;
+  node->nFreshEntries += isFresh;
+}
+
+void
+InMemoryStorageNameTree::erase(InMemoryStorageEntry* entry)
+{
+  const Name& fullName = entry->getFullName();
+  std::vector<Node*> path = findPath(fullName);
+
+  BOOST_ASSERT(path.back()->entry == entry);
+  path.back()->entry = nullptr;
+
+  if (entry->isFresh()) {
+    decrementFreshEntries(path, fullName);
+  }
+  for (Node* node : path) {
+    --node->nEntries;
+  }
+
+  // remove nodes that no longer have any entry in their subtrees, except the root node
+  for (size_t i = fullName.size(); i > 0 && path[i]->nEntries == 0; --i) {
+    path[i - 1]->children.erase(fullName[i - 1]);
+    --m_nNodes;
+  }
+}
+
+void
+InMemoryStorageNameTree::beforeMarkStale(InMemoryStorageEntry* entry)
+{
+  if (!entry->isFresh()) {
+    return;
+  }
+
+  const Name& fullName = entry->getFullName();
+  decrementFreshEntries(findPath(fullName), fullName);
+}
+
+std::vector<InMemoryStorageNameTree::Node*>
+InMemoryStorageNameTree::findPath(const Name& fullName) const
+{
+  std::vector<Node*> path;
+  path.reserve(fullName.size() + 1);
+  path.push_back(m_root.get());
+  for (const name::Component& component : fullName) {
+    auto it = path.back()->children.find(component);
+    BOOST_ASSERT(it != path.back()->children.end());
+    path.push_back(it->second.get());
+  }
+  return path;
+}
+
+void
+InMemoryStorageNameTree::decrementFreshEntries(const std::vector<Node*>& path, const Name& fullName)
+{
+  for (size_t i = 0; i < path.size(); ++i) {
+    BOOST_ASSERT(path[i]->nFreshEntries > 0);
+    if (--path[i]->nFreshEntries == 0 && i > 0) {
+      path[i - 1]->freshChildren.erase(fullName[i - 1]);
+    }
+  }
+}
+
+const InMemoryStorageNameTree::Node*
+InMemoryStorageNameTree::findNode(const Name& name) const
+{
+  const Node* node = m_root.get();
+  for (const name::Component& component : name) {
+    auto it = node->children.find(component);
+    if (it == node->children.end()) {
+      return nullptr;
+    }
+    node = it->second.get();
+  }
+  return node;
+}
+
+InMemoryStorageEntry*
+InMemoryStorageNameTree::find(const Interest& interest) const
+{
+  const Node* node = findNode(interest.getName());
+  if (node == nullptr || node->countEntries(interest.getMustBeFresh()) == 0) {
+    return nullptr;
+  }
+
+  if (interest.getChildSelector() <= 0) {
+    return findLeftmost(*node, 0, interest);
+  }
+
+  InMemoryStorageEntry* entry = interest.getMustBeFresh() ?
+    findInChildren(node->freshChildren.rbegin(), node->freshChildren.rend(), 1, interest) :
+    findInChildren(node->children.rbegin(), node->children.rend(), 1, interest);
+  if (entry != nullptr) {
+    return entry;
+  }
+
+  // Interest name is the full name of an entry
+  if (node->entry != nullptr &&
+      (!interest.getMustBeFresh() || node->entry->isFresh()) &&
+      interest.matchesData(node->entry->getData())) {
+    return node->entry;
+  }
+  return nullptr;
+}
+
+InMemoryStorageEntry*
+InMemoryStorageNameTree::findLeftmost(const Node& node, size_t depth,
+                                      const Interest& interest) const
+{
+  // an entry is ordered before the entries under its children
+  if (node.entry != nullptr &&
+      (!interest.getMustBeFresh() || node.entry->isFresh()) &&
+      interest.matchesData(node.entry->getData())) {
+    return node.entry;
+  }
+
+  return interest.getMustBeFresh() ?
+    findInChildren(node.freshChildren.begin(), node.freshChildren.end(), depth + 1, interest) :
+    findInChildren(node.children.begin(), node.children.end(), depth + 1, interest);
+}
+
+template<typename Iterator>
+InMemoryStorageEntry*
+InMemoryStorageNameTree::findInChildren(Iterator first, Iterator last, size_t childDepth,
+                                        const Interest& interest) const
+{
+  for (; first != last; ++first) {
+    const Node& child = *first->second;
+    if (canSkip(child, first->first, childDepth, interest)) {
+      continue;
+    }
+    InMemoryStorageEntry* entry = findLeftmost(child, childDepth, interest);
+    if (entry != nullptr) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+bool
+InMemoryStorageNameTree::canSkip(const Node& child, const name::Component& component,
+                                 size_t childDepth, const Interest& interest) const
+{
+  // childDepth is the number of components after Interest name in any entry under child
+  if (child.countEntries(interest.getMustBeFresh()) == 0) {
+    return true;
+  }
+
+  int maxSuffixComponents = interest.getMaxSuffixComponents();
+  if (maxSuffixComponents >= 0 && childDepth > static_cast<size_t>(maxSuffixComponents)) {
+    return true;
+  }
+
+  // Exclude applies to the first component after Interest name
+  return childDepth == 1 && !interest.getExclude().empty() &&
+         interest.getExclude().isExcluded(component);
+}
+
+} // namespace ndn
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_IN_MEMORY_STORAGE_NAME_TREE_HPP
+#define NDN_IMS_IN_MEMORY_STORAGE_NAME_TREE_HPP
+
+#include "in-memory-storage-entry.hpp"
+
+#include <map>
+
+namespace ndn {
+
+/** @brief Represents a name tree index of in-memory storage entries
+ *
+ *  Every node corresponds to a name prefix, and its children are ordered by name component.
+ *  An entry is attached to the node of its full name. Every node counts the entries, and the
+ *  fresh entries, in its subtree, and keeps a separate index of children that have fresh
+ *  entries, so that a lookup never visits a subtree without any candidate.
+ *
+ *  Without selectors other than CanBePrefix, MustBeFresh, and ChildSelector, find() visits
+ *  O(depth) nodes regardless of the number of stale entries under the Interest name.
+ */
+class InMemoryStorageNameTree : noncopyable
+{
+public:
+  InMemoryStorageNameTree();
+
+  ~InMemoryStorageNameTree();
+
+  /** @brief Adds an entry to the index
+   *  @pre no entry with the same full name exists in the index
+   */
+  void
+  insert(InMemoryStorageEntry* entry);
+
+  /** @brief Removes an entry from the index
+   *  @pre the entry exists in the index
+   */
+  void
+  erase(InMemoryStorageEntry* entry);
+
+  /** @brief Updates fresh counts before a fresh entry is marked stale
+   *
+   *  This must be invoked before InMemoryStorageEntry::markStale. It has no effect if the
+   *  entry is already stale.
+   */
+  void
+  beforeMarkStale(InMemoryStorageEntry* entry);
+
+  /** @brief Finds the best match entry for an Interest
+   *
+   *  When ChildSelector is leftmost or undeclared, this returns the first matching entry in
+   *  canonical order. When ChildSelector is rightmost, this returns the leftmost matching
+   *  entry under the rightmost child of the Interest name that contains any matching entry.
+   *
+   *  @return the best match, if any; otherwise nullptr
+   */
+  InMemoryStorageEntry*
+  find(const Interest& interest) const;
+
+  /** @return number of nodes, including the root node
+   */
+  size_t
+  getNodeCount() const
+  {
+    return m_nNodes;
+  }
+
+private:
+  class Node;
+
+  const InMemoryStorageNameTree::Node*
+  findNode(const Name& name) const;
+
+  /** @return nodes from the root to the node of @p fullName
+   *  @pre the node of @p fullName exists
+   */
+  std::vector<Node*>
+  findPath(const Name& fullName) const;
+
+  void
+  decrementFreshEntries(const std::vector<Node*>& path, const Name& fullName);
+
+  InMemoryStorageEntry*
+  findLeftmost(const Node& node, size_t depth, const Interest& interest) const;
+
+  template<typename Iterator>
+  InMemoryStorageEntry*
+  findInChildren(Iterator first, Iterator last, size_t childDepth, const Interest& interest) const;
+
+  bool
+  canSkip(const Node& child, const name::Component& component, size_t childDepth,
+          const Interest& interest) const;
+
+private:
+  unique_ptr<Node> m_root;
+  size_t m_nNodes;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_IN_MEMORY_STORAGE_NAME_TREE_HPP
@@ -28,6 +28,9 @@ namespace ndn {
 
 /** @brief Provides application cache with persistent storage, of which no replacement policy will
  *  be employed. Entries will only be deleted by explicit application control.
+ *
+ *  Because nothing is evicted, insert() returns false and drops the packet when the storage
+ *  is at its limit, or the packet does not fit within the byte limit or a prefix quota.
  */
 class InMemoryStoragePersistent : public InMemoryStorage
 {
@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-tinylfu.hpp"
+
+namespace ndn {
+
+constexpr size_t InMemoryStorageTinyLfu::FrequencySketch::N_ROWS;
+constexpr uint8_t InMemoryStorageTinyLfu::FrequencySketch::MAX_COUNT;
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::ensureCapacity(size_t nItems)
+{
+  size_t nWords = 16;
+  while (nWords < nItems) {
+    nWords <<= 1;
+  }
+
+  // 16 counters per item keep collisions in a row of the sketch rare
+  if (nWords * 16 <= m_nCounters) {
+    return;
+  }
+
+  // An index is the hash masked to the number of counters, so after doubling the table,
+  // the counter of an item is at its old index or at that index plus the old table size.
+  // Repeating the old table keeps every estimate, while new items spread over the larger table.
+  size_t nOldWords = m_table.size();
+  m_table.resize(nWords);
+  for (size_t i = nOldWords; nOldWords > 0 && i < nWords; ++i) {
+    m_table[i] = m_table[i % nOldWords];
+  }
+  m_nCounters = nWords * 16;
+  m_sampleSize = 10 * nWords;
+}
+
+size_t
+InMemoryStorageTinyLfu::FrequencySketch::getIndex(size_t hash, size_t row) const
+{
+  static const uint64_t SEEDS[N_ROWS] = {
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+  };
+
+  uint64_t h = (static_cast<uint64_t>(hash) ^ SEEDS[row]) * 0x9e3779b97f4a7c15ULL;
+  h ^= h >> 32;
+  return static_cast<size_t>(h & (m_nCounters - 1));
+}
+
+uint8_t
+InMemoryStorageTinyLfu::FrequencySketch::getCounter(size_t index) const
+{
+  return (m_table[index / 16] >> (index % 16 * 4)) & 0xF;
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::increment(size_t hash)
+{
+  if (m_nCounters == 0) {
+    ensureCapacity(0);
+  }
+
+  size_t indices[N_ROWS];
+  uint8_t minCount = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    indices[row] = getIndex(hash, row);
+    minCount = std::min(minCount, getCounter(indices[row]));
+  }
+
+  // conservative update: only the smallest counters are incremented
+  if (minCount < MAX_COUNT) {
+    for (size_t index : indices) {
+      if (getCounter(index) == minCount) {
+        m_table[index / 16] += uint64_t(1) << (index % 16 * 4);
+      }
+    }
+  }
+
+  if (++m_nIncrements >= m_sampleSize) {
+    halve();
+  }
+}
+
+uint8_t
+InMemoryStorageTinyLfu::FrequencySketch::estimate(size_t hash) const
+{
+  if (m_nCounters == 0) {
+    return 0;
+  }
+
+  uint8_t minCount = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    minCount = std::min(minCount, getCounter(getIndex(hash, row)));
+  }
+  return minCount;
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::halve()
+{
+  for (uint64_t& word : m_table) {
+    word = (word >> 1) & 0x7777777777777777ULL;
+  }
+  m_nIncrements /= 2;
+}
+
+InMemoryStorageTinyLfu::InMemoryStorageTinyLfu(size_t limit)
+  : InMemoryStorage(limit)
+{
+}
+
+InMemoryStorageTinyLfu::InMemoryStorageTinyLfu(boost::asio::io_service& ioService, size_t limit)
+  : InMemoryStorage(ioService, limit)
+{
+}
+
+size_t
+InMemoryStorageTinyLfu::getHash(const InMemoryStorageEntry* entry)
+{
+  return std::hash<Name>()(entry->getName());
+}
+
+InMemoryStorageTinyLfu::Queue&
+InMemoryStorageTinyLfu::getQueue(Segment segment)
+{
+  switch (segment) {
+    case WINDOW:
+      return m_window;
+    case PROBATION:
+      return m_probation;
+    case PROTECTED:
+      return m_protected;
+  }
+  BOOST_ASSERT(false);
+  return m_window;
+}
+
+void
+InMemoryStorageTinyLfu::moveTo(InMemoryStorageEntry* entry, Segment segment)
+{
+  Position& pos = m_positions.at(entry);
+  Queue& dest = getQueue(segment);
+  dest.splice(dest.end(), getQueue(pos.segment), pos.it);
+  pos.segment = segment;
+  updateQuotaOrder(entry, segment);
+}
+
+bool
+InMemoryStorageTinyLfu::evictEntry(InMemoryStorageEntry* entry)
+{
+  beforeErase(entry);
+  eraseImpl(entry->getFullName());
+  return true;
+}
+
+void
+InMemoryStorageTinyLfu::afterInsert(InMemoryStorageEntry* entry)
+{
+  // the sketch grows with the storage, up to its limit; sizing it for twice as many packets
+  // keeps a new packet from often sharing all its counters with a popular one
+  m_sketch.ensureCapacity(std::min(2 * size(), getLimit()));
+  m_sketch.increment(getHash(entry));
+
+  m_window.push_back(entry);
+  m_positions[entry] = {WINDOW, std::prev(m_window.end())};
+
+  // the window holds 1% of the packets; overflow is moved to the main area while it has room,
+  // and subjected to admission by evictItem() once the storage is full
+  size_t windowCapacity = std::max<size_t>(1, size() / 100);
+  while (m_window.size() > windowCapacity) {
+    moveTo(m_window.front(), PROBATION);
+  }
+}
+
+bool
+InMemoryStorageTinyLfu::evictItem()
+{
+  Queue* mainQueue = !m_probation.empty() ? &m_probation :
+                     !m_protected.empty() ? &m_protected : nullptr;
+
+  InMemoryStorageEntry* victim = nullptr;
+  if (m_window.empty()) {
+    if (mainQueue == nullptr) {
+      return false;
+    }
+    victim = mainQueue->front();
+  }
+  else if (mainQueue == nullptr) {
+    victim = m_window.front();
+  }
+  else {
+    InMemoryStorageEntry* candidate = m_window.front();
+    victim = mainQueue->front();
+    if (m_sketch.estimate(getHash(candidate)) > m_sketch.estimate(getHash(victim))) {
+      moveTo(candidate, PROBATION);
+    }
+    else {
+      victim = candidate;
+    }
+  }
+
+  evictEntry(victim);
+  return true;
+}
+
+void
+InMemoryStorageTinyLfu::afterAccess(InMemoryStorageEntry* entry)
+{
+  m_sketch.increment(getHash(entry));
+
+  Segment segment = m_positions.at(entry).segment;
+  if (segment == WINDOW) {
+    moveTo(entry, WINDOW);
+    return;
+  }
+
+  moveTo(entry, PROTECTED);
+
+  // the protected segment holds up to 80% of the main area
+  size_t protectedCapacity = std::max<size_t>(1, (m_probation.size() + m_protected.size()) * 4 / 5);
+  while (m_protected.size() > protectedCapacity) {
+    moveTo(m_protected.front(), PROBATION);
+  }
+}
+
+void
+InMemoryStorageTinyLfu::beforeErase(InMemoryStorageEntry* entry)
+{
+  auto pos = m_positions.find(entry);
+  if (pos == m_positions.end()) {
+    return;
+  }
+
+  getQueue(pos->second.segment).erase(pos->second.it);
+  m_positions.erase(pos);
+}
+
+} // namespace ndn
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
+#define NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/** @brief Provides in-memory storage employing Window TinyLFU (W-TinyLFU) replacement policy.
+ *
+ *  New packets enter a small LRU window.  A packet leaving the window is admitted into the main
+ *  area only if it has been requested more often than the packet the main area would evict;
+ *  otherwise, the packet leaving the window is evicted.  The main area is a segmented LRU with
+ *  a probation segment and a protected segment, which holds packets found at least twice.
+ *
+ *  Request frequencies are estimated with a count-min sketch, which also remembers packets that
+ *  have been evicted.  Its counters are halved periodically, so that old requests fade out.
+ *  A burst of packets that are requested once, such as a long sequence of segments fetched by a
+ *  bulk consumer, passes through the window without evicting popular packets.
+ *
+ *  @sa Gil Einziger, Roy Friedman, Ben Manes, "TinyLFU: A Highly Efficient Cache Admission
+ *      Policy", ACM Transactions on Storage 13(4), 2017
+ */
+class InMemoryStorageTinyLfu : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageTinyLfu(size_t limit = 10);
+
+  explicit
+  InMemoryStorageTinyLfu(boost::asio::io_service& ioService, size_t limit = 10);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on W-TinyLFU, i.e. evict the
+   *  least recently used packet of the window, unless it is requested more often than the
+   *  least recently used packet of the main area
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictItem() override;
+
+  /** @brief Removes @p entry from in-memory storage; entries under a prefix quota are evicted
+   *  from the window before the main area, least recently used first
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictEntry(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  count the request and promote the entry within its segment
+   */
+  void
+  afterAccess(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry after a entry is successfully inserted,
+   *  count the request and add the entry to the window
+   */
+  void
+  afterInsert(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  remove it from its segment
+   */
+  void
+  beforeErase(InMemoryStorageEntry* entry) override;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @brief Count-min sketch of 4-bit counters that estimates request frequencies
+   */
+  class FrequencySketch
+  {
+  public:
+    /** @brief Size the sketch for @p nItems distinct items
+     *
+     *  The sketch only grows, and keeps the estimates of counted items when it does.
+     */
+    void
+    ensureCapacity(size_t nItems);
+
+    /** @brief Count a request for the item with @p hash
+     *
+     *  After a number of requests proportional to the capacity, all counters are halved.
+     */
+    void
+    increment(size_t hash);
+
+    /** @return{ estimated number of requests for the item with @p hash, at most 15 }
+     */
+    uint8_t
+    estimate(size_t hash) const;
+
+  private:
+    size_t
+    getIndex(size_t hash, size_t row) const;
+
+    uint8_t
+    getCounter(size_t index) const;
+
+    void
+    halve();
+
+  public:
+    static constexpr size_t N_ROWS = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+  private:
+    std::vector<uint64_t> m_table; ///< each word holds 16 counters
+    size_t m_nCounters = 0;
+    size_t m_nIncrements = 0;
+    size_t m_sampleSize = 0;
+  };
+
+  enum Segment {
+    WINDOW,
+    PROBATION,
+    PROTECTED
+  };
+
+private:
+  using Queue = std::list<InMemoryStorageEntry*>;
+
+  struct Position
+  {
+    Segment segment;
+    Queue::iterator it;
+  };
+
+  static size_t
+  getHash(const InMemoryStorageEntry* entry);
+
+  Queue&
+  getQueue(Segment segment);
+
+  /** @brief move @p entry to the most recently used end of @p segment
+   */
+  void
+  moveTo(InMemoryStorageEntry* entry, Segment segment);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// least recently used entries are at the front of each queue
+  Queue m_window;
+  Queue m_probation;
+  Queue m_protected;
+  std::unordered_map<InMemoryStorageEntry*, Position> m_positions;
+  FrequencySketch m_sketch;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
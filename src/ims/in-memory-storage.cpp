@@ -84,15 +84,24 @@ InMemoryStorage::const_iterator::operator!=(const const_iterator& rhs)
 InMemoryStorage::InMemoryStorage(size_t limit)
   : m_limit(limit)
   , m_nPackets(0)
+  , m_byteLimit(std::numeric_limits<size_t>::max())
+  , m_nBytes(0)
+  , m_nPrefixQuotas(0)
+  , m_quotaOrderSeq(0)
+  , m_isFreshnessTracked(false)
 {
   init();
 }
 
-InMemoryStorage::InMemoryStorage(boost::asio::io_service& ioService, size_t limit)
+InMemoryStorage::InMemoryStorage(boost::asio::io_service&, size_t limit)
   : m_limit(limit)
   , m_nPackets(0)
+  , m_byteLimit(std::numeric_limits<size_t>::max())
+  , m_nBytes(0)
+  , m_nPrefixQuotas(0)
+  , m_quotaOrderSeq(0)
+  , m_isFreshnessTracked(true)
 {
-  m_scheduler = make_unique<Scheduler>(ioService);
   init();
 }
 
@@ -157,13 +166,32 @@ InMemoryStorage::setCapacity(size_t capacity)
   BOOST_ASSERT(size() + m_freeEntries.size() == m_capacity);
 }
 
-void
+bool
 InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshProcessingWindow)
 {
   // check if identical Data/Name already exists
   auto it = m_cache.get<byFullName>().find(data.getFullName());
   if (it != m_cache.get<byFullName>().end())
-    return;
+    return true;
+
+  // make room within the prefix quota and the byte limit
+  size_t wireSize = data.wireEncode().size();
+  InMemoryStoragePrefixQuota* quota = findPrefixQuota(data.getName());
+  if (wireSize > m_byteLimit || (quota != nullptr && wireSize > quota->nMaxBytes)) {
+    return false;
+  }
+  if (quota != nullptr) {
+    while (quota->nBytes + wireSize > quota->nMaxBytes) {
+      if (!evictUnderQuota(*quota)) {
+        return false;
+      }
+    }
+  }
+  while (m_nBytes + wireSize > m_byteLimit) {
+    if (!evictItem()) {
+      return false;
+    }
+  }
 
   //if full, double the capacity
   bool doesReachLimit = (getLimit() == getCapacity());
@@ -174,8 +202,8 @@ InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshP
   }
 
   //if full and reach limitation of the capacity, employ replacement policy
-  if (isFull() && doesReachLimit) {
-    evictItem();
+  if (isFull() && doesReachLimit && !evictItem()) {
+    return false;
   }
 
   //insert to cache
@@ -185,15 +213,18 @@ InMemoryStorage::insert(const Data& data, const time::milliseconds& mustBeFreshP
   m_freeEntries.pop();
   m_nPackets++;
   entry->setData(data);
-  if (m_scheduler != nullptr && mustBeFreshProcessingWindow > ZERO_WINDOW) {
-    auto eventId = make_unique<util::scheduler::ScopedEventId>(*m_scheduler);
-    *eventId = m_scheduler->scheduleEvent(mustBeFreshProcessingWindow, [entry] { entry->markStale(); });
-    entry->setMarkStaleEventId(std::move(eventId));
+  m_nBytes += wireSize;
+  entry->m_quotaOrder = {0, ++m_quotaOrderSeq};
+  setEntryQuota(entry, quota);
+  if (m_isFreshnessTracked && mustBeFreshProcessingWindow > ZERO_WINDOW) {
+    entry->setStaleTime(time::steady_clock::now() + mustBeFreshProcessingWindow);
   }
   m_cache.insert(entry);
+  m_nameTree.insert(entry);
 
   //let derived class do something with the entry
   afterInsert(entry);
+  return true;
 }
 
 shared_ptr<const Data>
@@ -218,6 +249,8 @@ InMemoryStorage::find(const Name& name)
 shared_ptr<const Data>
 InMemoryStorage::find(const Interest& interest)
 {
+  markStaleEntries();
+
   // if the interest contains implicit digest, it is possible to directly locate a packet.
   auto it = m_cache.get<byFullName>().find(interest.getName());
 
@@ -228,18 +261,7 @@ InMemoryStorage::find(const Interest& interest)
 
   // if the packet is not discovered by last step, either the packet is not in the storage or
   // the interest doesn't contains implicit digest.
-  it = m_cache.get<byFullName>().lower_bound(interest.getName());
-
-  if (it == m_cache.get<byFullName>().end()) {
-    return nullptr;
-  }
-
-  // to locate the element that has a just smaller name than the interest's
-  if (it != m_cache.get<byFullName>().begin()) {
-    it--;
-  }
-
-  InMemoryStorageEntry* ret = selectChild(interest, it);
+  InMemoryStorageEntry* ret = m_nameTree.find(interest);
   if (ret == nullptr) {
     return nullptr;
   }
@@ -249,102 +271,15 @@ InMemoryStorage::find(const Interest& interest)
   return ret->getData().shared_from_this();
 }
 
-InMemoryStorage::Cache::index<InMemoryStorage::byFullName>::type::iterator
-InMemoryStorage::findNextFresh(Cache::index<byFullName>::type::iterator it) const
-{
-  for (; it != m_cache.get<byFullName>().end(); it++) {
-    if ((*it)->isFresh())
-      return it;
-  }
-
-  return it;
-}
-
-InMemoryStorageEntry*
-InMemoryStorage::selectChild(const Interest& interest,
-                             Cache::index<byFullName>::type::iterator startingPoint) const
-{
-  BOOST_ASSERT(startingPoint != m_cache.get<byFullName>().end());
-
-  if (startingPoint != m_cache.get<byFullName>().begin()) {
-    BOOST_ASSERT((*startingPoint)->getFullName() < interest.getName());
-  }
-
-  bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
-  bool hasRightmostSelector = !hasLeftmostSelector;
-
-  // filter out "stale" data
-  if (interest.getMustBeFresh()) {
-    startingPoint = findNextFresh(startingPoint);
-  }
-
-  if (startingPoint == m_cache.get<byFullName>().end()) {
-    return nullptr;
-  }
-
-  if (hasLeftmostSelector) {
-    if (interest.matchesData((*startingPoint)->getData())) {
-      return *startingPoint;
-    }
-  }
-
-  // iterate to the right
-  auto rightmost = startingPoint;
-  if (startingPoint != m_cache.get<byFullName>().end()) {
-    auto rightmostCandidate = startingPoint;
-    Name currentChildPrefix("");
-
-    while (true) {
-      ++rightmostCandidate;
-      // filter out "stale" data
-      if (interest.getMustBeFresh()) {
-        rightmostCandidate = findNextFresh(rightmostCandidate);
-      }
-
-      bool isInBoundaries = (rightmostCandidate != m_cache.get<byFullName>().end());
-      bool isInPrefix = false;
-      if (isInBoundaries) {
-        isInPrefix = interest.getName().isPrefixOf((*rightmostCandidate)->getFullName());
-      }
-
-      if (isInPrefix) {
-        if (interest.matchesData((*rightmostCandidate)->getData())) {
-          if (hasLeftmostSelector) {
-            return *rightmostCandidate;
-          }
-
-          if (hasRightmostSelector) {
-            // get prefix which is one component longer than Interest name
-            const Name& childPrefix = (*rightmostCandidate)->getFullName().getPrefix(interest.getName().size() + 1);
-            if (currentChildPrefix.empty() || (childPrefix != currentChildPrefix)) {
-              currentChildPrefix = childPrefix;
-              rightmost = rightmostCandidate;
-            }
-          }
-        }
-      }
-      else {
-        break;
-      }
-    }
-  }
-
-  if (rightmost != startingPoint) {
-    return *rightmost;
-  }
-
-  if (hasRightmostSelector) { // if rightmost was not found, try starting point
-    if (interest.matchesData((*startingPoint)->getData())) {
-      return *startingPoint;
-    }
-  }
-
-  return nullptr;
-}
-
 InMemoryStorage::Cache::iterator
 InMemoryStorage::freeEntry(Cache::iterator it)
 {
+  m_nameTree.erase(*it);
+
+  size_t wireSize = (*it)->getWireSize();
+  m_nBytes -= wireSize;
+  setEntryQuota(*it, nullptr);
+
   // push the *empty* entry into mem pool
   (*it)->release();
   m_freeEntries.push(*it);
@@ -387,6 +322,171 @@ InMemoryStorage::eraseImpl(const Name& name)
   freeEntry(it);
 }
 
+void
+InMemoryStorage::setByteLimit(size_t nMaxBytes)
+{
+  m_byteLimit = nMaxBytes;
+  while (m_nBytes > m_byteLimit && evictItem()) {
+  }
+}
+
+void
+InMemoryStorage::setPrefixQuota(const Name& prefix, size_t nMaxBytes)
+{
+  PrefixQuotaNode* node = &m_prefixQuotas;
+  for (const auto& component : prefix) {
+    auto& child = node->children[component];
+    if (child == nullptr) {
+      child = make_unique<PrefixQuotaNode>();
+    }
+    node = child.get();
+  }
+
+  if (node->quota == nullptr) {
+    node->quota = make_unique<InMemoryStoragePrefixQuota>();
+    node->quota->nBytes = 0;
+    ++m_nPrefixQuotas;
+    // packets under the prefix are moved from the quota of a shorter prefix to the new quota
+    reassignPrefixQuotas(prefix);
+  }
+
+  InMemoryStoragePrefixQuota& quota = *node->quota;
+  quota.nMaxBytes = nMaxBytes;
+  while (quota.nBytes > nMaxBytes && evictUnderQuota(quota)) {
+  }
+}
+
+void
+InMemoryStorage::unsetPrefixQuota(const Name& prefix)
+{
+  std::vector<PrefixQuotaNode*> path{&m_prefixQuotas};
+  for (const auto& component : prefix) {
+    auto child = path.back()->children.find(component);
+    if (child == path.back()->children.end()) {
+      return;
+    }
+    path.push_back(child->second.get());
+  }
+
+  if (path.back()->quota == nullptr) {
+    return;
+  }
+
+  // keep the quota alive until its packets are moved to the quota of a shorter prefix
+  unique_ptr<InMemoryStoragePrefixQuota> oldQuota = std::move(path.back()->quota);
+  --m_nPrefixQuotas;
+  reassignPrefixQuotas(prefix);
+  BOOST_ASSERT(oldQuota->entries.empty());
+
+  // prune nodes that no longer lead to a quota
+  for (size_t i = prefix.size();
+       i > 0 && path[i]->quota == nullptr && path[i]->children.empty(); --i) {
+    path[i - 1]->children.erase(prefix[i - 1]);
+  }
+
+  InMemoryStoragePrefixQuota* parent = findPrefixQuota(prefix);
+  if (parent != nullptr) {
+    while (parent->nBytes > parent->nMaxBytes && evictUnderQuota(*parent)) {
+    }
+  }
+}
+
+size_t
+InMemoryStorage::getPrefixQuotaUsage(const Name& prefix) const
+{
+  const PrefixQuotaNode* node = &m_prefixQuotas;
+  for (const auto& component : prefix) {
+    auto child = node->children.find(component);
+    if (child == node->children.end()) {
+      return 0;
+    }
+    node = child->second.get();
+  }
+  return node->quota == nullptr ? 0 : node->quota->nBytes;
+}
+
+InMemoryStoragePrefixQuota*
+InMemoryStorage::findPrefixQuota(const Name& name) const
+{
+  // longest prefix match
+  const PrefixQuotaNode* node = &m_prefixQuotas;
+  InMemoryStoragePrefixQuota* quota = node->quota.get();
+  for (size_t i = 0; m_nPrefixQuotas > 0 && i < name.size(); ++i) {
+    auto child = node->children.find(name[i]);
+    if (child == node->children.end()) {
+      break;
+    }
+    node = child->second.get();
+    if (node->quota != nullptr) {
+      quota = node->quota.get();
+    }
+  }
+  return quota;
+}
+
+void
+InMemoryStorage::setEntryQuota(InMemoryStorageEntry* entry, InMemoryStoragePrefixQuota* quota)
+{
+  if (entry->m_quota == quota) {
+    return;
+  }
+
+  if (entry->m_quota != nullptr) {
+    entry->m_quota->nBytes -= entry->getWireSize();
+    entry->m_quota->entries.erase(entry);
+  }
+  entry->m_quota = quota;
+  if (quota != nullptr) {
+    quota->nBytes += entry->getWireSize();
+    quota->entries.insert(entry);
+  }
+}
+
+void
+InMemoryStorage::reassignPrefixQuotas(const Name& prefix)
+{
+  auto it = m_cache.get<byFullName>().lower_bound(prefix);
+  for (; it != m_cache.get<byFullName>().end() && prefix.isPrefixOf((*it)->getName()); ++it) {
+    setEntryQuota(*it, findPrefixQuota((*it)->getName()));
+  }
+}
+
+bool
+InMemoryStorage::evictUnderQuota(InMemoryStoragePrefixQuota& quota)
+{
+  if (quota.entries.empty()) {
+    return false;
+  }
+  return evictEntry(*quota.entries.begin());
+}
+
+void
+InMemoryStorage::updateQuotaOrder(InMemoryStorageEntry* entry, uint64_t group)
+{
+  InMemoryStoragePrefixQuota* quota = entry->m_quota;
+  if (quota != nullptr) {
+    quota->entries.erase(entry);
+  }
+  entry->m_quotaOrder = {group, ++m_quotaOrderSeq};
+  if (quota != nullptr) {
+    quota->entries.insert(entry);
+  }
+}
+
+void
+InMemoryStorage::markStaleEntries()
+{
+  // markStale() resets the stale time, which moves the entry to the end of the index
+  auto& index = m_cache.get<byStaleTime>();
+  auto now = time::steady_clock::now();
+  while (!index.empty() && (*index.begin())->getStaleTime() <= now) {
+    index.modify(index.begin(), [this] (InMemoryStorageEntry* entry) {
+      m_nameTree.beforeMarkStale(entry);
+      entry->markStale();
+    });
+  }
+}
+
 InMemoryStorage::const_iterator
 InMemoryStorage::begin() const
 {
@@ -416,6 +516,12 @@ InMemoryStorage::afterAccess(InMemoryStorageEntry* entry)
 {
 }
 
+bool
+InMemoryStorage::evictEntry(InMemoryStorageEntry* entry)
+{
+  return false;
+}
+
 void
 InMemoryStorage::printCache(std::ostream& os) const
 {
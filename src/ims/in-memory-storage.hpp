@@ -23,8 +23,12 @@
 #define NDN_IMS_IN_MEMORY_STORAGE_HPP
 
 #include "in-memory-storage-entry.hpp"
+#include "in-memory-storage-name-tree.hpp"
+#include "../net/asio-fwd.hpp"
 
 #include <iterator>
+#include <map>
+#include <set>
 #include <stack>
 
 #include <boost/multi_index_container.hpp>
@@ -36,13 +40,38 @@
 
 namespace ndn {
 
+/** @brief Byte quota of a name prefix in InMemoryStorage
+ *  @sa InMemoryStorage::setPrefixQuota
+ */
+struct InMemoryStoragePrefixQuota
+{
+  struct EvictionOrder
+  {
+    bool
+    operator()(const InMemoryStorageEntry* a, const InMemoryStorageEntry* b) const
+    {
+      return a->m_quotaOrder < b->m_quotaOrder;
+    }
+  };
+
+  size_t nMaxBytes;
+  size_t nBytes;
+  /// entries counted against the quota, in the order in which they are evicted
+  std::set<InMemoryStorageEntry*, EvictionOrder> entries;
+};
+
 /** @brief Represents in-memory storage
+ *
+ *  When MustBeFresh is handled, an entry becomes stale once its MustBeFresh processing window
+ *  has elapsed.  Staleness is updated only inside find(const Interest&), so that no timer is
+ *  needed; other member functions, and iteration, may still see such an entry as fresh.
  */
 class InMemoryStorage : noncopyable
 {
 public:
   // multi_index_container to implement storage
   class byFullName;
+  class byStaleTime;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
@@ -54,6 +83,13 @@ public:
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
                                           &InMemoryStorageEntry::getFullName>,
         std::less<Name>
+      >,
+
+      // by time when the entry should be marked stale
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byStaleTime>,
+        boost::multi_index::const_mem_fun<InMemoryStorageEntry, time::steady_clock::TimePoint,
+                                          &InMemoryStorageEntry::getStaleTime>
       >
 
     >
@@ -119,6 +155,11 @@ public:
 
   /** @brief Create a InMemoryStorage with up to @p limit entries
    *  The InMemoryStorage created through this method will handle MustBeFresh in interest processing
+   *
+   *  @param ioService ignored; passing it only selects MustBeFresh handling, and it is kept
+   *                   for compatibility.  No timer is scheduled, because entries are marked
+   *                   stale by find(const Interest&).
+   *  @param limit maximum number of entries
    */
   explicit
   InMemoryStorage(boost::asio::io_service& ioService,
@@ -141,8 +182,13 @@ public:
    *  will be placed in the in-memory storage.
    *
    *  @note It will invoke afterInsert(shared_ptr<InMemoryStorageEntry>).
+   *
+   *  @return whether @p data is stored; false if it was rejected because it exceeds the byte
+   *          limit or the quota of its prefix, or the replacement policy could not evict enough
+   *          packets to make room for it.  A policy that never evicts, such as
+   *          InMemoryStoragePersistent, rejects every packet that does not fit.
    */
-  void
+  bool
   insert(const Data& data, const time::milliseconds& mustBeFreshProcessingWindow = INFINITE_WINDOW);
 
   /** @brief Finds the best match Data for an Interest
@@ -201,6 +247,56 @@ public:
     return m_nPackets;
   }
 
+  /** @brief Limits the total wire size of packets in in-memory storage
+   *
+   *  Packets are evicted according to the replacement policy until the total wire size is
+   *  within @p nMaxBytes.  When a packet is inserted, other packets are evicted to make room
+   *  for it; if the replacement policy cannot evict enough packets, or the packet alone
+   *  exceeds the limit, the packet is not inserted.  The packet count limit still applies.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** @return{ maximum total wire size of packets in in-memory storage }
+   */
+  size_t
+  getByteLimit() const
+  {
+    return m_byteLimit;
+  }
+
+  /** @return{ total wire size of packets stored in in-memory storage }
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /** @brief Limits the total wire size of packets under @p prefix
+   *
+   *  A packet is counted against the quota of the longest prefix of its name that has a
+   *  quota.  When a packet is inserted into a namespace that has reached its quota, packets
+   *  in the same namespace are evicted according to the replacement policy, so that a busy
+   *  namespace cannot evict packets of other namespaces beyond its quota.  Otherwise, the
+   *  quota behaves like setByteLimit().
+   */
+  void
+  setPrefixQuota(const Name& prefix, size_t nMaxBytes);
+
+  /** @brief Removes the quota of @p prefix
+   *
+   *  Packets under @p prefix are counted against the quota of a shorter prefix, if any.
+   */
+  void
+  unsetPrefixQuota(const Name& prefix);
+
+  /** @return{ total wire size of packets counted against the quota of @p prefix, or zero if
+   *           @p prefix has no quota }
+   */
+  size_t
+  getPrefixQuotaUsage(const Name& prefix) const;
+
   /** @brief Returns begin iterator of the in-memory storage ordering by
    *  name with digest
    *
@@ -248,6 +344,19 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   virtual bool
   evictItem() = 0;
 
+  /** @brief Removes @p entry from in-memory storage to enforce the prefix quota it is
+   *  counted against
+   *  @return whether the Data packet was removed
+   *
+   *  The entry is the first one in the eviction order of its quota; see updateQuotaOrder().
+   *  The default implementation removes nothing.
+   *
+   *  @warning Please do not use this function directly in any derived class to erase
+   *  an entry from the cache, use eraseImpl() instead.
+   */
+  virtual bool
+  evictEntry(InMemoryStorageEntry* entry);
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   /** @brief sets current capacity of in-memory storage (in packets)
    */
@@ -280,6 +389,17 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   void
   eraseImpl(const Name& name);
 
+  /** @brief Moves @p entry behind all other entries of @p group in the eviction order of
+   *  the prefix quota it is counted against
+   *
+   *  Within a prefix quota, entries of a lower group are evicted first, and entries of the
+   *  same group in the order of their last update.  An entry is placed last in group 0 when
+   *  it is inserted.  A derived class calls this whenever its replacement policy reorders an
+   *  entry, so that enforcing a prefix quota does not search the whole cleanup index.
+   */
+  void
+  updateQuotaOrder(InMemoryStorageEntry* entry, uint64_t group = 0);
+
   /** @brief Prints contents of the in-memory storage
    */
   void
@@ -292,36 +412,44 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Cache::iterator
   freeEntry(Cache::iterator it);
 
-  /** @brief Implements child selector (leftmost, rightmost, undeclared).
-   *  Operates on the first layer of a skip list.
-   *
-   *  startingPoint must be less than Interest Name.
-   *  startingPoint can be equal to Interest Name only
-   *  when the item is in the begin() position.
-   *
-   *  Iterates toward greater Names, terminates when application cache entry falls out of Interest
-   *  prefix. When childSelector = leftmost, returns first application cache entry that satisfies
-   *  other selectors. When childSelector = rightmost, it goes till the end, and returns application
-   *  cache entry that satisfies other selectors. Returned application cache entry is the leftmost
-   *  child of the rightmost child.
-   *  @return{ the best match, if any; otherwise 0 }
-   */
-  InMemoryStorageEntry*
-  selectChild(const Interest& interest,
-              Cache::index<byFullName>::type::iterator startingPoint) const;
-
-  /** @brief Get the next iterator (include startingPoint) that satisfies MustBeFresh requirement
-   *
-   *  @param startingPoint The iterator to start with.
-   *  @return The next qualified iterator
-   */
-  Cache::index<byFullName>::type::iterator
-  findNextFresh(Cache::index<byFullName>::type::iterator startingPoint) const;
-
 private:
   void
   init();
 
+  /** @brief a node of the name prefix tree that holds prefix quotas
+   */
+  struct PrefixQuotaNode
+  {
+    std::map<name::Component, unique_ptr<PrefixQuotaNode>> children;
+    unique_ptr<InMemoryStoragePrefixQuota> quota;
+  };
+
+  /** @return the quota of the longest prefix of @p name that has a quota, or nullptr
+   */
+  InMemoryStoragePrefixQuota*
+  findPrefixQuota(const Name& name) const;
+
+  /** @brief count @p entry against @p quota instead of its current quota
+   *  @param quota the new quota, or nullptr
+   */
+  void
+  setEntryQuota(InMemoryStorageEntry* entry, InMemoryStoragePrefixQuota* quota);
+
+  /** @brief count every entry under @p prefix against the quota of its longest prefix
+   */
+  void
+  reassignPrefixQuotas(const Name& prefix);
+
+  /** @brief evict the first entry in the eviction order of @p quota
+   */
+  bool
+  evictUnderQuota(InMemoryStoragePrefixQuota& quota);
+
+  /** @brief mark stale every entry whose MustBeFresh processing window has elapsed
+   */
+  void
+  markStaleEntries();
+
 public:
   static const time::milliseconds INFINITE_WINDOW;
 
@@ -329,17 +457,31 @@ private:
   static const time::milliseconds ZERO_WINDOW;
 
 private:
+  friend class ConcurrentInMemoryStorage; // evicts packets with evictItem()
+
   Cache m_cache;
+  /// name tree index for Interest lookup
+  InMemoryStorageNameTree m_nameTree;
   /// user defined maximum capacity of the in-memory storage in packets
   size_t m_limit;
   /// current capacity of the in-memory storage in packets
   size_t m_capacity;
   /// current number of packets in in-memory storage
   size_t m_nPackets;
+  /// user defined maximum total wire size of packets
+  size_t m_byteLimit;
+  /// current total wire size of packets
+  size_t m_nBytes;
+  /// per-prefix limits of total wire size
+  PrefixQuotaNode m_prefixQuotas;
+  /// number of prefixes with a quota
+  size_t m_nPrefixQuotas;
+  /// last sequence number used by updateQuotaOrder
+  uint64_t m_quotaOrderSeq;
   /// memory pool
   std::stack<InMemoryStorageEntry*> m_freeEntries;
-  /// scheduler
-  unique_ptr<Scheduler> m_scheduler;
+  /// whether entries are marked stale after their MustBeFresh processing window
+  bool m_isFreshnessTracked;
 };
 
 } // namespace ndn
@@ -47,6 +47,7 @@ Interest::Interest(const Name& name, time::milliseconds lifetime)
   : m_name(name)
   , m_isCanBePrefixSet(false)
   , m_interestLifetime(lifetime)
+  , m_lazyFields(LazyFields::NONE)
 {
   if (lifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
@@ -59,6 +60,7 @@ Interest::Interest(const Name& name, time::milliseconds lifetime)
 
 Interest::Interest(const Block& wire)
   : m_isCanBePrefixSet(true)
+  , m_lazyFields(LazyFields::NONE)
 {
   wireDecode(wire);
 }
@@ -83,6 +85,8 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
 #endif // NDN_CXX_HAVE_TESTS
   }
 
+  requireDecodedForwardingHint();
+
   size_t totalLength = 0;
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
@@ -145,16 +149,29 @@ Interest::wireEncode() const
 
 void
 Interest::wireDecode(const Block& wire)
+{
+  decode(wire, false);
+}
+
+void
+Interest::wireDecodeLazy(const Block& wire)
+{
+  decode(wire, true);
+}
+
+void
+Interest::decode(const Block& wire, bool isLazy)
 {
   m_wire = wire;
   m_wire.parse();
+  m_lazyFields = LazyFields::NONE;
 
   if (m_wire.type() != tlv::Interest) {
     BOOST_THROW_EXCEPTION(Error("expecting Interest element, got " + to_string(m_wire.type())));
   }
 
-  if (!decode02()) {
-    decode03();
+  if (!decode02(isLazy)) {
+    decode03(isLazy);
     if (!hasNonce()) {
       setNonce(getNonce());
     }
@@ -164,9 +181,10 @@ Interest::wireDecode(const Block& wire)
 }
 
 bool
-Interest::decode02()
+Interest::decode02(bool isLazy)
 {
   auto ele = m_wire.elements_begin();
+  bool hasLazyFields = false;
 
   // Name
   if (ele != m_wire.elements_end() && ele->type() == tlv::Name) {
@@ -179,7 +197,13 @@ Interest::decode02()
 
   // Selectors?
   if (ele != m_wire.elements_end() && ele->type() == tlv::Selectors) {
-    m_selectors.wireDecode(*ele);
+    if (isLazy) {
+      m_selectors = Selectors();
+      hasLazyFields = true;
+    }
+    else {
+      m_selectors.wireDecode(*ele);
+    }
     ++ele;
   }
   else {
@@ -211,18 +235,31 @@ Interest::decode02()
 
   // ForwardingHint?
   if (ele != m_wire.elements_end() && ele->type() == tlv::ForwardingHint) {
-    m_forwardingHint.wireDecode(*ele, false);
+    if (isLazy) {
+      m_forwardingHint = DelegationList();
+      hasLazyFields = true;
+    }
+    else {
+      m_forwardingHint.wireDecode(*ele, false);
+    }
     ++ele;
   }
   else {
     m_forwardingHint = DelegationList();
   }
 
-  return ele == m_wire.elements_end();
+  if (ele != m_wire.elements_end()) {
+    return false;
+  }
+
+  if (hasLazyFields) {
+    m_lazyFields = LazyFields::V02;
+  }
+  return true;
 }
 
 void
-Interest::decode03()
+Interest::decode03(bool isLazy)
 {
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -239,6 +276,7 @@ Interest::decode03()
   m_nonce.reset();
   m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
   m_forwardingHint = DelegationList();
+  bool hasLazyFields = false;
 
   int lastEle = 0; // last recognized element index, in spec order
   for (const Block& ele : m_wire.elements()) {
@@ -281,7 +319,12 @@ Interest::decode03()
         if (lastEle >= 4) {
           BOOST_THROW_EXCEPTION(Error("ForwardingHint element is out of order"));
         }
-        m_forwardingHint.wireDecode(ele);
+        if (isLazy) {
+          hasLazyFields = true;
+        }
+        else {
+          m_forwardingHint.wireDecode(ele);
+        }
         lastEle = 4;
         break;
       }
@@ -338,6 +381,35 @@ Interest::decode03()
   if (!hasName) {
     BOOST_THROW_EXCEPTION(Error("Name element is missing"));
   }
+
+  if (hasLazyFields) {
+    m_lazyFields = LazyFields::V03;
+  }
+}
+
+void
+Interest::decodeLazyFieldsFromWire()
+{
+  BOOST_ASSERT(m_lazyFields != LazyFields::NONE && m_wire.hasWire());
+
+  // element order has been checked in decode02() or decode03()
+  bool isV02 = m_lazyFields == LazyFields::V02;
+  Selectors selectors = m_selectors;
+  DelegationList forwardingHint;
+  for (const Block& ele : m_wire.elements()) {
+    switch (ele.type()) {
+      case tlv::Selectors:
+        selectors.wireDecode(ele);
+        break;
+      case tlv::ForwardingHint:
+        forwardingHint.wireDecode(ele, !isV02);
+        break;
+    }
+  }
+
+  m_selectors = std::move(selectors);
+  m_forwardingHint = std::move(forwardingHint);
+  m_lazyFields = LazyFields::NONE;
 }
 
 std::string
@@ -483,8 +555,8 @@ Interest::getNonce() const
 Interest&
 Interest::setNonce(uint32_t nonce)
 {
+  resetWire();
   m_nonce = nonce;
-  m_wire.reset();
   return *this;
 }
 
@@ -508,16 +580,16 @@ Interest::setInterestLifetime(time::milliseconds lifetime)
   if (lifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
   }
+  resetWire();
   m_interestLifetime = lifetime;
-  m_wire.reset();
   return *this;
 }
 
 Interest&
 Interest::setForwardingHint(const DelegationList& value)
 {
+  resetWire();
   m_forwardingHint = value;
-  m_wire.reset();
   return *this;
 }
 
@@ -26,6 +26,7 @@
 #include "name.hpp"
 #include "packet-base.hpp"
 #include "selectors.hpp"
+#include "util/random.hpp"
 #include "util/time.hpp"
 #include <boost/logic/tribool.hpp>
 
@@ -88,6 +89,41 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /** @brief Decode from @p wire, deferring the decoding of Selectors and ForwardingHint.
+   *
+   *  Name, Nonce, InterestLifetime, CanBePrefix, and MustBeFresh (in v0.3 format) are decoded
+   *  immediately, and the presence and order of all elements are checked as in wireDecode().
+   *  Selectors (in v0.2 format) and ForwardingHint are left for decodeLazyFields().
+   *
+   *  Until decodeLazyFields() is called, getters of the deferred fields throw Error, while
+   *  setters call it implicitly. Const member functions never decode, so that an Interest
+   *  shared between threads through a pointer to const is never modified by them.
+   *
+   *  @throw Error the Interest element is malformed
+   */
+  void
+  wireDecodeLazy(const Block& wire);
+
+  /** @brief Decode Selectors and ForwardingHint, if their decoding was deferred by
+   *         wireDecodeLazy()
+   *  @throw tlv::Error Selectors or ForwardingHint is malformed
+   */
+  void
+  decodeLazyFields()
+  {
+    if (m_lazyFields != LazyFields::NONE) {
+      decodeLazyFieldsFromWire();
+    }
+  }
+
+  /** @brief Check if Selectors or ForwardingHint are yet to be decoded by decodeLazyFields()
+   */
+  bool
+  hasLazyFields() const
+  {
+    return m_lazyFields != LazyFields::NONE;
+  }
+
   /** @brief Check if this instance has cached wire encoding.
    */
   bool
@@ -143,8 +179,8 @@ public: // element access
   Interest&
   setName(const Name& name)
   {
+    resetWire();
     m_name = name;
-    m_wire.reset();
     return *this;
   }
 
@@ -177,6 +213,7 @@ public: // element access
   bool
   getCanBePrefix() const
   {
+    requireDecodedSelectors();
     return m_selectors.getMaxSuffixComponents() != 1;
   }
 
@@ -190,8 +227,8 @@ public: // element access
   Interest&
   setCanBePrefix(bool canBePrefix)
   {
+    resetWire();
     m_selectors.setMaxSuffixComponents(canBePrefix ? -1 : 1);
-    m_wire.reset();
     m_isCanBePrefixSet = true;
     return *this;
   }
@@ -205,6 +242,7 @@ public: // element access
   bool
   getMustBeFresh() const
   {
+    requireDecodedSelectors();
     return m_selectors.getMustBeFresh();
   }
 
@@ -218,14 +256,15 @@ public: // element access
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
+    resetWire();
     m_selectors.setMustBeFresh(mustBeFresh);
-    m_wire.reset();
     return *this;
   }
 
   const DelegationList&
   getForwardingHint() const
   {
+    requireDecodedForwardingHint();
     return m_forwardingHint;
   }
 
@@ -246,8 +285,8 @@ public: // element access
   Interest&
   modifyForwardingHint(const Modifier& modifier)
   {
+    resetWire();
     modifier(m_forwardingHint);
-    m_wire.reset();
     return *this;
   }
 
@@ -279,6 +318,17 @@ public: // element access
   void
   refreshNonce();
 
+  /** @brief Assign random nonces to a batch of Interests
+   *  @tparam Iterator a forward iterator whose value type is Interest
+   *
+   *  Every Interest in [first, last) receives a nonce that differs from its previous nonce,
+   *  if any.  Nonces are drawn from the random number engine of the calling thread, two at a
+   *  time, which is faster than invoking setNonce(random::generateWord32()) on each Interest.
+   */
+  template<typename Iterator>
+  static void
+  setRandomNonces(Iterator first, Iterator last);
+
   time::milliseconds
   getInterestLifetime() const
   {
@@ -298,6 +348,7 @@ public: // Selectors (deprecated)
   bool
   hasSelectors() const
   {
+    requireDecodedSelectors();
     return !m_selectors.empty();
   }
 
@@ -305,6 +356,7 @@ public: // Selectors (deprecated)
   const Selectors&
   getSelectors() const
   {
+    requireDecodedSelectors();
     return m_selectors;
   }
 
@@ -312,8 +364,8 @@ public: // Selectors (deprecated)
   Interest&
   setSelectors(const Selectors& selectors)
   {
+    resetWire();
     m_selectors = selectors;
-    m_wire.reset();
     return *this;
   }
 
@@ -321,6 +373,7 @@ public: // Selectors (deprecated)
   int
   getMinSuffixComponents() const
   {
+    requireDecodedSelectors();
     return m_selectors.getMinSuffixComponents();
   }
 
@@ -328,8 +381,8 @@ public: // Selectors (deprecated)
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
+    resetWire();
     m_selectors.setMinSuffixComponents(minSuffixComponents);
-    m_wire.reset();
     return *this;
   }
 
@@ -337,6 +390,7 @@ public: // Selectors (deprecated)
   int
   getMaxSuffixComponents() const
   {
+    requireDecodedSelectors();
     return m_selectors.getMaxSuffixComponents();
   }
 
@@ -344,8 +398,8 @@ public: // Selectors (deprecated)
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
+    resetWire();
     m_selectors.setMaxSuffixComponents(maxSuffixComponents);
-    m_wire.reset();
     return *this;
   }
 
@@ -353,6 +407,7 @@ public: // Selectors (deprecated)
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
+    requireDecodedSelectors();
     return m_selectors.getPublisherPublicKeyLocator();
   }
 
@@ -360,8 +415,8 @@ public: // Selectors (deprecated)
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
+    resetWire();
     m_selectors.setPublisherPublicKeyLocator(keyLocator);
-    m_wire.reset();
     return *this;
   }
 
@@ -369,6 +424,7 @@ public: // Selectors (deprecated)
   const Exclude&
   getExclude() const
   {
+    requireDecodedSelectors();
     return m_selectors.getExclude();
   }
 
@@ -376,8 +432,8 @@ public: // Selectors (deprecated)
   Interest&
   setExclude(const Exclude& exclude)
   {
+    resetWire();
     m_selectors.setExclude(exclude);
-    m_wire.reset();
     return *this;
   }
 
@@ -385,6 +441,7 @@ public: // Selectors (deprecated)
   int
   getChildSelector() const
   {
+    requireDecodedSelectors();
     return m_selectors.getChildSelector();
   }
 
@@ -392,25 +449,66 @@ public: // Selectors (deprecated)
   Interest&
   setChildSelector(int childSelector)
   {
+    resetWire();
     m_selectors.setChildSelector(childSelector);
-    m_wire.reset();
     return *this;
   }
 
 private:
+  void
+  decode(const Block& wire, bool isLazy);
+
   /** @brief Decode @c m_wire as NDN Packet Format v0.2.
+   *  @param isLazy if true, Selectors and ForwardingHint are left for decodeLazyFields()
    *  @retval true decoding successful.
    *  @retval false decoding failed due to structural error.
    *  @throw tlv::Error decoding error within a sub-element.
    */
   bool
-  decode02();
+  decode02(bool isLazy);
 
   /** @brief Decode @c m_wire as NDN Packet Format v0.3.
+   *  @param isLazy if true, ForwardingHint is left for decodeLazyFields()
    *  @throw tlv::Error decoding error.
    */
   void
-  decode03();
+  decode03(bool isLazy);
+
+  /** @throw Error Selectors are yet to be decoded by decodeLazyFields()
+   */
+  void
+  requireDecodedSelectors() const
+  {
+    if (m_lazyFields == LazyFields::V02) {
+      BOOST_THROW_EXCEPTION(Error("Selectors have not been decoded, "
+                                  "call decodeLazyFields() first"));
+    }
+  }
+
+  /** @throw Error ForwardingHint is yet to be decoded by decodeLazyFields()
+   */
+  void
+  requireDecodedForwardingHint() const
+  {
+    if (m_lazyFields != LazyFields::NONE) {
+      BOOST_THROW_EXCEPTION(Error("ForwardingHint has not been decoded, "
+                                  "call decodeLazyFields() first"));
+    }
+  }
+
+  void
+  decodeLazyFieldsFromWire();
+
+  /** @brief Clear wire encoding before a field is modified.
+   *
+   *  Deferred fields are decoded first, because the wire is their only copy.
+   */
+  void
+  resetWire()
+  {
+    decodeLazyFields();
+    m_wire.reset();
+  }
 
 #ifdef NDN_CXX_HAVE_TESTS
 public:
@@ -429,6 +527,15 @@ private:
   time::milliseconds m_interestLifetime;
   DelegationList m_forwardingHint;
 
+  /** @brief indicates which fields are yet to be decoded from m_wire
+   */
+  enum class LazyFields : uint8_t {
+    NONE, ///< all fields have been decoded
+    V02,  ///< Selectors and ForwardingHint of a v0.2 Interest
+    V03   ///< ForwardingHint of a v0.3 Interest
+  };
+  LazyFields m_lazyFields;
+
   mutable Block m_wire;
 
   friend bool operator==(const Interest& lhs, const Interest& rhs);
@@ -436,6 +543,32 @@ private:
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Interest);
 
+template<typename Iterator>
+void
+Interest::setRandomNonces(Iterator first, Iterator last)
+{
+  // every output of the engine provides two nonces
+  random::RandomNumberEngine& engine = random::getRandomNumberEngine();
+  uint64_t bits = 0;
+  bool hasSpareNonce = false;
+  for (; first != last; ++first) {
+    Interest& interest = *first;
+    uint32_t nonce = 0;
+    do {
+      if (hasSpareNonce) {
+        nonce = static_cast<uint32_t>(bits);
+        hasSpareNonce = false;
+      }
+      else {
+        bits = engine();
+        nonce = static_cast<uint32_t>(bits >> 32);
+        hasSpareNonce = true;
+      }
+    } while (interest.hasNonce() && nonce == interest.getNonce());
+    interest.setNonce(nonce);
+  }
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Interest& interest);
 
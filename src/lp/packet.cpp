@@ -64,6 +64,8 @@ public:
   bool canIgnore = false;     ///< can this unknown field be ignored
   bool isRepeatable = false;  ///< is the field repeatable
   int locationSortOrder = getLocationSortOrder<field_location_tags::Header>(); ///< sort order of field_location_tag
+  /// position in FieldSet, or the size of FieldSet if unknown
+  size_t fieldIndex = boost::mpl::size<FieldSet>::value;
 };
 
 class ExtractFieldInfo
@@ -82,6 +84,7 @@ public:
     info->canIgnore = false;
     info->isRepeatable = T::IsRepeatable::value;
     info->locationSortOrder = getLocationSortOrder<typename T::FieldLocation>();
+    info->fieldIndex = detail::FieldIndex<T>::value;
   }
 };
 
@@ -107,10 +110,12 @@ compareFieldSortOrder(const FieldInfo& first, const FieldInfo& second) noexcept
 
 Packet::Packet()
   : m_wire(Block(tlv::LpPacket))
+  , m_fieldIndex()
 {
 }
 
 Packet::Packet(const Block& wire)
+  : m_fieldIndex()
 {
   wireDecode(wire);
 }
@@ -119,10 +124,10 @@ Block
 Packet::wireEncode() const
 {
   // If no header or trailer, return bare network packet
-  Block::element_container elements = m_wire.elements();
-  if (elements.size() == 1 && elements.front().type() == FragmentField::TlvType::value) {
-    elements.front().parse();
-    return elements.front().elements().front();
+  if (m_wire.elements_size() == 1 && has<FragmentField>()) {
+    const Block& fragment = m_wire.elements().front();
+    fragment.parse();
+    return fragment.elements().front();
   }
 
   m_wire.encode();
@@ -144,8 +149,10 @@ Packet::wireDecode(const Block& wire)
 
   wire.parse();
 
+  FieldIndexTable fieldIndex{};
   bool isFirst = true;
   FieldInfo prev;
+  uint32_t pos = 0;
   for (const Block& element : wire.elements()) {
     FieldInfo info(element.type());
 
@@ -163,11 +170,55 @@ Packet::wireDecode(const Block& wire)
       }
     }
 
+    if (info.fieldIndex < fieldIndex.size()) {
+      FieldPosition& fieldPos = fieldIndex[info.fieldIndex];
+      if (fieldPos.count++ == 0) {
+        fieldPos.begin = pos;
+      }
+    }
+
     isFirst = false;
     prev = info;
+    ++pos;
   }
 
   m_wire = wire;
+  m_fieldIndex = fieldIndex;
+}
+
+Packet::ElementRange
+Packet::findField(uint64_t tlvType, size_t fieldIndex) const
+{
+  if (fieldIndex < m_fieldIndex.size()) {
+    const FieldPosition& fieldPos = m_fieldIndex[fieldIndex];
+    auto first = m_wire.elements_begin() + fieldPos.begin;
+    return {first, first + fieldPos.count};
+  }
+
+  // field not in FieldSet: occurrences are still adjacent, but must be searched for
+  auto first = std::find_if(m_wire.elements_begin(), m_wire.elements_end(),
+                            [tlvType] (const Block& block) { return block.type() == tlvType; });
+  auto last = std::find_if(first, m_wire.elements_end(),
+                           [tlvType] (const Block& block) { return block.type() != tlvType; });
+  return {first, last};
+}
+
+void
+Packet::indexFields()
+{
+  m_fieldIndex = FieldIndexTable{};
+
+  uint32_t pos = 0;
+  for (const Block& element : m_wire.elements()) {
+    FieldInfo info(element.type());
+    if (info.fieldIndex < m_fieldIndex.size()) {
+      FieldPosition& fieldPos = m_fieldIndex[info.fieldIndex];
+      if (fieldPos.count++ == 0) {
+        fieldPos.begin = pos;
+      }
+    }
+    ++pos;
+  }
 }
 
 bool
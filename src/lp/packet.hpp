@@ -24,9 +24,28 @@
 
 #include "fields.hpp"
 
+#include <array>
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/size.hpp>
+
 namespace ndn {
 namespace lp {
 
+namespace detail {
+
+/**
+ * \brief position of FIELD in FieldSet, or the size of FieldSet if FIELD is not a member
+ */
+template<typename FIELD>
+using FieldIndex =
+  typename boost::mpl::distance<typename boost::mpl::begin<FieldSet>::type,
+                                typename boost::mpl::find<FieldSet, FIELD>::type>::type;
+
+} // namespace detail
+
 class Packet
 {
 public:
@@ -87,9 +106,8 @@ public: // field access
   size_t
   count() const
   {
-    return std::count_if(m_wire.elements_begin(), m_wire.elements_end(),
-                         [] (const Block& block) {
-                           return block.type() == FIELD::TlvType::value; });
+    auto range = findField<FIELD>();
+    return std::distance(range.first, range.second);
   }
 
   /**
@@ -100,17 +118,11 @@ public: // field access
   typename FIELD::ValueType
   get(size_t index = 0) const
   {
-    size_t count = 0;
-    for (const Block& element : m_wire.elements()) {
-      if (element.type() != FIELD::TlvType::value) {
-        continue;
-      }
-      if (count++ == index) {
-        return FIELD::decode(element);
-      }
+    auto range = findField<FIELD>();
+    if (index >= static_cast<size_t>(std::distance(range.first, range.second))) {
+      BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
     }
-
-    BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
+    return FIELD::decode(*(range.first + index));
   }
 
   /**
@@ -122,11 +134,9 @@ public: // field access
   {
     std::vector<typename FIELD::ValueType> output;
 
-    for (const Block& element : m_wire.elements()) {
-      if (element.type() != FIELD::TlvType::value) {
-        continue;
-      }
-      output.push_back(FIELD::decode(element));
+    auto range = findField<FIELD>();
+    for (auto it = range.first; it != range.second; ++it) {
+      output.push_back(FIELD::decode(*it));
     }
 
     return output;
@@ -165,6 +175,7 @@ public: // field access
     auto pos = std::upper_bound(m_wire.elements_begin(), m_wire.elements_end(),
                                 FIELD::TlvType::value, comparePos);
     m_wire.insert(pos, block);
+    indexFields();
 
     return *this;
   }
@@ -177,18 +188,14 @@ public: // field access
   Packet&
   remove(size_t index = 0)
   {
-    size_t count = 0;
-    for (auto it = m_wire.elements_begin(); it != m_wire.elements_end(); ++it) {
-      if (it->type() == FIELD::TlvType::value) {
-        if (count == index) {
-          m_wire.erase(it);
-          return *this;
-        }
-        count++;
-      }
+    auto range = findField<FIELD>();
+    if (index >= static_cast<size_t>(std::distance(range.first, range.second))) {
+      BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
     }
 
-    BOOST_THROW_EXCEPTION(std::out_of_range("Index out of range"));
+    m_wire.erase(range.first + index);
+    indexFields();
+    return *this;
   }
 
   /**
@@ -199,15 +206,61 @@ public: // field access
   clear()
   {
     m_wire.remove(FIELD::TlvType::value);
+    indexFields();
     return *this;
   }
 
 private:
+  using ElementRange = std::pair<Block::element_const_iterator, Block::element_const_iterator>;
+
+  /**
+   * \return range of elements that are occurrences of FIELD
+   * \note All occurrences of a field are adjacent, because fields are sorted by TLV-TYPE.
+   */
+  template<typename FIELD>
+  ElementRange
+  findField() const
+  {
+    return findField(FIELD::TlvType::value, detail::FieldIndex<FIELD>::value);
+  }
+
+  /**
+   * \param tlvType TLV-TYPE of the field
+   * \param fieldIndex position of the field in FieldSet; if the field does not belong to
+   *                   FieldSet, elements are searched linearly
+   */
+  ElementRange
+  findField(uint64_t tlvType, size_t fieldIndex) const;
+
+  /**
+   * \brief rebuild m_fieldIndex from m_wire.elements()
+   */
+  void
+  indexFields();
+
   static bool
   comparePos(uint64_t first, const Block& second) noexcept;
 
 private:
   mutable Block m_wire;
+
+  /**
+   * \brief location of the occurrences of one field in m_wire.elements()
+   */
+  struct FieldPosition
+  {
+    uint32_t begin;
+    uint32_t count;
+  };
+  using FieldIndexTable = std::array<FieldPosition, boost::mpl::size<FieldSet>::value>;
+
+  /**
+   * \brief per-field lookup table, indexed by detail::FieldIndex
+   *
+   * This is built in a single pass when the packet is decoded, so that has(), count() and
+   * get() do not need to scan all elements.
+   */
+  FieldIndexTable m_fieldIndex;
 };
 
 } // namespace lp
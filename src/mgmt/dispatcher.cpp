@@ -48,6 +48,7 @@ Dispatcher::Dispatcher(Face& face, KeyChain& keyChain,
   : m_face(face)
   , m_keyChain(keyChain)
   , m_signingInfo(signingInfo)
+  , m_scheduler(m_face.getIoService())
   , m_storage(m_face.getIoService(), imsCapacity)
 {
 }
@@ -144,6 +145,10 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
 {
   auto data = m_storage.find(interest);
   if (data == nullptr) {
+    if (sendPendingStatusDatasetSegment(interest)) {
+      return;
+    }
+
     // invoke missContinuation to process this Interest if the query fails.
     if (missContinuation)
       missContinuation(prefix, interest);
@@ -304,19 +309,90 @@ void
 Dispatcher::sendStatusDatasetSegment(const Name& dataName, const Block& content,
                                      time::milliseconds imsFresh, bool isFinalBlock)
 {
+  uint64_t segmentNo = dataName[-1].toSegment();
+
   // the first segment will be sent to both places (the face and the in-memory storage)
-  // other segments will be inserted to the in-memory storage only
-  auto destination = SendDestination::IMS;
-  if (dataName[-1].toSegment() == 0) {
-    destination = SendDestination::FACE_AND_IMS;
+  if (segmentNo == 0) {
+    MetaInfo metaInfo;
+    if (isFinalBlock) {
+      metaInfo.setFinalBlock(dataName[-1]);
+    }
+
+    sendData(dataName, content, metaInfo, SendDestination::FACE_AND_IMS, imsFresh);
+    return;
   }
 
-  MetaInfo metaInfo;
+  // other segments will be signed and inserted to the in-memory storage when requested
+  Name prefix = dataName.getPrefix(-1);
+  if (segmentNo == 1) {
+    // a new response begins, it is discarded when it expires
+    m_pendingDatasets.erase(prefix);
+    auto it = m_pendingDatasets.emplace(std::piecewise_construct, std::forward_as_tuple(prefix),
+                                        std::forward_as_tuple(m_scheduler)).first;
+    it->second.expiry = time::steady_clock::now() + imsFresh;
+    it->second.expiryEvent = m_scheduler.scheduleEvent(imsFresh, [this, prefix] {
+      m_pendingDatasets.erase(prefix);
+    });
+  }
+
+  auto it = m_pendingDatasets.find(prefix);
+  if (it == m_pendingDatasets.end()) {
+    return;
+  }
+
+  PendingStatusDataset& dataset = it->second;
+
+  if (dataset.contents.size() <= segmentNo) {
+    dataset.contents.resize(segmentNo + 1);
+  }
+  dataset.contents[segmentNo] = content;
+  ++dataset.nPending;
   if (isFinalBlock) {
+    dataset.finalBlockId = dataName[-1];
+  }
+}
+
+bool
+Dispatcher::sendPendingStatusDatasetSegment(const Interest& interest)
+{
+  const Name& dataName = interest.getName();
+  if (m_pendingDatasets.empty() || dataName.empty() || !dataName[-1].isSegment()) {
+    return false;
+  }
+
+  auto it = m_pendingDatasets.find(dataName.getPrefix(-1));
+  if (it == m_pendingDatasets.end()) {
+    return false;
+  }
+
+  PendingStatusDataset& dataset = it->second;
+  auto now = time::steady_clock::now();
+  if (dataset.expiry <= now) {
+    m_pendingDatasets.erase(it);
+    return false;
+  }
+
+  uint64_t segmentNo = dataName[-1].toSegment();
+  if (segmentNo >= dataset.contents.size() || dataset.contents[segmentNo].empty()) {
+    return false;
+  }
+
+  Block content = dataset.contents[segmentNo];
+  dataset.contents[segmentNo] = Block();
+
+  MetaInfo metaInfo;
+  if (dataName[-1] == dataset.finalBlockId) {
     metaInfo.setFinalBlock(dataName[-1]);
   }
 
-  sendData(dataName, content, metaInfo, destination, imsFresh);
+  // the segment stays in the in-memory storage until the whole response expires
+  auto imsFresh = time::duration_cast<time::milliseconds>(dataset.expiry - now);
+  if (--dataset.nPending == 0) {
+    m_pendingDatasets.erase(it);
+  }
+
+  sendData(dataName, content, metaInfo, SendDestination::FACE_AND_IMS, imsFresh);
+  return true;
 }
 
 PostNotification
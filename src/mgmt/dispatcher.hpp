@@ -26,6 +26,7 @@
 #include "../face.hpp"
 #include "../ims/in-memory-storage-fifo.hpp"
 #include "../security/key-chain.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
 #include "control-response.hpp"
 #include "control-parameters.hpp"
 #include "status-dataset-context.hpp"
@@ -105,18 +106,6 @@ typedef std::function<void(const Name& prefix, const Interest& interest,
                            const ControlParameters& params,
                            const CommandContinuation& done)> ControlCommandHandler;
 
-// ---- STATUS DATASET ----
-
-/** \brief a function to handle a StatusDataset request
- *  \param prefix top-level prefix, e.g., "/localhost/nfd";
- *  \param interest incoming Interest; its Name doesn't contain version and segment components
- *
- *  This function can generate zero or more blocks and pass them to \p append,
- *  and must call \p end upon completion.
- */
-typedef std::function<void(const Name& prefix, const Interest& interest,
-                           StatusDatasetContext& context)> StatusDatasetHandler;
-
 //---- NOTIFICATION STREAM ----
 
 /** \brief a function to post a notification
@@ -243,6 +232,11 @@ public: // StatusDataset
    *
    *  As an optimization, a Data packet may be sent as soon as enough octets have been collected
    *  through StatusDatasetAppend calls.
+   *
+   *  The first segment is signed and sent immediately. The Content of other segments is kept
+   *  until the response expires (see StatusDatasetContext::setExpiry); each of these segments
+   *  is signed only when an Interest for it arrives, and is then served from the in-memory
+   *  storage.
    */
   void
   addStatusDataset(const PartialName& relPrefix,
@@ -433,6 +427,15 @@ private:
   sendStatusDatasetSegment(const Name& dataName, const Block& content,
                            time::milliseconds imsFresh, bool isFinalBlock);
 
+  /**
+   * @brief sign and send a segment of StatusDataset that has been requested for the first time
+   *
+   * @param interest the request, whose name must end with a segment component
+   * @return whether a pending segment matches @p interest
+   */
+  bool
+  sendPendingStatusDatasetSegment(const Interest& interest);
+
   void
   postNotification(const Block& notification, const PartialName& relPrefix);
 
@@ -454,7 +457,29 @@ private:
   // NotificationStream name => next sequence number
   std::unordered_map<Name, uint64_t> m_streams;
 
+  util::Scheduler m_scheduler;
+
+  /** \brief unsigned segments of a StatusDataset response
+   */
+  struct PendingStatusDataset
+  {
+    explicit
+    PendingStatusDataset(util::Scheduler& scheduler)
+      : expiryEvent(scheduler)
+    {
+    }
+
+    std::vector<Block> contents; ///< Content of each segment, empty once it has been signed
+    size_t nPending = 0;
+    name::Component finalBlockId;
+    time::steady_clock::TimePoint expiry;
+    util::scheduler::ScopedEventId expiryEvent; ///< erases the entry when the response expires
+  };
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // versioned StatusDataset prefix => segments not yet requested
+  std::unordered_map<Name, PendingStatusDataset> m_pendingDatasets;
+
   InMemoryStorageFifo m_storage;
 };
 
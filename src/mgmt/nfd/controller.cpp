@@ -62,6 +62,41 @@ Controller::startCommand(const shared_ptr<ControlCommand>& command,
   Interest interest = m_signer.makeCommandInterest(requestName, options.getSigningInfo());
   interest.setInterestLifetime(options.getTimeout());
 
+  this->expressCommandInterest(interest, command, onSuccess, onFailure);
+}
+
+void
+Controller::startCommands(const shared_ptr<ControlCommand>& command,
+                          const std::vector<ControlParameters>& parametersList,
+                          const CommandSucceedCallback& onSuccess1,
+                          const CommandFailCallback& onFailure1,
+                          const CommandOptions& options)
+{
+  const CommandSucceedCallback& onSuccess = onSuccess1 ?
+    onSuccess1 : [] (const ControlParameters&) {};
+  const CommandFailCallback& onFailure = onFailure1 ?
+    onFailure1 : [] (const ControlResponse&) {};
+
+  std::vector<Name> requestNames;
+  requestNames.reserve(parametersList.size());
+  for (const auto& parameters : parametersList) {
+    requestNames.push_back(command->getRequestName(options.getPrefix(), parameters));
+  }
+
+  std::vector<Interest> interests = m_signer.makeCommandInterests(requestNames,
+                                                                  options.getSigningInfo());
+  for (Interest& interest : interests) {
+    interest.setInterestLifetime(options.getTimeout());
+    this->expressCommandInterest(interest, command, onSuccess, onFailure);
+  }
+}
+
+void
+Controller::expressCommandInterest(const Interest& interest,
+                                   const shared_ptr<ControlCommand>& command,
+                                   const CommandSucceedCallback& onSuccess,
+                                   const CommandFailCallback& onFailure)
+{
   m_face.expressInterest(interest,
     [=] (const Interest&, const Data& data) {
       this->processCommandResponse(data, command, onSuccess, onFailure);
@@ -80,6 +80,26 @@ public:
     this->startCommand(command, parameters, onSuccess, onFailure, options);
   }
 
+  /** \brief start execution of a batch of commands of the same type
+   *
+   *  The command Interests are prepared and signed together, and then expressed without
+   *  waiting for responses, so that many commands (e.g., route registrations at startup)
+   *  are pipelined.  \p onSuccess or \p onFailure is invoked once for each command.
+   *
+   *  \throw ControlCommand::ArgumentError any of \p parametersList is invalid for \p Command;
+   *         in this case, no command is started
+   */
+  template<typename Command>
+  void
+  start(const std::vector<ControlParameters>& parametersList,
+        const CommandSucceedCallback& onSuccess,
+        const CommandFailCallback& onFailure,
+        const CommandOptions& options = CommandOptions())
+  {
+    shared_ptr<ControlCommand> command = make_shared<Command>();
+    this->startCommands(command, parametersList, onSuccess, onFailure, options);
+  }
+
   /** \brief start dataset fetching
    */
   template<typename Dataset>
@@ -111,6 +131,19 @@ private:
                const CommandFailCallback& onFailure,
                const CommandOptions& options);
 
+  void
+  startCommands(const shared_ptr<ControlCommand>& command,
+                const std::vector<ControlParameters>& parametersList,
+                const CommandSucceedCallback& onSuccess,
+                const CommandFailCallback& onFailure,
+                const CommandOptions& options);
+
+  void
+  expressCommandInterest(const Interest& interest,
+                         const shared_ptr<ControlCommand>& command,
+                         const CommandSucceedCallback& onSuccess,
+                         const CommandFailCallback& onFailure);
+
   void
   processCommandResponse(const Data& data,
                          const shared_ptr<ControlCommand>& command,
@@ -26,6 +26,28 @@ namespace mgmt {
 
 const time::milliseconds DEFAULT_STATUS_DATASET_FRESHNESS_PERIOD = 1_s;
 
+/** \brief maximum TLV-VALUE size of Content in each segment
+ */
+static const size_t SEGMENT_CONTENT_SIZE = MAX_NDN_PACKET_SIZE >> 1;
+
+/** \brief room for Content TLV-TYPE and TLV-LENGTH in front of the segment buffer
+ */
+static const size_t SEGMENT_HEADER_SIZE = 1 + 3;
+static_assert(tlv::Content < 253 && SEGMENT_CONTENT_SIZE <= 0xFFFF,
+              "SEGMENT_HEADER_SIZE is too small");
+
+/** \brief create a buffer that can hold one segment without reallocation
+ *
+ *  Dataset items are appended after the header room. When the segment is complete, Content
+ *  TLV-TYPE and TLV-LENGTH are prepended, so that the Content block shares this buffer.
+ */
+static shared_ptr<EncodingBuffer>
+makeSegmentBuffer()
+{
+  return make_shared<EncodingBuffer>(SEGMENT_HEADER_SIZE + SEGMENT_CONTENT_SIZE,
+                                     SEGMENT_CONTENT_SIZE);
+}
+
 const Name&
 StatusDatasetContext::getPrefix() const
 {
@@ -76,17 +98,13 @@ StatusDatasetContext::append(const Block& block)
 
   size_t nBytesLeft = block.size();
   while (nBytesLeft > 0) {
-    size_t nBytesAppend = std::min(nBytesLeft,
-                                   (ndn::MAX_NDN_PACKET_SIZE >> 1) - m_buffer->size());
+    size_t nBytesAppend = std::min(nBytesLeft, SEGMENT_CONTENT_SIZE - m_buffer->size());
     m_buffer->appendByteArray(block.wire() + (block.size() - nBytesLeft), nBytesAppend);
     nBytesLeft -= nBytesAppend;
 
     if (nBytesLeft > 0) {
-      m_dataSender(Name(m_prefix).appendSegment(m_segmentNo++),
-                   makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
-                   m_expiry, false);
-
-      m_buffer = make_shared<EncodingBuffer>();
+      sendSegment(false);
+      m_buffer = makeSegmentBuffer();
     }
   }
 }
@@ -99,10 +117,7 @@ StatusDatasetContext::end()
   }
 
   m_state = State::FINALIZED;
-
-  m_dataSender(Name(m_prefix).appendSegment(m_segmentNo),
-               makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
-               m_expiry, true);
+  sendSegment(true);
 }
 
 void
@@ -116,6 +131,26 @@ StatusDatasetContext::reject(const ControlResponse& resp /*= a ControlResponse w
   m_nackSender(resp);
 }
 
+void
+StatusDatasetContext::sendSegment(bool isFinalBlock)
+{
+  m_buffer->prependVarNumber(m_buffer->size());
+  m_buffer->prependVarNumber(tlv::Content);
+
+  // the segment component is replaced in place, unless the previous Data still shares the name
+  if (m_segmentNo == 0) {
+    m_segmentName = m_prefix;
+    m_segmentName.reserve(m_prefix.size() + 1, m_prefix.wireEncode().value_size() + 11);
+    m_segmentName.appendSegment(m_segmentNo++);
+  }
+  else {
+    m_segmentName.set(-1, name::Component::fromSegment(m_segmentNo++));
+  }
+
+  // the Content block refers to the segment buffer without copying
+  m_dataSender(m_segmentName, m_buffer->block(), m_expiry, isFinalBlock);
+}
+
 StatusDatasetContext::StatusDatasetContext(const Interest& interest,
                                            const DataSender& dataSender,
                                            const NackSender& nackSender)
@@ -123,7 +158,7 @@ StatusDatasetContext::StatusDatasetContext(const Interest& interest,
   , m_dataSender(dataSender)
   , m_nackSender(nackSender)
   , m_expiry(DEFAULT_STATUS_DATASET_FRESHNESS_PERIOD)
-  , m_buffer(make_shared<EncodingBuffer>())
+  , m_buffer(makeSegmentBuffer())
   , m_segmentNo(0)
   , m_state(State::INITIAL)
 {
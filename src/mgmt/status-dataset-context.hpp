@@ -70,6 +70,9 @@ public:
 
   /** \brief append a Block to the response
    *  \throw std::domain_error end or reject has been invoked
+   *
+   *  The Block is copied directly into the Content of the current segment. A segment is passed
+   *  to the DataSender as soon as it is full; its Content shares the segment buffer.
    */
   void
   append(const Block& block);
@@ -100,6 +103,12 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
                        const DataSender& dataSender,
                        const NackSender& nackSender);
 
+private:
+  /** \brief send the Content in m_buffer as the next segment
+   */
+  void
+  sendSegment(bool isFinalBlock);
+
 private:
   friend class Dispatcher;
 
@@ -107,6 +116,7 @@ private:
   DataSender m_dataSender;
   NackSender m_nackSender;
   Name m_prefix;
+  Name m_segmentName; ///< m_prefix followed by the number of the last segment sent
   time::milliseconds m_expiry;
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -121,6 +131,16 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   State m_state;
 };
 
+/** \brief a function to handle a StatusDataset request
+ *  \param prefix top-level prefix, e.g., "/localhost/nfd";
+ *  \param interest incoming Interest; its Name doesn't contain version and segment components
+ *
+ *  This function can generate zero or more blocks and pass them to \p append,
+ *  and must call \p end upon completion.
+ */
+typedef std::function<void(const Name& prefix, const Interest& interest,
+                           StatusDatasetContext& context)> StatusDatasetHandler;
+
 } // namespace mgmt
 } // namespace ndn
 
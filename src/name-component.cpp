@@ -30,6 +30,7 @@
 #include "util/sha256.hpp"
 #include "util/string-helper.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -94,77 +95,226 @@ Component::Component(const std::string& str)
 {
 }
 
-static Component
-parseSha256DigestUri(std::string input)
+/** @brief Check if @p c can appear in URI representation without escaping
+ */
+static bool
+isUnreservedChar(uint8_t c)
 {
-  input.erase(0, getSha256DigestUriPrefix().size());
+  return (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') ||
+         c == '-' || c == '.' || c == '_' || c == '~';
+}
 
-  try {
-    return Component::fromImplicitSha256Digest(fromHex(input));
-  }
-  catch (const StringHelperError&) {
+static size_t
+decodeSha256DigestUri(const char* first, const char* last, uint8_t* value)
+{
+  if ((last - first) % 2 != 0) {
     BOOST_THROW_EXCEPTION(Component::Error("Cannot convert to a ImplicitSha256DigestComponent "
                                            "(invalid hex encoding)"));
   }
+
+  size_t valueLength = 0;
+  for (; first != last; first += 2) {
+    int hi = fromHexChar(first[0]);
+    int lo = fromHexChar(first[1]);
+    if (hi < 0 || lo < 0) {
+      BOOST_THROW_EXCEPTION(Component::Error("Cannot convert to a ImplicitSha256DigestComponent "
+                                             "(invalid hex encoding)"));
+    }
+    value[valueLength++] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+
+  if (valueLength != util::Sha256::DIGEST_SIZE) {
+    BOOST_THROW_EXCEPTION(Component::Error("Cannot create ImplicitSha256DigestComponent (input "
+                                           "digest must be " +
+                                           to_string(util::Sha256::DIGEST_SIZE) + " octets)"));
+  }
+  return valueLength;
 }
 
-Component
-Component::fromEscapedString(std::string input)
+/** @brief Decode TLV-TYPE in the form of a decimal number without leading zeros
+ */
+static uint32_t
+decodeTypeUri(const char* first, const char* last)
+{
+  uint32_t type = 0;
+  bool isValid = first != last && last - first <= 5 && *first != '0';
+  for (const char* p = first; isValid && p != last; ++p) {
+    isValid = *p >= '0' && *p <= '9';
+    type = type * 10 + (*p - '0');
+  }
+
+  if (!isValid || type < tlv::NameComponentMin || type > tlv::NameComponentMax ||
+      type == tlv::ImplicitSha256DigestComponent || type == tlv::GenericNameComponent) {
+    BOOST_THROW_EXCEPTION(Component::Error("Incorrect TLV-TYPE in NameComponent URI"));
+  }
+  return type;
+}
+
+std::pair<uint32_t, size_t>
+Component::decodeEscaped(const char* first, const char* last, uint8_t* value)
 {
   uint32_t type = tlv::GenericNameComponent;
-  size_t equalPos = input.find('=');
-  if (equalPos != std::string::npos) {
-    if (equalPos + 1 == getSha256DigestUriPrefix().size() &&
-        input.compare(0, getSha256DigestUriPrefix().size(), getSha256DigestUriPrefix()) == 0) {
-      return parseSha256DigestUri(std::move(input));
+  auto equal = static_cast<const char*>(std::memchr(first, '=', last - first));
+  if (equal != nullptr) {
+    const std::string& sha256DigestPrefix = getSha256DigestUriPrefix();
+    if (static_cast<size_t>(equal + 1 - first) == sha256DigestPrefix.size() &&
+        std::equal(first, equal, sha256DigestPrefix.begin())) {
+      return {tlv::ImplicitSha256DigestComponent, decodeSha256DigestUri(equal + 1, last, value)};
     }
 
-    long parsedType = std::strtol(input.data(), nullptr, 10);
-    if (parsedType < tlv::NameComponentMin || parsedType > tlv::NameComponentMax ||
-        parsedType == tlv::ImplicitSha256DigestComponent || parsedType == tlv::GenericNameComponent ||
-        to_string(parsedType).size() != equalPos) {
-      BOOST_THROW_EXCEPTION(Error("Incorrect TLV-TYPE in NameComponent URI"));
+    type = decodeTypeUri(first, equal);
+    first = equal + 1;
+  }
+
+  // copy runs of unescaped characters between percent signs
+  uint8_t* output = value;
+  while (first != last) {
+    auto percent = static_cast<const char*>(std::memchr(first, '%', last - first));
+    const char* runEnd = percent == nullptr ? last : percent;
+    std::memcpy(output, first, runEnd - first);
+    output += runEnd - first;
+    first = runEnd;
+    if (percent == nullptr) {
+      break;
+    }
+
+    // a percent sign that is not followed by two hex digits is kept as is
+    if (last - percent > 2) {
+      int hi = fromHexChar(percent[1]);
+      int lo = fromHexChar(percent[2]);
+      if (hi < 0 || lo < 0) {
+        std::memcpy(output, percent, 3);
+        output += 3;
+      }
+      else {
+        *output++ = static_cast<uint8_t>((hi << 4) | lo);
+      }
+      first = percent + 3;
+    }
+    else {
+      *output++ = '%';
+      ++first;
     }
-    type = static_cast<uint32_t>(parsedType);
-    input.erase(0, equalPos + 1);
   }
 
-  std::string value = unescape(input);
-  if (value.find_first_not_of('.') == std::string::npos) { // all periods
-    if (value.size() < 3) {
+  size_t valueLength = output - value;
+  if (std::all_of(value, output, [] (uint8_t x) { return x == '.'; })) { // all periods
+    if (valueLength < 3) {
       BOOST_THROW_EXCEPTION(Error("Illegal URI (name component cannot be . or ..)"));
     }
-    return Component(type, reinterpret_cast<const uint8_t*>(value.data()), value.size() - 3);
+    valueLength -= 3;
   }
-  return Component(type, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  return {type, valueLength};
+}
+
+Component
+Component::fromEscapedString(const char* input, size_t beginOffset, size_t endOffset)
+{
+  // TLV-VALUE is decoded after room for the longest possible TLV-TYPE and TLV-LENGTH
+  size_t uriLength = endOffset - beginOffset;
+  size_t headroom = tlv::sizeOfVarNumber(tlv::NameComponentMax) + tlv::sizeOfVarNumber(uriLength);
+  auto buffer = make_shared<Buffer>(headroom + uriLength);
+
+  uint32_t type = 0;
+  size_t valueLength = 0;
+  std::tie(type, valueLength) = decodeEscaped(input + beginOffset, input + endOffset,
+                                              buffer->data() + headroom);
+
+  size_t headerLength = tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength);
+  uint8_t* header = buffer->data() + headroom - headerLength;
+  tlv::writeVarNumber(header + tlv::writeVarNumber(header, type), valueLength);
+  return Block(buffer, buffer->begin() + headroom - headerLength,
+               buffer->begin() + headroom + valueLength);
 }
 
 void
 Component::toUri(std::ostream& os) const
 {
-  if (type() == tlv::ImplicitSha256DigestComponent) {
-    os << getSha256DigestUriPrefix();
-    printHex(os, value(), value_size(), false);
-    return;
+  char buf[256];
+  size_t length = toUri(buf, sizeof(buf));
+  if (length <= sizeof(buf)) {
+    os.write(buf, length);
   }
-
-  if (type() != tlv::GenericNameComponent) {
-    os << type() << '=';
+  else {
+    os << toUri();
   }
+}
 
-  if (std::all_of(value_begin(), value_end(), [] (uint8_t x) { return x == '.'; })) { // all periods
-    os << "...";
+std::string
+Component::toUri() const
+{
+  char buf[256];
+  size_t length = toUri(buf, sizeof(buf));
+  if (length <= sizeof(buf)) {
+    return std::string(buf, length);
   }
 
-  escape(os, reinterpret_cast<const char*>(value()), value_size());
+  std::string uri(length, '\0');
+  toUri(&uri[0], length);
+  return uri;
 }
 
-std::string
-Component::toUri() const
+size_t
+Component::toUri(char* buf, size_t bufSize) const
 {
-  std::ostringstream os;
-  toUri(os);
-  return os.str();
+  const uint8_t* first = value();
+  const uint8_t* last = first + value_size();
+
+  if (type() == tlv::ImplicitSha256DigestComponent) {
+    const std::string& sha256DigestPrefix = getSha256DigestUriPrefix();
+    size_t length = sha256DigestPrefix.size() + 2 * value_size();
+    if (length <= bufSize) {
+      buf = std::copy(sha256DigestPrefix.begin(), sha256DigestPrefix.end(), buf);
+      for (const uint8_t* p = first; p != last; ++p) {
+        *buf++ = toHexChar(*p >> 4, false);
+        *buf++ = toHexChar(*p & 0xf, false);
+      }
+    }
+    return length;
+  }
+
+  // TLV-TYPE is at most 65535, so it has at most 5 digits
+  char typeUri[6];
+  size_t typeLength = 0;
+  if (type() != tlv::GenericNameComponent) {
+    char* typeEnd = typeUri + sizeof(typeUri);
+    char* typeBegin = typeEnd;
+    *--typeBegin = '=';
+    for (uint32_t t = type(); t > 0; t /= 10) {
+      *--typeBegin = static_cast<char>('0' + t % 10);
+    }
+    typeLength = typeEnd - typeBegin;
+    std::memmove(typeUri, typeBegin, typeLength);
+  }
+
+  bool isAllPeriods = std::all_of(first, last, [] (uint8_t x) { return x == '.'; });
+  size_t length = typeLength + (isAllPeriods ? 3 : 0) + value_size();
+  for (const uint8_t* p = first; p != last; ++p) {
+    if (!isUnreservedChar(*p)) {
+      length += 2;
+    }
+  }
+  if (length > bufSize) {
+    return length;
+  }
+
+  buf = std::copy_n(typeUri, typeLength, buf);
+  if (isAllPeriods) {
+    buf = std::copy_n("...", 3, buf);
+  }
+  for (const uint8_t* p = first; p != last; ++p) {
+    if (isUnreservedChar(*p)) {
+      *buf++ = static_cast<char>(*p);
+    }
+    else {
+      *buf++ = '%';
+      *buf++ = toHexChar(*p >> 4);
+      *buf++ = toHexChar(*p & 0xf);
+    }
+  }
+  return length;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,9 @@
 #include "util/time.hpp"
 
 namespace ndn {
+
+class Name;
+
 namespace name {
 
 /// @brief Segment marker for NDN naming conventions
@@ -196,10 +199,7 @@ public: // encoding and URI
    * @throw Error URI component does not represent a valid NameComponent.
    */
   static Component
-  fromEscapedString(const char* input, size_t beginOffset, size_t endOffset)
-  {
-    return fromEscapedString(std::string(input + beginOffset, input + endOffset));
-  }
+  fromEscapedString(const char* input, size_t beginOffset, size_t endOffset);
 
   /**
    * @brief Decode NameComponent from a URI component.
@@ -208,7 +208,7 @@ public: // encoding and URI
   static Component
   fromEscapedString(const char* input)
   {
-    return fromEscapedString(std::string(input));
+    return fromEscapedString(input, 0, std::char_traits<char>::length(input));
   }
 
   /**
@@ -216,7 +216,10 @@ public: // encoding and URI
    * @throw Error URI component does not represent a valid NameComponent.
    */
   static Component
-  fromEscapedString(std::string input);
+  fromEscapedString(const std::string& input)
+  {
+    return fromEscapedString(input.data(), 0, input.size());
+  }
 
   /**
    * @brief Write *this to the output stream, escaping characters according to the NDN URI Scheme
@@ -238,6 +241,19 @@ public: // encoding and URI
   std::string
   toUri() const;
 
+  /**
+   * @brief Write *this into a character buffer, escaping characters according to the NDN URI Scheme
+   *
+   * This also adds "..." to a value with zero or more "."
+   *
+   * @param buf the buffer; may be nullptr if @p bufSize is zero
+   * @param bufSize size of @p buf
+   * @return length of the escaped string, which is not null-terminated;
+   *         if it exceeds @p bufSize, nothing is written
+   */
+  size_t
+  toUri(char* buf, size_t bufSize) const;
+
 public: // naming conventions
   /**
    * @brief Check if the component is nonNegativeInteger
@@ -579,6 +595,17 @@ private:
   void
   ensureValid() const;
 
+  /**
+   * @brief Decode TLV-TYPE and TLV-VALUE from the URI component at [@p first, @p last)
+   * @param[out] value receives TLV-VALUE, which is never longer than the URI component
+   * @return TLV-TYPE and TLV-LENGTH
+   * @throw Error URI component does not represent a valid NameComponent.
+   */
+  static std::pair<uint32_t, size_t>
+  decodeEscaped(const char* first, const char* last, uint8_t* value);
+
+  friend class ndn::Name;
+
   // !!! NOTE TO IMPLEMENTOR !!!
   //
   // This class MUST NOT contain any data fields.
@@ -29,7 +29,8 @@
 #include "encoding/encoding-buffer.hpp"
 #include "util/time.hpp"
 
-#include <sstream>
+#include <algorithm>
+#include <cstring>
 #include <boost/functional/hash.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/concepts.hpp>
@@ -64,61 +65,129 @@ Name::Name(const Block& wire)
 }
 
 Name::Name(const char* uri)
-  : Name(std::string(uri))
+  : Name(uri, std::char_traits<char>::length(uri))
 {
 }
 
-Name::Name(std::string uri)
+Name::Name(const std::string& uri)
+  : Name(uri.data(), uri.size())
 {
-  if (uri.empty())
+}
+
+Name::Name(const char* uri, size_t uriLength)
+  : m_wire(tlv::Name)
+{
+  const char* first = uri;
+  const char* last = uri + uriLength;
+  if (first == last)
     return;
 
-  size_t iColon = uri.find(':');
-  if (iColon != std::string::npos) {
+  auto colon = static_cast<const char*>(std::memchr(first, ':', last - first));
+  if (colon != nullptr) {
     // Make sure the colon came before a '/'.
-    size_t iFirstSlash = uri.find('/');
-    if (iFirstSlash == std::string::npos || iColon < iFirstSlash) {
+    auto firstSlash = static_cast<const char*>(std::memchr(first, '/', last - first));
+    if (firstSlash == nullptr || colon < firstSlash) {
       // Omit the leading protocol such as ndn:
-      uri.erase(0, iColon + 1);
+      first = colon + 1;
     }
   }
 
   // Trim the leading slash and possibly the authority.
-  if (uri[0] == '/') {
-    if (uri.size() >= 2 && uri[1] == '/') {
+  if (first != last && *first == '/') {
+    if (last - first >= 2 && first[1] == '/') {
       // Strip the authority following "//".
-      size_t iAfterAuthority = uri.find('/', 2);
-      if (iAfterAuthority == std::string::npos)
+      auto afterAuthority = static_cast<const char*>(std::memchr(first + 2, '/', last - first - 2));
+      if (afterAuthority == nullptr)
         // Unusual case: there was only an authority.
         return;
-      else {
-        uri.erase(0, iAfterAuthority + 1);
-      }
+      first = afterAuthority + 1;
     }
     else {
-      uri.erase(0, 1);
+      ++first;
     }
   }
+  if (first == last)
+    return;
 
-  size_t iComponentStart = 0;
+  // Every component is decoded in place after room for its TLV-TYPE and TLV-LENGTH.  Each of
+  // them is shorter than its URI representation, plus its slash, plus that room.
+  size_t nComponents = 1 + std::count(first, last, '/');
+  size_t componentHeadroom = tlv::sizeOfVarNumber(tlv::NameComponentMax) +
+                             tlv::sizeOfVarNumber(last - first);
+  size_t capacity = (last - first) + nComponents * componentHeadroom;
+  size_t headroom = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(capacity);
+  auto buffer = make_shared<Buffer>(headroom + capacity);
+
+  uint8_t* valueBegin = buffer->data() + headroom;
+  uint8_t* output = valueBegin;
+  while (first != last) {
+    auto componentEnd = static_cast<const char*>(std::memchr(first, '/', last - first));
+    if (componentEnd == nullptr)
+      componentEnd = last;
+
+    uint32_t type = 0;
+    size_t valueLength = 0;
+    std::tie(type, valueLength) = Component::decodeEscaped(first, componentEnd,
+                                                           output + componentHeadroom);
+    size_t headerLength = tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueLength);
+    std::memmove(output + headerLength, output + componentHeadroom, valueLength);
+    tlv::writeVarNumber(output + tlv::writeVarNumber(output, type), valueLength);
+    output += headerLength + valueLength;
+
+    if (componentEnd == last)
+      break;
+    first = componentEnd + 1;
+  }
 
-  // Unescape the components.
-  while (iComponentStart < uri.size()) {
-    size_t iComponentEnd = uri.find("/", iComponentStart);
-    if (iComponentEnd == std::string::npos)
-      iComponentEnd = uri.size();
+  size_t valueLength = output - valueBegin;
+  size_t headerLength = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(valueLength);
+  uint8_t* header = valueBegin - headerLength;
+  tlv::writeVarNumber(header + tlv::writeVarNumber(header, tlv::Name), valueLength);
 
-    append(Component::fromEscapedString(&uri[0], iComponentStart, iComponentEnd));
-    iComponentStart = iComponentEnd + 1;
-  }
+  m_wire = Block(buffer, buffer->cbegin() + headroom - headerLength,
+                 buffer->cbegin() + headroom + valueLength);
+  m_wire.parse();
 }
 
 std::string
 Name::toUri() const
 {
-  std::ostringstream os;
-  os << *this;
-  return os.str();
+  char buf[256];
+  size_t length = toUri(buf, sizeof(buf));
+  if (length <= sizeof(buf)) {
+    return std::string(buf, length);
+  }
+
+  std::string uri(length, '\0');
+  toUri(&uri[0], length);
+  return uri;
+}
+
+size_t
+Name::toUri(char* buf, size_t bufSize) const
+{
+  if (empty()) {
+    if (bufSize > 0) {
+      buf[0] = '/';
+    }
+    return 1;
+  }
+
+  size_t length = 0;
+  for (const Component& component : *this) {
+    if (length < bufSize) {
+      buf[length] = '/';
+    }
+    ++length;
+
+    if (length < bufSize) {
+      length += component.toUri(buf + length, bufSize - length);
+    }
+    else {
+      length += component.toUri(nullptr, 0);
+    }
+  }
+  return length;
 }
 
 template<encoding::Tag TAG>
@@ -161,6 +230,7 @@ Name::wireDecode(const Block& wire)
   if (wire.type() != tlv::Name)
     BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding Name"));
 
+  m_buffer.reset();
   m_wire = wire;
   m_wire.parse();
 }
@@ -169,6 +239,7 @@ Name
 Name::deepCopy() const
 {
   Name copiedName(*this);
+  copiedName.m_buffer.reset();
   copiedName.m_wire.resetWire();
   copiedName.wireEncode(); // "compress" the underlying buffer
   return copiedName;
@@ -236,6 +307,157 @@ Name::append(const PartialName& name)
   return *this;
 }
 
+Name&
+Name::set(ssize_t i, const Component& component)
+{
+  if (i < 0) {
+    i += size();
+  }
+
+  if (m_buffer != nullptr) {
+    spliceReserved(i, 1, &component);
+  }
+  else {
+    m_wire.m_elements[i] = component;
+    m_wire.resetWire();
+  }
+  return *this;
+}
+
+void
+Name::reserve(size_t nComponents, size_t valueCapacity)
+{
+  m_wire.m_elements.reserve(nComponents);
+  spliceReserved(size(), 0, nullptr, valueCapacity);
+}
+
+size_t
+Name::capacity() const
+{
+  if (m_buffer == nullptr) {
+    return 0;
+  }
+  return m_buffer->cend() - m_wire.m_valueBegin;
+}
+
+/** @brief Write Type-Length-Value of @p block at @p dest
+ *  @return size of @p block
+ */
+static size_t
+writeBlock(uint8_t* dest, const Block& block)
+{
+  if (block.hasWire()) {
+    std::memcpy(dest, block.wire(), block.size());
+    return block.size();
+  }
+
+  size_t length = tlv::writeVarNumber(dest, block.type());
+  length += tlv::writeVarNumber(dest + length, block.value_size());
+  if (block.value_size() > 0) {
+    std::memcpy(dest + length, block.value(), block.value_size());
+  }
+  return length + block.value_size();
+}
+
+void
+Name::spliceReserved(size_t pos, size_t nRemoved, const Block* component, size_t minCapacity)
+{
+  BOOST_ASSERT(pos + nRemoved <= size());
+  Block::element_container& elements = m_wire.m_elements;
+
+  size_t removedSize = 0;
+  for (size_t i = pos; i < pos + nRemoved; ++i) {
+    removedSize += elements[i].size();
+  }
+  size_t insertedSize = component == nullptr ? 0 : component->size();
+  size_t oldValueSize = m_buffer == nullptr ? 0 : m_wire.value_size();
+  if (m_buffer == nullptr) {
+    for (const Block& element : elements) {
+      oldValueSize += element.size();
+    }
+  }
+  size_t newValueSize = oldValueSize - removedSize + insertedSize;
+
+  // The buffer can be updated in place, unless it is referenced by anything other than m_wire
+  // and the components, or the new component lives within the buffer.
+  size_t oldCapacity = capacity();
+  bool canUpdateInPlace = m_buffer != nullptr &&
+                          m_buffer.use_count() == static_cast<long>(2 + elements.size()) &&
+                          (component == nullptr || component->m_buffer != m_buffer) &&
+                          newValueSize <= oldCapacity && minCapacity <= oldCapacity;
+
+  size_t firstMoved = pos;
+  size_t headroom = 0;
+  if (canUpdateInPlace) {
+    headroom = m_wire.m_valueBegin - m_buffer->cbegin();
+    size_t spliceBegin = pos < elements.size() ?
+                         elements[pos].m_begin - m_buffer->cbegin() : headroom + oldValueSize;
+    size_t spliceEnd = spliceBegin + removedSize;
+    size_t valueEnd = headroom + oldValueSize;
+
+    uint8_t* data = m_buffer->data();
+    std::memmove(data + spliceBegin + insertedSize, data + spliceEnd, valueEnd - spliceEnd);
+    if (component != nullptr) {
+      writeBlock(data + spliceBegin, *component);
+    }
+  }
+  else {
+    size_t capacity = std::max({oldCapacity, minCapacity, newValueSize});
+    if (newValueSize > oldCapacity && m_buffer != nullptr) {
+      capacity = std::max(capacity, 2 * oldCapacity);
+    }
+    headroom = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(capacity);
+
+    // old buffer is kept alive by the components until they are moved
+    auto buffer = make_shared<Buffer>(headroom + capacity);
+    uint8_t* dest = buffer->data() + headroom;
+    for (size_t i = 0; i < pos; ++i) {
+      dest += writeBlock(dest, elements[i]);
+    }
+    if (component != nullptr) {
+      dest += writeBlock(dest, *component);
+    }
+    for (size_t i = pos + nRemoved; i < elements.size(); ++i) {
+      dest += writeBlock(dest, elements[i]);
+    }
+    m_buffer = std::move(buffer);
+    firstMoved = 0;
+  }
+
+  // component may refer to an element, so it must not be accessed past this point
+  size_t nInserted = component == nullptr ? 0 : 1;
+  if (nRemoved > nInserted) {
+    elements.erase(elements.begin() + pos + nInserted, elements.begin() + pos + nRemoved);
+  }
+  else if (nInserted > nRemoved) {
+    elements.insert(elements.begin() + pos, Block());
+  }
+
+  // point elements at their new positions
+  Buffer::const_iterator it = m_buffer->cbegin() + headroom;
+  if (firstMoved > 0) {
+    it = elements[firstMoved - 1].m_end;
+  }
+  for (size_t i = firstMoved; i < elements.size(); ++i) {
+    size_t elementSize = (i == pos && nInserted > 0) ? insertedSize : elements[i].size();
+    elements[i] = Block(m_buffer, it, it + elementSize);
+    it += elementSize;
+  }
+
+  // write TLV-TYPE and TLV-LENGTH immediately before TLV-VALUE
+  size_t headerSize = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(newValueSize);
+  uint8_t* header = m_buffer->data() + headroom - headerSize;
+  tlv::writeVarNumber(header + tlv::writeVarNumber(header, tlv::Name), newValueSize);
+
+  m_wire.m_buffer = m_buffer;
+  m_wire.m_type = tlv::Name;
+  m_wire.m_begin = m_buffer->cbegin() + headroom - headerSize;
+  m_wire.m_valueBegin = m_buffer->cbegin() + headroom;
+  m_wire.m_valueEnd = m_wire.m_valueBegin + newValueSize;
+  m_wire.m_end = m_wire.m_valueEnd;
+  m_wire.m_size = headerSize + newValueSize;
+}
+
 // ---- algorithms ----
 
 Name
@@ -303,14 +525,13 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
 std::ostream&
 operator<<(std::ostream& os, const Name& name)
 {
-  if (name.empty()) {
-    os << "/";
+  char buf[256];
+  size_t length = name.toUri(buf, sizeof(buf));
+  if (length <= sizeof(buf)) {
+    os.write(buf, length);
   }
   else {
-    for (const auto& component : name) {
-      os << "/";
-      component.toUri(os);
-    }
+    os << name.toUri();
   }
   return os;
 }
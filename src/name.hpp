@@ -97,7 +97,16 @@ public: // constructors, encoding, decoding
    *  @param uri a URI string
    *  @sa https://named-data.net/doc/NDN-packet-spec/current/name.html#ndn-uri-scheme
    */
-  Name(std::string uri);
+  Name(const std::string& uri);
+
+  /** @brief Parse name from NDN URI
+   *  @param uri a URI string, which need not be null-terminated
+   *  @param uriLength length of @p uri
+   *  @sa https://named-data.net/doc/NDN-packet-spec/current/name.html#ndn-uri-scheme
+   *
+   *  The name is decoded directly into a single wire encoding buffer, without copying the URI.
+   */
+  Name(const char* uri, size_t uriLength);
 
   /** @brief Get URI representation of the name
    *  @return URI representation; "ndn:" scheme identifier is not included
@@ -107,6 +116,16 @@ public: // constructors, encoding, decoding
   std::string
   toUri() const;
 
+  /** @brief Write URI representation of the name into a character buffer
+   *  @param buf the buffer; may be nullptr if @p bufSize is zero
+   *  @param bufSize size of @p buf
+   *  @return length of URI representation, which is not null-terminated;
+   *          if it exceeds @p bufSize, the content of @p buf is unspecified
+   *  @sa https://named-data.net/doc/NDN-packet-spec/current/name.html#ndn-uri-scheme
+   */
+  size_t
+  toUri(char* buf, size_t bufSize) const;
+
   /** @brief Check if this Name instance already has wire encoding
    */
   bool
@@ -255,7 +274,12 @@ public: // modifiers
   Name&
   append(const Component& component)
   {
-    m_wire.push_back(component);
+    if (m_buffer != nullptr) {
+      spliceReserved(size(), 0, &component);
+    }
+    else {
+      m_wire.push_back(component);
+    }
     return *this;
   }
 
@@ -327,12 +351,10 @@ public: // modifiers
   append(const Block& value)
   {
     if (value.type() == tlv::GenericNameComponent) {
-      m_wire.push_back(value);
-    }
-    else {
-      m_wire.push_back(Block(tlv::GenericNameComponent, value));
+      return append(reinterpret_cast<const Component&>(value));
     }
-    return *this;
+    Block component(tlv::GenericNameComponent, value);
+    return append(reinterpret_cast<const Component&>(component));
   }
 
   /** @brief Append a component with a nonNegativeInteger
@@ -469,9 +491,55 @@ public: // modifiers
   void
   clear()
   {
-    m_wire = Block(tlv::Name);
+    if (m_buffer != nullptr) {
+      spliceReserved(0, size(), nullptr);
+    }
+    else {
+      m_wire = Block(tlv::Name);
+    }
   }
 
+  /** @brief Replace the component at the given index
+   *  @param i zero-based index; if negative, it starts at the end of this name
+   *  @param component the new component
+   *  @return a reference to this name, to allow chaining
+   *  @warning Indexing out of bounds triggers undefined behavior.
+   *
+   *  After reserve(), replacing the last component takes constant time, and does not allocate
+   *  memory as long as the buffer is not shared.
+   */
+  Name&
+  set(ssize_t i, const Component& component);
+
+  /** @brief Reserve a buffer into which components are encoded as they are appended
+   *  @param nComponents expected number of components
+   *  @param valueCapacity expected TLV-LENGTH of the Name, i.e. total size of its components
+   *  @post hasWire() == true
+   *
+   *  After this call, append(), set(), and clear() encode components directly into a buffer
+   *  owned by this Name, so that its wire encoding is always up to date.  The buffer is
+   *  reallocated when it becomes too small, or when it is shared with a copy of this Name or
+   *  of one of its components; such copies are never modified.
+   *
+   *  This is useful for generating many names that differ only in their last component:
+   *  @code
+   *    Name name(prefix);
+   *    name.reserve(prefix.size() + 1, prefix.wireEncode().value_size() + 16);
+   *    name.appendSegment(0);
+   *    for (uint64_t segment = 1; segment < nSegments; ++segment) {
+   *      name.set(-1, name::Component::fromSegment(segment));
+   *    }
+   *  @endcode
+   */
+  void
+  reserve(size_t nComponents, size_t valueCapacity);
+
+  /** @brief Get the TLV-LENGTH the Name can grow to without reallocating its buffer
+   *  @return capacity of the buffer allocated by reserve(), or zero if reserve() was not called
+   */
+  size_t
+  capacity() const;
+
 public: // algorithms
   /** @brief Get the successor of a name
    *
@@ -556,8 +624,23 @@ public:
    */
   static const size_t npos;
 
+private:
+  /** @brief Replace @p nRemoved components at @p pos with @p component, if not nullptr,
+   *         encoding them into the reserved buffer
+   *  @param minCapacity reallocate the buffer if its capacity is less than this
+   */
+  void
+  spliceReserved(size_t pos, size_t nRemoved, const Block* component, size_t minCapacity = 0);
+
 private:
   mutable Block m_wire;
+
+  /** @brief buffer allocated by reserve(), or nullptr
+   *
+   *  If not nullptr, m_wire and all components are located within this buffer.  TLV-VALUE of
+   *  m_wire starts at a fixed offset, preceded by enough room for TLV-TYPE and TLV-LENGTH.
+   */
+  shared_ptr<Buffer> m_buffer;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Name);
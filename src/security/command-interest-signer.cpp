@@ -61,5 +61,19 @@ CommandInterestSigner::makeCommandInterest(const Name& name, const SigningInfo&
   return commandInterest;
 }
 
+std::vector<Interest>
+CommandInterestSigner::makeCommandInterests(const std::vector<Name>& names,
+                                            const SigningInfo& params)
+{
+  std::vector<Interest> commandInterests;
+  commandInterests.reserve(names.size());
+  for (const Name& name : names) {
+    commandInterests.emplace_back(prepareCommandInterestName(name));
+    commandInterests.back().setCanBePrefix(false);
+  }
+  m_keyChain.sign(commandInterests, params);
+  return commandInterests;
+}
+
 } // namespace security
 } // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -84,6 +84,20 @@ public:
   Interest
   makeCommandInterest(const Name& name, const SigningInfo& params = KeyChain::getDefaultSigningInfo());
 
+  /**
+   * @brief Create a batch of CommandInterests
+   *
+   * This method prepares the names of all command interests, with timestamps that strictly
+   * increase in the order of @p names, and then signs them in one pass with the keychain.
+   * The signing key is determined only once for the whole batch.
+   *
+   * @return command interests in the same order as @p names
+   * @sa makeCommandInterest
+   */
+  std::vector<Interest>
+  makeCommandInterests(const std::vector<Name>& names,
+                       const SigningInfo& params = KeyChain::getDefaultSigningInfo());
+
 private:
   KeyChain& m_keyChain;
 };
@@ -27,6 +27,7 @@
 #include "transform/stream-source.hpp"
 
 #include "transform/bool-sink.hpp"
+#include "transform/span-sink.hpp"
 #include "transform/stream-sink.hpp"
 
 #include "transform/base64-decode.hpp"
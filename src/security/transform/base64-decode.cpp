@@ -20,109 +20,51 @@
  */
 
 #include "base64-decode.hpp"
-#include "../detail/openssl.hpp"
+#include "../../util/detail/text-codec.hpp"
 
 namespace ndn {
 namespace security {
 namespace transform {
 
 /**
- * @brief The implementation class which contains the internal state of the filter
- *        which includes openssl specific structures.
+ * @brief The implementation class which contains the internal state of the filter.
  */
 class Base64Decode::Impl
 {
 public:
-  Impl()
-    : m_base64(BIO_new(BIO_f_base64()))
-    , m_source(BIO_new(BIO_s_mem()))
-  {
-    // Input may not be written in a single time.
-    // Do not return EOF when source is empty unless explicitly requested
-    BIO_set_mem_eof_return(m_source, -1);
-
-    // connect base64 transform to the data source.
-    BIO_push(m_base64, m_source);
-  }
-
-  ~Impl()
-  {
-    BIO_free_all(m_base64);
-  }
-
-public:
-  BIO* m_base64;
-  BIO* m_source; // BIO_f_base64 alone does not work without a source
+  util::detail::Base64Decoder m_decoder;
 };
 
-static const size_t BUFFER_LENGTH = 1024;
-
-Base64Decode::Base64Decode(bool expectNewlineEvery64Bytes)
+Base64Decode::Base64Decode(bool)
   : m_impl(make_unique<Impl>())
 {
-  if (!expectNewlineEvery64Bytes)
-    BIO_set_flags(m_impl->m_base64, BIO_FLAGS_BASE64_NO_NL);
 }
 
 Base64Decode::~Base64Decode() = default;
 
-void
-Base64Decode::preTransform()
-{
-  while (isOutputBufferEmpty()) {
-    fillOutputBuffer();
-    if (isOutputBufferEmpty()) // nothing to read from BIO, return
-      return;
-
-    flushOutputBuffer();
-  }
-}
-
 size_t
 Base64Decode::convert(const uint8_t* buf, size_t size)
 {
-  int wLen = BIO_write(m_impl->m_source, buf, size);
-
-  if (wLen <= 0) { // fail to write data
-    if (!BIO_should_retry(m_impl->m_source)) {
-      // we haven't written everything but some error happens, and we cannot retry
-      BOOST_THROW_EXCEPTION(Error(getIndex(), "Failed to accept more input"));
-    }
-    return 0;
-  }
-  else { // update number of bytes written
-    return wLen;
+  auto buffer = make_unique<OBuffer>((size + 3) / 4 * 3);
+  size_t nDecoded = m_impl->m_decoder.decode(reinterpret_cast<const char*>(buf), size,
+                                             buffer->data());
+  if (m_impl->m_decoder.hasError())
+    BOOST_THROW_EXCEPTION(Error(getIndex(), "Wrong input byte"));
+
+  if (nDecoded > 0) {
+    buffer->resize(nDecoded);
+    setOutputBuffer(std::move(buffer));
   }
+  return size;
 }
 
 void
 Base64Decode::finalize()
 {
-  BIO_set_mem_eof_return(m_impl->m_source, 0);
-
-  fillOutputBuffer();
-
-  while (!isOutputBufferEmpty()) {
-    flushOutputBuffer();
-    if (isOutputBufferEmpty())
-      fillOutputBuffer();
-  }
-}
-
-void
-Base64Decode::fillOutputBuffer()
-{
-  // OpenSSL base64 BIO cannot give us the number bytes of partial decoded result,
-  // so we just try to read a chunk.
-  auto buffer = make_unique<OBuffer>(BUFFER_LENGTH);
-  int rLen = BIO_read(m_impl->m_base64, buffer->data(), buffer->size());
-  if (rLen <= 0)
-    return;
-
-  if (static_cast<size_t>(rLen) < buffer->size())
-    buffer->erase(buffer->begin() + rLen, buffer->end());
+  flushAllOutput();
 
-  setOutputBuffer(std::move(buffer));
+  if (!m_impl->m_decoder.isComplete())
+    BOOST_THROW_EXCEPTION(Error(getIndex(), "Incomplete input"));
 }
 
 unique_ptr<Transform>
@@ -30,6 +30,10 @@ namespace transform {
 
 /**
  * @brief The module to perform Base64 decoding transformation.
+ *
+ * Whitespace, including spaces and CR/LF line breaks, is ignored anywhere in the input.
+ * Decoding throws Error if the input contains any other character that is not allowed in base64
+ * encoding, data after padding, or ends in the middle of a group of 4 characters.
  */
 class Base64Decode : public Transform
 {
@@ -37,9 +41,9 @@ public:
   /**
    * @brief Create a base64 decoding module
    *
-   * @p expectNewlineEvery64Bytes if true, expect newline after every 64 bytes, otherwise expect
-   *                              all input to be in a single line. Output is undefined if input
-   *                              does not conform to the requirement.
+   * @param expectNewlineEvery64Bytes ignored; input is decoded correctly with or without
+   *                                  line breaks
+   * @deprecated @p expectNewlineEvery64Bytes has no effect, and is kept only for compatibility
    */
   explicit
   Base64Decode(bool expectNewlineEvery64Bytes = true);
@@ -47,16 +51,11 @@ public:
   ~Base64Decode();
 
 private:
-  /**
-   * @brief Read partial transformation results into output buffer and write them into next module.
-   */
-  void
-  preTransform() final;
-
   /**
    * @brief Decode data @p buf in base64 format
    *
    * @return number of bytes that have been accepted by the converter
+   * @throw Error input contains a character that is not allowed in base64 encoding
    */
   size_t
   convert(const uint8_t* buf, size_t size) final;
@@ -64,22 +63,19 @@ private:
   /**
    * @brief Finalize base64 decoding
    *
-   * This method with read all decoding results from the converter and write them into next module.
+   * @throw Error input does not end at a complete group of 4 characters
    */
   void
   finalize() final;
 
-  /**
-   * @brief Try to fill partial decoding result into output buffer.
-   */
-  void
-  fillOutputBuffer();
-
 private:
   class Impl;
   const unique_ptr<Impl> m_impl;
 };
 
+/**
+ * @deprecated @p expectNewlineEvery64Bytes has no effect, and is kept only for compatibility
+ */
 unique_ptr<Transform>
 base64Decode(bool expectNewlineEvery64Bytes = true);
 
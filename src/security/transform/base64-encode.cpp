@@ -20,109 +20,87 @@
  */
 
 #include "base64-encode.hpp"
-#include "../detail/openssl.hpp"
+#include "../../encoding/buffer.hpp"
+#include "../../util/detail/text-codec.hpp"
 
 namespace ndn {
 namespace security {
 namespace transform {
 
 /**
- * @brief The implementation class which contains the internal state of the filter
- *        which includes openssl specific structures.
+ * @brief The implementation class which contains the internal state of the filter.
  */
 class Base64Encode::Impl
 {
 public:
-  Impl()
-    : m_base64(BIO_new(BIO_f_base64()))
-    , m_sink(BIO_new(BIO_s_mem()))
+  explicit
+  Impl(bool needBreak)
+    : m_needBreak(needBreak)
+    // with line breaks, 48 bytes make a line of 64 characters
+    , m_unitSize(needBreak ? 48 : 3)
   {
-    // connect base64 transform to the data sink.
-    BIO_push(m_base64, m_sink);
-  }
-
-  ~Impl()
-  {
-    BIO_free_all(m_base64);
+    m_pending.reserve(m_unitSize);
   }
 
 public:
-  BIO* m_base64;
-  BIO* m_sink; // BIO_f_base64 alone does not work without a sink
+  const bool m_needBreak;
+  const size_t m_unitSize;
+  Buffer m_pending; ///< input that does not make a complete unit yet
 };
 
 Base64Encode::Base64Encode(bool needBreak)
-  : m_impl(make_unique<Impl>())
+  : m_impl(make_unique<Impl>(needBreak))
 {
-  if (!needBreak)
-    BIO_set_flags(m_impl->m_base64, BIO_FLAGS_BASE64_NO_NL);
 }
 
 Base64Encode::~Base64Encode() = default;
 
-void
-Base64Encode::preTransform()
-{
-  fillOutputBuffer();
-}
-
 size_t
 Base64Encode::convert(const uint8_t* data, size_t dataLen)
 {
-  if (dataLen == 0)
-    return 0;
-
-  int wLen = BIO_write(m_impl->m_base64, data, dataLen);
+  Buffer& pending = m_impl->m_pending;
+  const size_t unitSize = m_impl->m_unitSize;
 
-  if (wLen <= 0) { // fail to write data
-    if (!BIO_should_retry(m_impl->m_base64)) {
-      // we haven't written everything but some error happens, and we cannot retry
-      BOOST_THROW_EXCEPTION(Error(getIndex(), "Failed to accept more input"));
-    }
-    return 0;
+  size_t nPrefix = 0;
+  if (!pending.empty()) {
+    nPrefix = std::min(unitSize - pending.size(), dataLen);
+    pending.insert(pending.end(), data, data + nPrefix);
   }
-  else { // update number of bytes written
-    fillOutputBuffer();
-    return wLen;
-  }
-}
-
-void
-Base64Encode::finalize()
-{
-  if (BIO_flush(m_impl->m_base64) != 1)
-    BOOST_THROW_EXCEPTION(Error(getIndex(), "Failed to flush"));
-
-  while (!isConverterEmpty()) {
-    fillOutputBuffer();
-    while (!isOutputBufferEmpty()) {
-      flushOutputBuffer();
+  size_t nPending = pending.size() == unitSize ? unitSize : 0;
+  size_t nBulk = (dataLen - nPrefix) / unitSize * unitSize;
+
+  size_t encodedSize = util::detail::getBase64EncodedSize(nPending + nBulk, m_impl->m_needBreak);
+  if (encodedSize > 0) {
+    auto buffer = make_unique<OBuffer>(encodedSize);
+    char* out = reinterpret_cast<char*>(buffer->data());
+    if (nPending > 0) {
+      out += util::detail::encodeBase64(pending.data(), nPending, out, m_impl->m_needBreak);
+      pending.clear();
     }
+    util::detail::encodeBase64(data + nPrefix, nBulk, out, m_impl->m_needBreak);
+    setOutputBuffer(std::move(buffer));
   }
+
+  pending.insert(pending.end(), data + nPrefix + nBulk, data + dataLen);
+  return dataLen;
 }
 
 void
-Base64Encode::fillOutputBuffer()
+Base64Encode::finalize()
 {
-  int nRead = BIO_pending(m_impl->m_sink);
-  if (nRead <= 0)
-    return;
+  flushAllOutput();
 
-  // there is something to read from BIO
-  auto buffer = make_unique<OBuffer>(nRead);
-  int rLen = BIO_read(m_impl->m_sink, buffer->data(), nRead);
-  if (rLen < 0)
+  Buffer& pending = m_impl->m_pending;
+  if (pending.empty())
     return;
 
-  if (rLen < nRead)
-    buffer->erase(buffer->begin() + rLen, buffer->end());
+  auto buffer = make_unique<OBuffer>(util::detail::getBase64EncodedSize(pending.size(),
+                                                                        m_impl->m_needBreak));
+  util::detail::encodeBase64(pending.data(), pending.size(),
+                             reinterpret_cast<char*>(buffer->data()), m_impl->m_needBreak);
+  pending.clear();
   setOutputBuffer(std::move(buffer));
-}
-
-bool
-Base64Encode::isConverterEmpty()
-{
-  return (BIO_pending(m_impl->m_sink) <= 0);
+  flushAllOutput();
 }
 
 unique_ptr<Transform>
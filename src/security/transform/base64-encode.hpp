@@ -45,14 +45,12 @@ public:
   ~Base64Encode();
 
 private:
-  /**
-   * @brief Read partial transformation result (if exists) from BIO
-   */
-  void
-  preTransform() final;
-
   /**
    * @brief Encode @p data into base64 format.
+   *
+   * Input that does not make a complete output line (or a complete group of 4 characters if
+   * there is no line break) is kept until more input arrives or the transformation ends.
+   *
    * @return The number of input bytes that have been accepted by the converter.
    */
   size_t
@@ -61,23 +59,11 @@ private:
   /**
    * @brief Finalize base64 encoding
    *
-   * This method with read all encoding results from the converter and write them into next module.
+   * This method encodes the remaining input with padding and writes the result into next module.
    */
   void
   finalize() final;
 
-  /**
-   * @brief Fill output buffer with the transformation result from BIO.
-   */
-  void
-  fillOutputBuffer();
-
-  /**
-   * @return true if converter does not have partial result.
-   */
-  bool
-  isConverterEmpty();
-
 private:
   class Impl;
   const unique_ptr<Impl> m_impl;
@@ -43,21 +43,34 @@ BufferSource::BufferSource(const Buffer& buffer)
 {
 }
 
+BufferSource::BufferSource(InputBuffers buffers)
+  : m_buf(nullptr)
+  , m_size(0)
+  , m_bufs(std::move(buffers))
+{
+}
+
 void
 BufferSource::doPump()
 {
   BOOST_ASSERT(m_next != nullptr);
 
-  const uint8_t* buf = m_buf;
-  size_t size = m_size;
+  writeBuffer(m_buf, m_size);
+  for (const auto& b : m_bufs) {
+    writeBuffer(b.first, b.second);
+  }
 
+  m_next->end();
+}
+
+void
+BufferSource::writeBuffer(const uint8_t* buf, size_t size)
+{
   while (0 < size) {
     size_t nBytesWritten = m_next->write(buf, size);
     buf += nBytesWritten;
     size -= nBytesWritten;
   }
-
-  m_next->end();
 }
 
 } // namespace transform
@@ -30,7 +30,12 @@ namespace security {
 namespace transform {
 
 /**
- * @brief A source taking a memory buffer as input
+ * @brief A list of memory ranges, each given as a pointer and a size
+ */
+using InputBuffers = std::vector<std::pair<const uint8_t*, size_t>>;
+
+/**
+ * @brief A source taking one or more memory buffers as input
  */
 class BufferSource : public Source
 {
@@ -58,16 +63,37 @@ public:
   explicit
   BufferSource(const Buffer& buffer);
 
+  /**
+   * @brief Take @p buffers as input, in order, as if they were concatenated.
+   *
+   * This allows a transformation to consume several discontiguous ranges, such as the
+   * wire encodings of several Blocks, without copying them into one buffer first.
+   *
+   * Caller must not destroy the buffers before transformation is done
+   */
+  explicit
+  BufferSource(InputBuffers buffers);
+
 private:
   /**
-   * @brief Write the whole buffer into the next module.
+   * @brief Write all buffers into the next module.
    */
   void
   doPump() final;
 
+  /**
+   * @brief Write @p buf with size of @p size into the next module.
+   */
+  void
+  writeBuffer(const uint8_t* buf, size_t size);
+
 private:
+  /// the single buffer taken by the pointer, string, and Buffer constructors
   const uint8_t* m_buf;
   size_t m_size;
+  /// the buffers taken by the InputBuffers constructor; empty otherwise, so that taking a
+  /// single buffer does not allocate
+  InputBuffers m_bufs;
 };
 
 typedef BufferSource bufferSource;
@@ -20,34 +20,13 @@
  */
 
 #include "hex-decode.hpp"
+#include "../../util/string-helper.hpp"
+#include "../../util/detail/text-codec.hpp"
 
 namespace ndn {
 namespace security {
 namespace transform {
 
-// hex decoding pad
-static const int8_t C2H[] = {
-// 0   1   2   3   4   5   6   7   8   9   10  11  12  13  14  15
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 0-15
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 16-31
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 32-47
-   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1, // 48-63
-  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 64-79
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 80-95
-  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 96-111
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 112-127
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 128-143
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 144-159
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 160-175
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 176-191
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 192-207
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 208-223
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 224-239
-  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 240-255
-};
-static_assert(std::extent<decltype(C2H)>::value == 256, "");
-
-
 HexDecode::HexDecode()
   : m_hasOddByte(false)
   , m_oddByte(0)
@@ -85,27 +64,21 @@ HexDecode::toBytes(const uint8_t* hex, size_t hexLen)
 {
   size_t bufferSize = (hexLen + (m_hasOddByte ? 1 : 0)) >> 1;
   auto buffer = make_unique<OBuffer>(bufferSize);
-  auto it = buffer->begin();
+  uint8_t* out = buffer->data();
 
   if (m_hasOddByte) {
-    if (C2H[hex[0]] < 0 || C2H[m_oddByte] < 0)
+    int hi = fromHexChar(static_cast<char>(m_oddByte));
+    int lo = fromHexChar(static_cast<char>(hex[0]));
+    if (hi < 0 || lo < 0)
       BOOST_THROW_EXCEPTION(Error(getIndex(), "Wrong input byte"));
 
-    *it = (C2H[m_oddByte] << 4) + C2H[hex[0]];
-    ++it;
+    *out++ = static_cast<uint8_t>((hi << 4) | lo);
     hex += 1;
     hexLen -= 1;
   }
 
-  while (hexLen >= 2) {
-    if (C2H[hex[0]] < 0 || C2H[hex[1]] < 0)
-      BOOST_THROW_EXCEPTION(Error(getIndex(), "Wrong input byte"));
-
-    *it = (C2H[hex[0]] << 4) + C2H[hex[1]];
-    ++it;
-    hex += 2;
-    hexLen -= 2;
-  }
+  if (!util::detail::decodeHex(reinterpret_cast<const char*>(hex), hexLen & ~size_t(1), out))
+    BOOST_THROW_EXCEPTION(Error(getIndex(), "Wrong input byte"));
 
   return buffer;
 }
@@ -20,24 +20,12 @@
  */
 
 #include "hex-encode.hpp"
+#include "../../util/detail/text-codec.hpp"
 
 namespace ndn {
 namespace security {
 namespace transform {
 
-static const uint8_t H2CL[] = {
-  '0', '1', '2', '3', '4', '5', '6', '7',
-  '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
-};
-static_assert(std::extent<decltype(H2CL)>::value == 16, "");
-
-static const uint8_t H2CU[] = {
-  '0', '1', '2', '3', '4', '5', '6', '7',
-  '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
-};
-static_assert(std::extent<decltype(H2CU)>::value == 16, "");
-
-
 HexEncode::HexEncode(bool useUpperCase)
   : m_useUpperCase(useUpperCase)
 {
@@ -54,15 +42,7 @@ unique_ptr<Transform::OBuffer>
 HexEncode::toHex(const uint8_t* data, size_t dataLen)
 {
   auto encoded = make_unique<OBuffer>(dataLen * 2);
-  uint8_t* buf = encoded->data();
-  const uint8_t* encodePad = m_useUpperCase ? H2CU : H2CL;
-
-  for (size_t i = 0; i < dataLen; i++) {
-    buf[0] = encodePad[(data[i] >> 4) & 0x0F];
-    buf[1] = encodePad[data[i] & 0x0F];
-    buf += 2;
-  }
-
+  util::detail::encodeHex(data, dataLen, reinterpret_cast<char*>(encoded->data()), m_useUpperCase);
   return encoded;
 }
 
@@ -33,6 +33,9 @@ class PrivateKey;
 
 /**
  * @brief The module to sign data.
+ *
+ * Input is hashed as it arrives, without being buffered, so that a BufferSource taking a list
+ * of InputBuffers processes several discontiguous ranges as if they were one.
  */
 class SignerFilter : public Transform
 {
@@ -0,0 +1,65 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "span-sink.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace security {
+namespace transform {
+
+SpanSink::SpanSink(uint8_t* buf, size_t capacity, size_t& size)
+  : m_buf(buf)
+  , m_capacity(capacity)
+  , m_size(size)
+{
+  m_size = 0;
+}
+
+size_t
+SpanSink::doWrite(const uint8_t* buf, size_t size)
+{
+  if (size > m_capacity - m_size)
+    BOOST_THROW_EXCEPTION(Error(getIndex(), "Output exceeds the size of the memory range"));
+
+  if (size > 0) {
+    std::memcpy(m_buf + m_size, buf, size);
+    m_size += size;
+  }
+  return size;
+}
+
+void
+SpanSink::doEnd()
+{
+  // nothing to do.
+}
+
+unique_ptr<Sink>
+spanSink(uint8_t* buf, size_t capacity, size_t& size)
+{
+  return make_unique<SpanSink>(buf, capacity, size);
+}
+
+} // namespace transform
+} // namespace security
+} // namespace ndn
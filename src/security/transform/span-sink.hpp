@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_SECURITY_TRANSFORM_SPAN_SINK_HPP
+#define NDN_CXX_SECURITY_TRANSFORM_SPAN_SINK_HPP
+
+#include "transform-base.hpp"
+
+namespace ndn {
+namespace security {
+namespace transform {
+
+/**
+ * @brief A sink which writes output into a memory range owned by the caller.
+ *
+ * Unlike a StreamSink, this sink does not allocate or copy through an intermediate buffer.
+ * It is suitable when the maximum size of the output is known in advance, such as a digest
+ * or a signature.
+ */
+class SpanSink : public Sink
+{
+public:
+  /**
+   * @brief Create a sink which writes at most @p capacity bytes into @p buf
+   *
+   * @param[out] size receives the number of bytes written; it is updated as output arrives
+   */
+  SpanSink(uint8_t* buf, size_t capacity, size_t& size);
+
+private:
+  /**
+   * @brief Copy data into the memory range
+   *
+   * @return the same value as @p size
+   * @throw Error the memory range is too small
+   */
+  size_t
+  doWrite(const uint8_t* buf, size_t size) final;
+
+  /**
+   * @brief Finalize sink processing
+   */
+  void
+  doEnd() final;
+
+private:
+  uint8_t* m_buf;
+  size_t m_capacity;
+  size_t& m_size;
+};
+
+unique_ptr<Sink>
+spanSink(uint8_t* buf, size_t capacity, size_t& size);
+
+} // namespace transform
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_CXX_SECURITY_TRANSFORM_SPAN_SINK_HPP
@@ -36,6 +36,9 @@ class PublicKey;
  *
  * The next module in the chain is usually BoolSink.
  *
+ * Input is hashed as it arrives, without being buffered, so that a BufferSource taking a list
+ * of InputBuffers processes several discontiguous ranges as if they were one.
+ *
  * @note This module cannot be used to verify HMACs.
  */
 class VerifierFilter : public Transform
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -23,6 +23,8 @@
 #include "face.hpp"
 #include "lp/tags.hpp"
 
+#include <set>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -33,34 +35,51 @@ CertificateFetcherDirectFetch::CertificateFetcherDirectFetch(Face& face)
 }
 
 void
-CertificateFetcherDirectFetch::doFetch(const shared_ptr<CertificateRequest>& keyRequest,
-                                       const shared_ptr<ValidationState>& state,
-                                       const ValidationContinuation& continueValidation)
+CertificateFetcherDirectFetch::beforeExpressInterest(const Interest& interest,
+                                                     const ValidationStates& states)
 {
-  auto interestState = dynamic_pointer_cast<InterestValidationState>(state);
-  uint64_t incomingFaceId = 0;
-  if (interestState != nullptr) {
-    auto incomingFaceIdTag = interestState->getOriginalInterest().getTag<lp::IncomingFaceIdTag>();
-    if (incomingFaceIdTag != nullptr) {
-      incomingFaceId = incomingFaceIdTag->get();
-    }
-  }
-  else {
-    auto dataState = dynamic_pointer_cast<DataValidationState>(state);
-    auto incomingFaceIdTag = dataState->getOriginalData().getTag<lp::IncomingFaceIdTag>();
-    if (incomingFaceIdTag != nullptr) {
-      incomingFaceId = incomingFaceIdTag->get();
+  std::set<uint64_t> incomingFaceIds;
+  for (const auto& state : states) {
+    uint64_t incomingFaceId = getIncomingFaceId(*state);
+    if (incomingFaceId != 0 && incomingFaceIds.insert(incomingFaceId).second) {
+      expressDirectInterest(interest, incomingFaceId);
     }
   }
+}
+
+void
+CertificateFetcherDirectFetch::onJoinPendingRequest(const Interest& interest,
+                                                    const shared_ptr<ValidationState>& state)
+{
+  uint64_t incomingFaceId = getIncomingFaceId(*state);
   if (incomingFaceId != 0) {
-    Interest directInterest(keyRequest->m_interest);
-    directInterest.refreshNonce();
-    directInterest.setTag(make_shared<lp::NextHopFaceIdTag>(incomingFaceId));
-    m_face.expressInterest(directInterest, nullptr, nullptr, nullptr);
+    expressDirectInterest(interest, incomingFaceId);
   }
+}
 
-  // send infrastructure Interest
-  CertificateFetcherFromNetwork::doFetch(keyRequest, state, continueValidation);
+uint64_t
+CertificateFetcherDirectFetch::getIncomingFaceId(const ValidationState& state)
+{
+  shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag;
+  auto interestState = dynamic_cast<const InterestValidationState*>(&state);
+  if (interestState != nullptr) {
+    incomingFaceIdTag = interestState->getOriginalInterest().getTag<lp::IncomingFaceIdTag>();
+  }
+  else {
+    auto dataState = dynamic_cast<const DataValidationState*>(&state);
+    incomingFaceIdTag = dataState->getOriginalData().getTag<lp::IncomingFaceIdTag>();
+  }
+  return incomingFaceIdTag == nullptr ? 0 : incomingFaceIdTag->get();
+}
+
+void
+CertificateFetcherDirectFetch::expressDirectInterest(const Interest& interest,
+                                                     uint64_t incomingFaceId)
+{
+  Interest directInterest(interest);
+  directInterest.refreshNonce();
+  directInterest.setTag(make_shared<lp::NextHopFaceIdTag>(incomingFaceId));
+  m_face.expressInterest(directInterest, nullptr, nullptr, nullptr);
 }
 
 } // namespace v2
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -36,6 +36,11 @@ namespace v2 {
  * this fetcher will send a "direct Interest" to fetch certificates from the face where the original
  * packet was received, in addition to fetching from the infrastructure. The application must
  * enable NextHopFaceId privilege on the face used by this fetcher prior to the validation.
+ *
+ * Direct Interests are sent along with every (re)transmission of the infrastructure Interest,
+ * one towards each distinct incoming face of the packets waiting for the certificate. When the
+ * validation of a packet joins a fetch that is already pending, a direct Interest is sent
+ * towards the incoming face of that packet.
  */
 class CertificateFetcherDirectFetch : public CertificateFetcherFromNetwork
 {
@@ -45,8 +50,21 @@ public:
 
 protected:
   void
-  doFetch(const shared_ptr<CertificateRequest>& keyRequest, const shared_ptr<ValidationState>& state,
-          const ValidationContinuation& continueValidation) override;
+  beforeExpressInterest(const Interest& interest, const ValidationStates& states) override;
+
+  void
+  onJoinPendingRequest(const Interest& interest,
+                       const shared_ptr<ValidationState>& state) override;
+
+private:
+  /**
+   * @return the IncomingFaceId of the packet validated by @p state, or 0 if it has none
+   */
+  static uint64_t
+  getIncomingFaceId(const ValidationState& state);
+
+  void
+  expressDirectInterest(const Interest& interest, uint64_t incomingFaceId);
 };
 
 } // namespace v2
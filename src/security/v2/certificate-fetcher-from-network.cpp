@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -22,6 +22,7 @@
 #include "certificate-fetcher-from-network.hpp"
 #include "face.hpp"
 #include "util/logger.hpp"
+#include "util/random.hpp"
 
 namespace ndn {
 namespace security {
@@ -32,9 +33,22 @@ NDN_LOG_INIT(ndn.security.v2.CertificateFetcher);
 #define NDN_LOG_DEBUG_DEPTH(x) NDN_LOG_DEBUG(std::string(state->getDepth() + 1, '>') << " " << x)
 #define NDN_LOG_TRACE_DEPTH(x) NDN_LOG_TRACE(std::string(state->getDepth() + 1, '>') << " " << x)
 
+const time::milliseconds CertificateFetcherFromNetwork::INITIAL_RETRY_BACKOFF = 200_ms;
+const time::milliseconds CertificateFetcherFromNetwork::MAX_RETRY_BACKOFF = 10_s;
+
 CertificateFetcherFromNetwork::CertificateFetcherFromNetwork(Face& face)
   : m_face(face)
+  , m_scheduler(face.getIoService())
+{
+}
+
+CertificateFetcherFromNetwork::~CertificateFetcherFromNetwork()
 {
+  for (const auto& entry : m_pendingRequests) {
+    if (entry.second.pendingInterest != nullptr) {
+      m_face.removePendingInterest(entry.second.pendingInterest);
+    }
+  }
 }
 
 void
@@ -42,73 +56,164 @@ CertificateFetcherFromNetwork::doFetch(const shared_ptr<CertificateRequest>& cer
                                        const shared_ptr<ValidationState>& state,
                                        const ValidationContinuation& continueValidation)
 {
-  m_face.expressInterest(certRequest->m_interest,
-                         [=] (const Interest& interest, const Data& data) {
-                           dataCallback(data, certRequest, state, continueValidation);
-                         },
-                         [=] (const Interest& interest, const lp::Nack& nack) {
-                           nackCallback(nack, certRequest, state, continueValidation);
-                         },
-                         [=] (const Interest& interest) {
-                           timeoutCallback(certRequest, state, continueValidation);
-                         });
+  const Name& name = certRequest->m_interest.getName();
+
+  auto it = m_pendingRequests.find(name);
+  if (it != m_pendingRequests.end()) {
+    NDN_LOG_DEBUG_DEPTH("Joining pending fetch of certificate " << name);
+    it->second.waiters.emplace_back(state, continueValidation);
+    onJoinPendingRequest(it->second.interest, state);
+    return;
+  }
+
+  it = m_pendingRequests.emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(name),
+                                 std::forward_as_tuple(m_scheduler)).first;
+  PendingRequest& request = it->second;
+  request.interest = certRequest->m_interest;
+  request.nRetriesLeft = certRequest->m_nRetriesLeft;
+  request.waiters.emplace_back(state, continueValidation);
+
+  expressCertInterest(name);
+}
+
+void
+CertificateFetcherFromNetwork::beforeExpressInterest(const Interest& interest,
+                                                     const ValidationStates& states)
+{
+}
+
+void
+CertificateFetcherFromNetwork::onJoinPendingRequest(const Interest& interest,
+                                                    const shared_ptr<ValidationState>& state)
+{
+}
+
+void
+CertificateFetcherFromNetwork::expressCertInterest(const Name& name)
+{
+  auto it = m_pendingRequests.find(name);
+  BOOST_ASSERT(it != m_pendingRequests.end());
+  PendingRequest& request = it->second;
+
+  if (request.nRetries > 0) {
+    request.interest.refreshNonce();
+  }
+  ValidationStates states;
+  states.reserve(request.waiters.size());
+  for (const auto& waiter : request.waiters) {
+    states.push_back(waiter.first);
+  }
+  beforeExpressInterest(request.interest, states);
+
+  request.pendingInterest =
+    m_face.expressInterest(request.interest,
+                           [=] (const Interest& interest, const Data& data) {
+                             dataCallback(name, data);
+                           },
+                           [=] (const Interest& interest, const lp::Nack& nack) {
+                             nackCallback(name, nack);
+                           },
+                           [=] (const Interest& interest) {
+                             timeoutCallback(name);
+                           });
 }
 
 void
-CertificateFetcherFromNetwork::dataCallback(const Data& data,
-                                            const shared_ptr<CertificateRequest>& certRequest,
-                                            const shared_ptr<ValidationState>& state,
-                                            const ValidationContinuation& continueValidation)
+CertificateFetcherFromNetwork::dataCallback(const Name& name, const Data& data)
 {
-  NDN_LOG_DEBUG_DEPTH("Fetched certificate from network " << data.getName());
+  auto it = m_pendingRequests.find(name);
+  if (it == m_pendingRequests.end()) {
+    return;
+  }
+  // continuations may start new fetches, so detach the waiters before invoking them
+  auto waiters = std::move(it->second.waiters);
+  m_pendingRequests.erase(it);
+
+  NDN_LOG_DEBUG("Fetched certificate from network " << data.getName()
+                << " for " << waiters.size() << " validation state(s)");
 
   Certificate cert;
   try {
     cert = Certificate(data);
   }
   catch (const tlv::Error& e) {
-    return state->fail({ValidationError::Code::MALFORMED_CERT, "Fetched a malformed certificate "
-                        "`" + data.getName().toUri() + "` (" + e.what() + ")"});
+    for (const auto& waiter : waiters) {
+      waiter.first->fail({ValidationError::Code::MALFORMED_CERT, "Fetched a malformed certificate "
+                          "`" + data.getName().toUri() + "` (" + e.what() + ")"});
+    }
+    return;
+  }
+
+  for (const auto& waiter : waiters) {
+    waiter.second(cert, waiter.first);
   }
-  continueValidation(cert, state);
 }
 
 void
-CertificateFetcherFromNetwork::nackCallback(const lp::Nack& nack,
-                                            const shared_ptr<CertificateRequest>& certRequest,
-                                            const shared_ptr<ValidationState>& state,
-                                            const ValidationContinuation& continueValidation)
+CertificateFetcherFromNetwork::nackCallback(const Name& name, const lp::Nack& nack)
 {
-  NDN_LOG_DEBUG_DEPTH("NACK (" << nack.getReason() <<  ") while fetching certificate "
-                      << certRequest->m_interest.getName());
+  NDN_LOG_DEBUG("NACK (" << nack.getReason() <<  ") while fetching certificate " << name);
 
-  --certRequest->m_nRetriesLeft;
-  if (certRequest->m_nRetriesLeft >= 0) {
-    // TODO implement delay for the the next fetch
-    fetch(certRequest, state, continueValidation);
+  auto it = m_pendingRequests.find(name);
+  if (it != m_pendingRequests.end()) {
+    retryOrFail(it);
   }
-  else {
-    state->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch certificate after all "
-                 "retries `" + certRequest->m_interest.getName().toUri() + "`"});
+}
+
+void
+CertificateFetcherFromNetwork::timeoutCallback(const Name& name)
+{
+  NDN_LOG_DEBUG("Timeout while fetching certificate " << name);
+
+  auto it = m_pendingRequests.find(name);
+  if (it != m_pendingRequests.end()) {
+    retryOrFail(it);
   }
 }
 
 void
-CertificateFetcherFromNetwork::timeoutCallback(const shared_ptr<CertificateRequest>& certRequest,
-                                               const shared_ptr<ValidationState>& state,
-                                               const ValidationContinuation& continueValidation)
+CertificateFetcherFromNetwork::retryOrFail(PendingRequestTable::iterator it)
 {
-  NDN_LOG_DEBUG_DEPTH("Timeout while fetching certificate " << certRequest->m_interest.getName()
-                      << ", retrying");
+  PendingRequest& request = it->second;
+  request.pendingInterest = nullptr;
+
+  --request.nRetriesLeft;
+  if (request.nRetriesLeft >= 0) {
+    ++request.nRetries;
+    time::milliseconds delay = getRetryDelay(request.nRetries);
+    NDN_LOG_TRACE("Retrying " << it->first << " in " << delay);
+
+    Name name = it->first;
+    request.retryEvent = m_scheduler.scheduleEvent(delay, [this, name] {
+      expressCertInterest(name);
+    });
+    return;
+  }
 
-  --certRequest->m_nRetriesLeft;
-  if (certRequest->m_nRetriesLeft >= 0) {
-    fetch(certRequest, state, continueValidation);
+  auto waiters = std::move(request.waiters);
+  Name name = it->first;
+  m_pendingRequests.erase(it);
+  m_certStorage->cacheUnretrievableCertName(name);
+
+  for (const auto& waiter : waiters) {
+    waiter.first->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT,
+                        "Cannot fetch certificate after all retries `" + name.toUri() + "`"});
   }
-  else {
-    state->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch certificate after all "
-                 "retries `" + certRequest->m_interest.getName().toUri() + "`"});
+}
+
+time::milliseconds
+CertificateFetcherFromNetwork::getRetryDelay(int nRetries)
+{
+  time::milliseconds backoff = INITIAL_RETRY_BACKOFF;
+  for (int i = 1; i < nRetries && backoff < MAX_RETRY_BACKOFF; ++i) {
+    backoff *= 2;
   }
+  backoff = std::min(backoff, MAX_RETRY_BACKOFF);
+
+  auto half = backoff.count() / 2;
+  auto jitter = random::generateWord32() % std::max<time::milliseconds::rep>(half, 1);
+  return time::milliseconds(half + jitter);
 }
 
 } // namespace v2
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -23,9 +23,14 @@
 #define NDN_SECURITY_V2_CERTIFICATE_FETCHER_FROM_NETWORK_HPP
 
 #include "certificate-fetcher.hpp"
+#include "../../util/scheduler-scoped-event-id.hpp"
+
+#include <map>
 
 namespace ndn {
 
+class PendingInterestId;
+
 namespace lp {
 class Nack;
 } // namespace lp
@@ -35,6 +40,10 @@ namespace v2 {
 
 /**
  * @brief Fetch missing keys from the network
+ *
+ * Concurrent requests for the same certificate name are merged into a single Interest, and the
+ * retrieved certificate (or the failure) is delivered to every waiting validation state.
+ * After a Nack or a timeout, the Interest is retransmitted after a randomized exponential backoff.
  */
 class CertificateFetcherFromNetwork : public CertificateFetcher
 {
@@ -42,43 +51,113 @@ public:
   explicit
   CertificateFetcherFromNetwork(Face& face);
 
+  ~CertificateFetcherFromNetwork() override;
+
 protected:
+  using ValidationStates = std::vector<shared_ptr<ValidationState>>;
+
   void
-  doFetch(const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
+  doFetch(const shared_ptr<CertificateRequest>& certRequest,
+          const shared_ptr<ValidationState>& state,
           const ValidationContinuation& continueValidation) override;
 
+  /**
+   * @brief Invoked right before the Interest of a pending request is expressed, including retries
+   *
+   * @param interest the Interest that will be sent towards the infrastructure
+   * @param states all validation states waiting for the request
+   */
+  virtual void
+  beforeExpressInterest(const Interest& interest, const ValidationStates& states);
+
+  /**
+   * @brief Invoked when a validation state joins a request whose Interest is already pending
+   *
+   * @param interest the Interest of the pending request
+   * @param state the joining validation state
+   */
+  virtual void
+  onJoinPendingRequest(const Interest& interest, const shared_ptr<ValidationState>& state);
+
 private:
+  /**
+   * @brief Outstanding fetch of one certificate name, shared by all validation states
+   *        waiting for it
+   */
+  struct PendingRequest
+  {
+    explicit
+    PendingRequest(util::Scheduler& scheduler)
+      : nRetriesLeft(0)
+      , nRetries(0)
+      , pendingInterest(nullptr)
+      , retryEvent(scheduler)
+    {
+    }
+
+    Interest interest;
+    std::vector<std::pair<shared_ptr<ValidationState>, ValidationContinuation>> waiters;
+    int nRetriesLeft;
+    int nRetries;
+    const PendingInterestId* pendingInterest;
+    util::scheduler::ScopedEventId retryEvent;
+  };
+
+  using PendingRequestTable = std::map<Name, PendingRequest>;
+
+  /**
+   * @brief Express (or re-express) the Interest of the pending request for @p name
+   */
+  void
+  expressCertInterest(const Name& name);
+
   /**
    * @brief Callback invoked when certificate is retrieved.
+   *
+   * Delivers the certificate to all states waiting for @p name.
    */
   void
-  dataCallback(const Data& data,
-               const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-               const ValidationContinuation& continueValidation);
+  dataCallback(const Name& name, const Data& data);
 
   /**
    * @brief Callback invoked when interest for fetching certificate gets NACKed.
    *
-   * It will retry if certRequest->m_nRetriesLeft > 0
-   *
-   * @todo Delay retry for some amount of time
+   * It will retry after a backoff delay if the request has retries left.
    */
   void
-  nackCallback(const lp::Nack& nack,
-               const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-               const ValidationContinuation& continueValidation);
+  nackCallback(const Name& name, const lp::Nack& nack);
 
   /**
    * @brief Callback invoked when interest for fetching certificate times out.
    *
-   * It will retry if certRequest->m_nRetriesLeft > 0
+   * It will retry after a backoff delay if the request has retries left.
    */
   void
-  timeoutCallback(const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
-                  const ValidationContinuation& continueValidation);
+  timeoutCallback(const Name& name);
+
+  /**
+   * @brief Schedule a retransmission, or fail all waiting states if no retries are left
+   */
+  void
+  retryOrFail(PendingRequestTable::iterator it);
+
+  /**
+   * @return delay before retransmission number @p nRetries (1-based), drawn uniformly
+   *         from [backoff/2, backoff) where backoff doubles on every retry up to a maximum
+   */
+  static time::milliseconds
+  getRetryDelay(int nRetries);
 
 protected:
   Face& m_face;
+
+private:
+  util::Scheduler m_scheduler;
+  PendingRequestTable m_pendingRequests;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const time::milliseconds INITIAL_RETRY_BACKOFF;
+  static const time::milliseconds MAX_RETRY_BACKOFF;
 };
 
 } // namespace v2
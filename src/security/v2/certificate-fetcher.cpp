@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -55,6 +55,13 @@ CertificateFetcher::fetch(const shared_ptr<CertificateRequest>& certRequest,
     continueValidation(*cert, state);
     return;
   }
+  if (m_certStorage->isCertUnretrievable(certRequest->m_interest.getName())) {
+    NDN_LOG_DEBUG_DEPTH("Certificate was recently found unretrievable "
+                        << certRequest->m_interest.getName());
+    state->fail({ValidationError::Code::CANNOT_RETRIEVE_CERT, "Certificate was recently found "
+                 "unretrievable `" + certRequest->m_interest.getName().toUri() + "`"});
+    return;
+  }
   doFetch(certRequest, state,
           [continueValidation, this] (const Certificate& cert, const shared_ptr<ValidationState>& state) {
             m_certStorage->cacheUnverifiedCert(Certificate(cert));
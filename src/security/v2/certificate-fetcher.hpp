@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -59,7 +59,9 @@ public:
    * @pre m_certStorage != nullptr
    *
    * If the requested certificate exists in the storage, then this method will immediately call
-   * continueValidation with the certification.  If certificate is not available, the
+   * continueValidation with the certification.  If the certificate name was recently recorded
+   * as unretrievable in the storage, state->fail() is called immediately with CANNOT_RETRIEVE_CERT
+   * error code.  If certificate is not available, the
    * implementation-specific doFetch will be called to asynchronously fetch certificate.  The
    * successfully retrieved certificate will be automatically added to the unverified cache of
    * the certificate storage.
@@ -28,6 +28,7 @@ namespace v2 {
 CertificateStorage::CertificateStorage()
   : m_verifiedCertCache(1_h)
   , m_unverifiedCertCache(5_min)
+  , m_unretrievableCertCache(1_min, 1000)
 {
 }
 
@@ -64,6 +65,12 @@ CertificateStorage::loadAnchor(const std::string& groupId, const std::string& ce
   m_trustAnchors.insert(groupId, certfilePath, refreshPeriod, isDir);
 }
 
+void
+CertificateStorage::enableAnchorWatch(boost::asio::io_service& io)
+{
+  m_trustAnchors.enableWatch(io);
+}
+
 void
 CertificateStorage::resetAnchors()
 {
@@ -88,6 +95,24 @@ CertificateStorage::cacheUnverifiedCert(Certificate&& cert)
   m_unverifiedCertCache.insert(std::move(cert));
 }
 
+void
+CertificateStorage::cacheUnretrievableCertName(const Name& certName)
+{
+  m_unretrievableCertCache.insert(certName);
+}
+
+bool
+CertificateStorage::isCertUnretrievable(const Name& certName)
+{
+  return m_unretrievableCertCache.find(certName);
+}
+
+void
+CertificateStorage::resetUnretrievableCerts()
+{
+  m_unretrievableCertCache.clear();
+}
+
 const TrustAnchorContainer&
 CertificateStorage::getTrustAnchors() const
 {
@@ -106,6 +131,12 @@ CertificateStorage::getUnverifiedCertCache() const
   return m_unverifiedCertCache;
 }
 
+const NegativeCertificateCache&
+CertificateStorage::getUnretrievableCertCache() const
+{
+  return m_unretrievableCertCache;
+}
+
 } // namespace v2
 } // namespace security
 } // namespace ndn
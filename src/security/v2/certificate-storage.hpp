@@ -24,6 +24,7 @@
 
 #include "certificate.hpp"
 #include "certificate-cache.hpp"
+#include "negative-certificate-cache.hpp"
 #include "trust-anchor-container.hpp"
 
 namespace ndn {
@@ -31,7 +32,8 @@ namespace security {
 namespace v2 {
 
 /**
- * @brief Storage for trusted anchors, verified certificate cache, and unverified certificate cache.
+ * @brief Storage for trusted anchors, verified certificate cache, unverified certificate cache,
+ *        and names of certificates that recently could not be retrieved.
  */
 class CertificateStorage : noncopyable
 {
@@ -64,6 +66,22 @@ public:
   void
   cacheUnverifiedCert(Certificate&& cert);
 
+  /**
+   * @brief Remember for a period of time (1 minute) that a certificate cannot be retrieved
+   * @param certName  Name of the requested certificate, as in the Interest for it
+   *
+   * While the name is remembered, certificate fetchers fail requests for it without sending
+   * any Interest.  At most 1000 names are remembered.
+   */
+  void
+  cacheUnretrievableCertName(const Name& certName);
+
+  /**
+   * @brief Check if the certificate named @p certName recently could not be retrieved
+   */
+  bool
+  isCertUnretrievable(const Name& certName);
+
   /**
    * @return Trust anchor container
    */
@@ -82,6 +100,12 @@ public:
   const CertificateCache&
   getUnverifiedCertCache() const;
 
+  /**
+   * @return Cache of names of unretrievable certificates, including its hit counters
+   */
+  const NegativeCertificateCache&
+  getUnretrievableCertCache() const;
+
 protected:
   /**
    * @brief load static trust anchor.
@@ -109,6 +133,13 @@ protected:
   loadAnchor(const std::string& groupId, const std::string& certfilePath,
              time::nanoseconds refreshPeriod, bool isDir = false);
 
+  /**
+   * @brief watch the paths of subsequently loaded dynamic trust anchors for changes on @p io
+   * @sa TrustAnchorContainer::enableWatch
+   */
+  void
+  enableAnchorWatch(boost::asio::io_service& io);
+
   /**
    * @brief remove any previously loaded static or dynamic trust anchor
    */
@@ -130,10 +161,17 @@ protected:
   void
   resetVerifiedCerts();
 
+  /**
+   * @brief Forget all names of unretrievable certificates
+   */
+  void
+  resetUnretrievableCerts();
+
 protected:
   TrustAnchorContainer m_trustAnchors;
   CertificateCache m_verifiedCertCache;
   CertificateCache m_unverifiedCertCache;
+  NegativeCertificateCache m_unretrievableCertCache;
 };
 
 } // namespace v2
@@ -462,6 +462,32 @@ KeyChain::sign(Interest& interest, const SigningInfo& params)
   interest.setName(signedName);
 }
 
+void
+KeyChain::sign(std::vector<Interest>& interests, const SigningInfo& params)
+{
+  if (interests.empty()) {
+    return;
+  }
+
+  Name keyName;
+  SignatureInfo sigInfo;
+  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+  name::Component sigInfoComponent(Block(tlv::GenericNameComponent, sigInfo.wireEncode()));
+
+  for (Interest& interest : interests) {
+    Name signedName = interest.getName();
+    signedName.append(sigInfoComponent); // signatureInfo
+
+    const Block& signedNameWire = signedName.wireEncode();
+    Block sigValue = sign(signedNameWire.value(), signedNameWire.value_size(),
+                          keyName, params.getDigestAlgorithm());
+
+    sigValue.encode();
+    signedName.append(sigValue); // signatureValue
+    interest.setName(signedName);
+  }
+}
+
 Block
 KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params)
 {
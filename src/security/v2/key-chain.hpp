@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -278,6 +278,23 @@ public: // signing
   void
   sign(Interest& interest, const SigningInfo& params = getDefaultSigningInfo());
 
+  /**
+   * @brief Sign a batch of interests according to the same signing information
+   *
+   * The result is the same as signing each interest with sign(Interest&, const SigningInfo&),
+   * but the signing key and the SignatureInfo block are determined and encoded only once
+   * for the whole batch.
+   *
+   * @param interests The interests to sign
+   * @param params The signing parameters.
+   * @throw Error signing fails
+   * @throw InvalidSigningInfoError invalid @p params is specified or specified identity, key,
+   *                                or certificate does not exist
+   * @see SigningInfo
+   */
+  void
+  sign(std::vector<Interest>& interests, const SigningInfo& params = getDefaultSigningInfo());
+
   /**
    * @brief Sign buffer according to the supplied signing information @p params
    *
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "negative-certificate-cache.hpp"
+#include "util/logger.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+NDN_LOG_INIT(ndn.security.v2.NegativeCertificateCache);
+
+time::nanoseconds
+NegativeCertificateCache::getDefaultTtl()
+{
+  return 1_min;
+}
+
+size_t
+NegativeCertificateCache::getDefaultCapacity()
+{
+  return 1000;
+}
+
+NegativeCertificateCache::NegativeCertificateCache(time::nanoseconds ttl, size_t capacity)
+  : m_ttl(ttl)
+  , m_capacity(capacity)
+  , m_nHits(0)
+  , m_nMisses(0)
+{
+  BOOST_ASSERT(m_capacity > 0);
+}
+
+void
+NegativeCertificateCache::insert(const Name& certName)
+{
+  refresh();
+
+  auto removalTime = time::steady_clock::now() + m_ttl;
+  auto& byName = m_names.get<1>();
+  auto it = byName.find(certName);
+  if (it != byName.end()) {
+    byName.modify(it, [removalTime] (Entry& entry) { entry.removalTime = removalTime; });
+    return;
+  }
+
+  if (m_names.size() >= m_capacity) {
+    NDN_LOG_DEBUG("Evicting " << m_names.get<0>().begin()->name);
+    m_names.get<0>().erase(m_names.get<0>().begin());
+  }
+
+  NDN_LOG_DEBUG("Adding " << certName << ", will remove in "
+                << time::duration_cast<time::seconds>(m_ttl));
+  m_names.insert(Entry{certName, removalTime});
+}
+
+void
+NegativeCertificateCache::erase(const Name& certName)
+{
+  m_names.get<1>().erase(certName);
+}
+
+void
+NegativeCertificateCache::clear()
+{
+  m_names.clear();
+}
+
+bool
+NegativeCertificateCache::find(const Name& certName)
+{
+  refresh();
+
+  if (m_names.get<1>().count(certName) > 0) {
+    ++m_nHits;
+    return true;
+  }
+  ++m_nMisses;
+  return false;
+}
+
+size_t
+NegativeCertificateCache::size() const
+{
+  return m_names.size();
+}
+
+void
+NegativeCertificateCache::refresh()
+{
+  auto now = time::steady_clock::now();
+
+  auto& byTime = m_names.get<0>();
+  while (!byTime.empty() && byTime.begin()->removalTime <= now) {
+    byTime.erase(byTime.begin());
+  }
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_NEGATIVE_CERTIFICATE_CACHE_HPP
+#define NDN_SECURITY_V2_NEGATIVE_CERTIFICATE_CACHE_HPP
+
+#include "../../name.hpp"
+#include "../../util/time.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Represents a bounded container of certificate names that could not be retrieved.
+ *
+ * A name is removed @p ttl after it has been added to the cache.  When the cache is full,
+ * inserting a new name evicts the name that is closest to its removal time.
+ */
+class NegativeCertificateCache : noncopyable
+{
+public:
+  /**
+   * @brief Create a negative certificate cache
+   *
+   * @param ttl the time a name stays in the cache (default: 1 minute)
+   * @param capacity the maximum number of names in the cache (default: 1000), must be positive
+   */
+  explicit
+  NegativeCertificateCache(time::nanoseconds ttl = getDefaultTtl(),
+                           size_t capacity = getDefaultCapacity());
+
+  /**
+   * @brief Record that the certificate named @p certName could not be retrieved
+   *
+   * If @p certName is already in the cache, its removal time is extended.
+   */
+  void
+  insert(const Name& certName);
+
+  /**
+   * @brief Remove @p certName from the cache
+   */
+  void
+  erase(const Name& certName);
+
+  /**
+   * @brief Remove all names from the cache
+   */
+  void
+  clear();
+
+  /**
+   * @brief Check whether @p certName has recently been found unretrievable
+   *
+   * Each lookup increments either the hit or the miss counter.
+   */
+  bool
+  find(const Name& certName);
+
+  size_t
+  size() const;
+
+  /**
+   * @return number of lookups that found the name in the cache
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /**
+   * @return number of lookups that did not find the name in the cache
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+public:
+  static time::nanoseconds
+  getDefaultTtl();
+
+  static size_t
+  getDefaultCapacity();
+
+private:
+  struct Entry
+  {
+    Name name;
+    time::steady_clock::TimePoint removalTime;
+  };
+
+  /**
+   * @brief Remove all outdated entries
+   */
+  void
+  refresh();
+
+private:
+  typedef boost::multi_index::multi_index_container<
+    Entry,
+    boost::multi_index::indexed_by<
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::member<Entry, time::steady_clock::TimePoint, &Entry::removalTime>
+      >,
+      boost::multi_index::ordered_unique<
+        boost::multi_index::member<Entry, Name, &Entry::name>
+      >
+    >
+  > NameIndex;
+
+  NameIndex m_names;
+  time::nanoseconds m_ttl;
+  size_t m_capacity;
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_NEGATIVE_CERTIFICATE_CACHE_HPP
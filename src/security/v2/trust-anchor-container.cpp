@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -64,10 +64,24 @@ TrustAnchorContainer::insert(const std::string& groupId, const boost::filesystem
                              time::nanoseconds refreshPeriod, bool isDir)
 {
   if (m_groups.count(groupId) != 0) {
-    BOOST_THROW_EXCEPTION(Error("Cannot create dynamic group, because group " + groupId + " already exists"));
+    BOOST_THROW_EXCEPTION(Error("Cannot create dynamic group, because group " + groupId +
+                                " already exists"));
   }
 
-  m_groups.insert(make_shared<DynamicTrustAnchorGroup>(m_anchors, groupId, path, refreshPeriod, isDir));
+  if (m_io == nullptr) {
+    m_groups.insert(make_shared<DynamicTrustAnchorGroup>(m_anchors, groupId, path,
+                                                         refreshPeriod, isDir));
+  }
+  else {
+    m_groups.insert(make_shared<DynamicTrustAnchorGroup>(m_anchors, groupId, path,
+                                                         refreshPeriod, isDir, *m_io));
+  }
+}
+
+void
+TrustAnchorContainer::enableWatch(boost::asio::io_service& io)
+{
+  m_io = &io;
 }
 
 void
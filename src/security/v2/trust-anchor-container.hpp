@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -95,6 +95,18 @@ public:
   insert(const std::string& groupId, const boost::filesystem::path& path,
          time::nanoseconds refreshPeriod, bool isDir = false);
 
+  /**
+   * @brief Watch the paths of dynamic anchor groups for changes on @p io
+   *
+   * Dynamic groups inserted after this call reload only the changed certificate files when
+   * the platform supports filesystem watches (inotify), instead of reloading all files every
+   * refresh period during `find` calls.  Existing groups are not affected.
+   *
+   * @param io  io_service on which changes are processed, must outlive the container
+   */
+  void
+  enableWatch(boost::asio::io_service& io);
+
   /**
    * @brief Remove all static or dynamic anchors
    */
@@ -177,6 +189,7 @@ private:
 
   GroupContainer m_groups;
   AnchorContainer m_anchors;
+  boost::asio::io_service* m_io = nullptr;
 };
 
 } // namespace v2
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,11 +24,21 @@
 #include "util/io.hpp"
 #include "util/logger.hpp"
 
+#include <boost/asio/io_service.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#ifdef NDN_CXX_HAVE_INOTIFY
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <sys/inotify.h>
+#endif // NDN_CXX_HAVE_INOTIFY
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -84,6 +94,168 @@ StaticTrustAnchorGroup::remove(const Name& certName)
 
 /////////////
 
+#ifdef NDN_CXX_HAVE_INOTIFY
+
+/**
+ * @brief Watches the directory of a DynamicTrustAnchorGroup with inotify
+ */
+class DynamicTrustAnchorGroup::Watcher
+{
+public:
+  Watcher(DynamicTrustAnchorGroup& group, boost::asio::io_service& io)
+    : m_group(group)
+    , m_stream(io)
+    , m_wd(-1)
+  {
+  }
+
+  bool
+  isWatching() const
+  {
+    return m_wd >= 0;
+  }
+
+  /**
+   * @brief Try to establish the watch
+   */
+  void
+  start()
+  {
+    if (!m_stream.is_open()) {
+      int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (fd < 0) {
+        NDN_LOG_WARN("Cannot initialize inotify: " << std::strerror(errno));
+        return;
+      }
+      m_stream.assign(fd);
+    }
+
+    m_dir = m_group.m_isDir ? m_group.m_path : m_group.m_path.parent_path();
+    if (m_dir.empty()) {
+      m_dir = ".";
+    }
+    m_wd = ::inotify_add_watch(m_stream.native_handle(), m_dir.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE |
+                               IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+    if (m_wd < 0) {
+      NDN_LOG_TRACE("Cannot watch " << m_dir << ": " << std::strerror(errno));
+      return;
+    }
+
+    NDN_LOG_TRACE("Watching " << m_dir);
+    asyncRead();
+  }
+
+private:
+  void
+  asyncRead()
+  {
+    m_stream.async_read_some(boost::asio::buffer(m_buffer),
+      [this] (const boost::system::error_code& error, size_t nBytesRead) {
+        if (error) {
+          if (error != boost::asio::error::operation_aborted) {
+            NDN_LOG_WARN("Cannot read inotify events: " << error.message());
+          }
+          return;
+        }
+        processEvents(nBytesRead);
+      });
+  }
+
+  void
+  processEvents(size_t nBytesRead)
+  {
+    bool needReloadAll = false;
+    bool isDirGone = false;
+
+    for (size_t offset = 0; offset + sizeof(inotify_event) <= nBytesRead; ) {
+      inotify_event event;
+      std::memcpy(&event, m_buffer.data() + offset, sizeof(event));
+      const char* eventName = reinterpret_cast<const char*>(m_buffer.data() + offset +
+                                                            sizeof(event));
+      offset += sizeof(event) + event.len;
+
+      if (event.mask & IN_Q_OVERFLOW) {
+        needReloadAll = true;
+        continue;
+      }
+      if (event.wd != m_wd) {
+        continue;
+      }
+      if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+        isDirGone = true;
+        continue;
+      }
+      if (event.len == 0 || (event.mask & IN_ISDIR)) {
+        continue;
+      }
+
+      boost::filesystem::path file = m_dir / std::string(eventName);
+      if (!m_group.m_isDir && file.filename() != m_group.m_path.filename()) {
+        continue;
+      }
+      if (!m_group.m_isDir) {
+        file = m_group.m_path;
+      }
+
+      if (event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+        m_group.reloadFile(file);
+      }
+      else if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+        m_group.removeFile(file);
+      }
+    }
+
+    if (isDirGone) {
+      NDN_LOG_TRACE("Watched directory " << m_dir << " is gone");
+      if (m_wd >= 0) {
+        ::inotify_rm_watch(m_stream.native_handle(), m_wd);
+        m_wd = -1;
+      }
+      // fall back to periodic reloading, which re-establishes the watch when possible
+      m_group.m_expireTime = time::steady_clock::TimePoint::min();
+      m_group.refresh();
+      return;
+    }
+
+    if (needReloadAll) {
+      NDN_LOG_TRACE("inotify queue overflow, reloading " << m_dir);
+      m_group.reloadAll();
+    }
+    asyncRead();
+  }
+
+private:
+  DynamicTrustAnchorGroup& m_group;
+  boost::asio::posix::stream_descriptor m_stream;
+  int m_wd;
+  boost::filesystem::path m_dir;
+  std::array<uint8_t, 4096> m_buffer;
+};
+
+#else // NDN_CXX_HAVE_INOTIFY
+
+class DynamicTrustAnchorGroup::Watcher
+{
+public:
+  Watcher(DynamicTrustAnchorGroup&, boost::asio::io_service&)
+  {
+  }
+
+  bool
+  isWatching() const
+  {
+    return false;
+  }
+
+  void
+  start()
+  {
+  }
+};
+
+#endif // NDN_CXX_HAVE_INOTIFY
+
 DynamicTrustAnchorGroup::DynamicTrustAnchorGroup(CertContainerInterface& certContainer, const std::string& id,
                                                  const boost::filesystem::path& path,
                                                  time::nanoseconds refreshPeriod, bool isDir)
@@ -101,27 +273,65 @@ DynamicTrustAnchorGroup::DynamicTrustAnchorGroup(CertContainerInterface& certCon
   refresh();
 }
 
+DynamicTrustAnchorGroup::DynamicTrustAnchorGroup(CertContainerInterface& certContainer, const std::string& id,
+                                                 const boost::filesystem::path& path,
+                                                 time::nanoseconds refreshPeriod, bool isDir,
+                                                 boost::asio::io_service& io)
+  : TrustAnchorGroup(certContainer, id)
+  , m_isDir(isDir)
+  , m_path(path)
+  , m_refreshPeriod(refreshPeriod)
+  , m_watcher(make_unique<Watcher>(*this, io))
+{
+  if (refreshPeriod <= time::nanoseconds::zero()) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Refresh period for the dynamic group must be positive"));
+  }
+
+  NDN_LOG_TRACE("Create watched dynamic trust anchor group " << id << " for file/dir " << path
+                << " with fallback refresh time " << refreshPeriod);
+  refresh();
+}
+
+DynamicTrustAnchorGroup::~DynamicTrustAnchorGroup() = default;
+
+bool
+DynamicTrustAnchorGroup::isWatching() const
+{
+  return m_watcher != nullptr && m_watcher->isWatching();
+}
+
 void
 DynamicTrustAnchorGroup::refresh()
 {
+  if (isWatching()) {
+    return;
+  }
   if (m_expireTime > time::steady_clock::now()) {
     return;
   }
   m_expireTime = time::steady_clock::now() + m_refreshPeriod;
-  NDN_LOG_TRACE("Reloading dynamic trust anchor group");
 
-  std::set<Name> oldAnchorNames = m_anchorNames;
+  if (m_watcher != nullptr) {
+    // establish the watch before the full reload, so that no change goes unnoticed
+    m_watcher->start();
+  }
+  reloadAll();
+}
+
+void
+DynamicTrustAnchorGroup::reloadAll()
+{
+  NDN_LOG_TRACE("Reloading dynamic trust anchor group");
 
-  auto loadCert = [this, &oldAnchorNames] (const fs::path& file) {
+  std::map<fs::path, Name> fileAnchors;
+  auto loadCert = [this, &fileAnchors] (const fs::path& file) {
     auto cert = io::load<Certificate>(file.string());
     if (cert != nullptr) {
+      fileAnchors.emplace(file, cert->getName());
       if (m_anchorNames.count(cert->getName()) == 0) {
         m_anchorNames.insert(cert->getName());
         m_certs.add(std::move(*cert));
       }
-      else {
-        oldAnchorNames.erase(cert->getName());
-      }
     }
   };
 
@@ -135,9 +345,66 @@ DynamicTrustAnchorGroup::refresh()
   }
 
   // remove old certs
-  for (const auto& oldAnchorName : oldAnchorNames) {
-    m_anchorNames.erase(oldAnchorName);
-    m_certs.remove(oldAnchorName);
+  std::set<Name> newAnchorNames;
+  boost::copy(fileAnchors | boost::adaptors::map_values,
+              std::inserter(newAnchorNames, newAnchorNames.end()));
+  for (auto it = m_anchorNames.begin(); it != m_anchorNames.end(); ) {
+    if (newAnchorNames.count(*it) == 0) {
+      m_certs.remove(*it);
+      it = m_anchorNames.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  m_fileAnchors = std::move(fileAnchors);
+}
+
+void
+DynamicTrustAnchorGroup::reloadFile(const fs::path& file)
+{
+  NDN_LOG_TRACE("Reloading trust anchor file " << file);
+
+  auto cert = io::load<Certificate>(file.string());
+  auto it = m_fileAnchors.find(file);
+  if (cert != nullptr && it != m_fileAnchors.end() && it->second == cert->getName()) {
+    return;
+  }
+
+  removeFile(file);
+  if (cert != nullptr) {
+    m_fileAnchors.emplace(file, cert->getName());
+    if (m_anchorNames.count(cert->getName()) == 0) {
+      m_anchorNames.insert(cert->getName());
+      m_certs.add(std::move(*cert));
+    }
+  }
+}
+
+void
+DynamicTrustAnchorGroup::removeFile(const fs::path& file)
+{
+  auto it = m_fileAnchors.find(file);
+  if (it == m_fileAnchors.end()) {
+    return;
+  }
+  NDN_LOG_TRACE("Unloading trust anchor file " << file);
+
+  Name certName = it->second;
+  m_fileAnchors.erase(it);
+  releaseAnchor(certName);
+}
+
+void
+DynamicTrustAnchorGroup::releaseAnchor(const Name& certName)
+{
+  bool isStillProvided = std::any_of(m_fileAnchors.begin(), m_fileAnchors.end(),
+                                     [&certName] (const auto& entry) {
+                                       return entry.second == certName;
+                                     });
+  if (!isStillProvided) {
+    m_anchorNames.erase(certName);
+    m_certs.remove(certName);
   }
 }
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -24,8 +24,10 @@
 
 #include "../../data.hpp"
 #include "certificate.hpp"
+#include "../../net/asio-fwd.hpp"
 
 #include <boost/filesystem/path.hpp>
+#include <map>
 #include <set>
 
 namespace ndn {
@@ -126,7 +128,9 @@ public:
    * This contructor would load all the certificates from @p path and will be refreshing
    * certificates every @p refreshPeriod time period.
    *
-   * Note that refresh is not scheduled, but is performed upon "find" operations.
+   * Note that refresh is not scheduled, but is performed upon "find" operations.  A group
+   * that watches @p path for changes can be created with the constructor that takes an
+   * io_service.
    *
    * When @p isDir is false and @p path doesn't point to a valid certificate (file doesn't
    * exist or content is not a valid certificate), the dynamic anchor group will be empty until
@@ -153,14 +157,68 @@ public:
                           const boost::filesystem::path& path, time::nanoseconds refreshPeriod,
                           bool isDir = false);
 
+  /**
+   * @brief Create a dynamic trust anchor group that watches @p path for changes
+   *
+   * On platforms that support inotify, the directory (or the directory containing the file)
+   * is watched on @p io, and only the certificate files that have been written, moved, or
+   * deleted are reloaded, outside of the "find" operations.  Periodic reloading every
+   * @p refreshPeriod is used only while the watch cannot be established, e.g., when the
+   * directory does not exist or inotify is not supported.
+   *
+   * @param io  io_service on which the watch is processed, must outlive this group
+   * @sa DynamicTrustAnchorGroup(CertContainerInterface&, const std::string&,
+   *     const boost::filesystem::path&, time::nanoseconds, bool)
+   */
+  DynamicTrustAnchorGroup(CertContainerInterface& certContainer, const std::string& id,
+                          const boost::filesystem::path& path, time::nanoseconds refreshPeriod,
+                          bool isDir, boost::asio::io_service& io);
+
+  ~DynamicTrustAnchorGroup() override;
+
   void
   refresh() override;
 
+  /**
+   * @return whether changes under the path are currently delivered by a filesystem watch
+   */
+  bool
+  isWatching() const;
+
 private:
+  /**
+   * @brief Reload all certificate files under the path
+   */
+  void
+  reloadAll();
+
+  /**
+   * @brief Reload the certificate from @p file, which has been created or modified
+   */
+  void
+  reloadFile(const boost::filesystem::path& file);
+
+  /**
+   * @brief Remove the certificate loaded from @p file, which has been deleted
+   */
+  void
+  removeFile(const boost::filesystem::path& file);
+
+  /**
+   * @brief Remove the certificate named @p certName, unless another file still provides it
+   */
+  void
+  releaseAnchor(const Name& certName);
+
+private:
+  class Watcher;
+
   bool m_isDir;
   boost::filesystem::path m_path;
   time::nanoseconds m_refreshPeriod;
   time::steady_clock::TimePoint m_expireTime;
+  std::map<boost::filesystem::path, Name> m_fileAnchors; ///< file => name of loaded certificate
+  unique_ptr<Watcher> m_watcher;
 };
 
 } // namespace v2
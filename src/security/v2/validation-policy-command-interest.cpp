@@ -134,21 +134,19 @@ ValidationPolicyCommandInterest::checkTimestamp(const shared_ptr<ValidationState
 void
 ValidationPolicyCommandInterest::insertNewRecord(const Name& keyName, uint64_t timestamp)
 {
-  // try to insert new record
   auto now = time::steady_clock::now();
-  auto i = m_queue.end();
-  bool isNew = false;
-  LastTimestampRecord newRecord{keyName, timestamp, now};
-  std::tie(i, isNew) = m_queue.push_back(newRecord);
-
-  if (!isNew) {
-    BOOST_ASSERT(i->keyName == keyName);
-
-    // set lastRefreshed field, and move to queue tail
-    m_queue.erase(i);
-    isNew = m_queue.push_back(newRecord).second;
-    BOOST_VERIFY(isNew);
+  auto it = m_index.find(keyName);
+  if (it == m_index.end()) {
+    m_queue.push_back(LastTimestampRecord{keyName, timestamp, now});
+    return;
   }
+
+  // update the record in place, and move it to queue tail
+  m_index.modify(it, [=] (LastTimestampRecord& record) {
+    record.timestamp = timestamp;
+    record.lastRefreshed = now;
+  });
+  m_queue.relocate(m_queue.end(), m_container.project<1>(it));
 }
 
 } // namespace v2
@@ -25,7 +25,7 @@
 #include "validation-policy.hpp"
 
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/key_extractors.hpp>
 
@@ -135,11 +135,18 @@ private:
     time::steady_clock::TimePoint lastRefreshed;
   };
 
+  /** \brief last timestamp records, hashed by key name
+   *
+   *  The sequenced index is ordered by lastRefreshed, because a record is moved to the tail
+   *  whenever it is refreshed. Thus, expired records and the least recently refreshed record
+   *  are always at the front, and cleanup() only looks at records it deletes plus one.
+   */
   using Container = boost::multi_index_container<
     LastTimestampRecord,
     boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::member<LastTimestampRecord, Name, &LastTimestampRecord::keyName>
+      boost::multi_index::hashed_unique<
+        boost::multi_index::member<LastTimestampRecord, Name, &LastTimestampRecord::keyName>,
+        std::hash<Name>
       >,
       boost::multi_index::sequenced<>
     >
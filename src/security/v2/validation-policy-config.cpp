@@ -81,6 +81,7 @@ ValidationPolicyConfig::load(const ConfigSection& configSection, const std::stri
     m_interestRules.clear();
     m_validator->resetAnchors();
     m_validator->resetVerifiedCertificates();
+    m_validator->resetUnretrievableCertificates();
   }
   m_isConfigured = true;
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -194,6 +194,12 @@ Validator::loadAnchor(const std::string& groupId, const std::string& certfilePat
   CertificateStorage::loadAnchor(groupId, certfilePath, refreshPeriod, isDir);
 }
 
+void
+Validator::enableAnchorWatch(boost::asio::io_service& io)
+{
+  CertificateStorage::enableAnchorWatch(io);
+}
+
 void
 Validator::resetAnchors()
 {
@@ -212,6 +218,12 @@ Validator::resetVerifiedCertificates()
   CertificateStorage::resetVerifiedCerts();
 }
 
+void
+Validator::resetUnretrievableCertificates()
+{
+  CertificateStorage::resetUnretrievableCerts();
+}
+
 } // namespace v2
 } // namespace security
 } // namespace ndn
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -136,6 +136,17 @@ public: // anchor management
   loadAnchor(const std::string& groupId, const std::string& certfilePath,
              time::nanoseconds refreshPeriod, bool isDir = false);
 
+  /**
+   * @brief Watch the paths of subsequently loaded dynamic trust anchors for changes
+   *
+   * Where supported (inotify), only the changed certificate files are reloaded, as changes are
+   * processed on @p io, rather than all files being reloaded periodically during validation.
+   *
+   * @param io  io_service on which changes are processed, usually the one of the Face
+   */
+  void
+  enableAnchorWatch(boost::asio::io_service& io);
+
   /**
    * @brief remove any previously loaded static or dynamic trust anchor
    */
@@ -156,6 +167,12 @@ public: // anchor management
   void
   resetVerifiedCertificates();
 
+  /**
+   * @brief Forget all certificate names that were recently found unretrievable
+   */
+  void
+  resetUnretrievableCertificates();
+
 private: // Common validator operations
   /**
    * @brief Recursive validation of the certificate in the certification chain
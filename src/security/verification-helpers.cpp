@@ -27,12 +27,11 @@
 #include "transform/buffer-source.hpp"
 #include "transform/digest-filter.hpp"
 #include "transform/public-key.hpp"
-#include "transform/stream-sink.hpp"
+#include "transform/span-sink.hpp"
 #include "transform/verifier-filter.hpp"
 #include "v2/certificate.hpp"
 #include "../data.hpp"
 #include "../interest.hpp"
-#include "../encoding/buffer-stream.hpp"
 
 namespace ndn {
 namespace security {
@@ -196,20 +195,21 @@ verifyDigest(const uint8_t* blob, size_t blobLen, const uint8_t* digest, size_t
 {
   using namespace transform;
 
-  OBufferStream os;
+  uint8_t result[EVP_MAX_MD_SIZE];
+  size_t resultLen = 0;
   try {
-    bufferSource(blob, blobLen) >> digestFilter(algorithm) >> streamSink(os);
+    bufferSource(blob, blobLen) >> digestFilter(algorithm) >>
+      spanSink(result, sizeof(result), resultLen);
   }
   catch (const transform::Error&) {
     return false;
   }
-  ConstBufferPtr result = os.buf();
 
-  if (result->size() != digestLen)
+  if (resultLen != digestLen)
     return false;
 
   // constant-time buffer comparison to mitigate timing attacks
-  return CRYPTO_memcmp(result->data(), digest, digestLen) == 0;
+  return CRYPTO_memcmp(result, digest, digestLen) == 0;
 }
 
 bool
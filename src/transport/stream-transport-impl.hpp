@@ -82,6 +82,8 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isReceiving = false;
     m_transmissionQueue.clear();
+    m_transport.m_sendQueueLength = 0;
+    m_transport.m_sendQueueBytes = 0;
   }
 
   void
@@ -161,6 +163,8 @@ protected:
   void
   send(BlockSequence&& sequence)
   {
+    m_transport.m_sendQueueLength.fetch_add(1, std::memory_order_relaxed);
+    m_transport.m_sendQueueBytes.fetch_add(getSequenceSize(sequence), std::memory_order_relaxed);
     m_transmissionQueue.emplace_back(sequence);
 
     if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
@@ -171,6 +175,16 @@ protected:
     // next write will be scheduled either in connectHandler or in asyncWriteHandler
   }
 
+  static size_t
+  getSequenceSize(const BlockSequence& sequence)
+  {
+    size_t size = 0;
+    for (const Block& block : sequence) {
+      size += block.size();
+    }
+    return size;
+  }
+
   void
   asyncWrite()
   {
@@ -196,6 +210,8 @@ protected:
       return; // queue has been already cleared
     }
 
+    m_transport.m_sendQueueLength.fetch_sub(1, std::memory_order_relaxed);
+    m_transport.m_sendQueueBytes.fetch_sub(getSequenceSize(*queueItem), std::memory_order_relaxed);
     m_transmissionQueue.erase(queueItem);
 
     if (!m_transmissionQueue.empty()) {
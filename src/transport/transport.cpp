@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /**
- * Copyright (c) 2013-2016 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -37,6 +37,8 @@ Transport::Transport()
   : m_ioService(nullptr)
   , m_isConnected(false)
   , m_isReceiving(false)
+  , m_sendQueueLength(0)
+  , m_sendQueueBytes(0)
 {
 }
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2017 Regents of the University of California.
+ * Copyright (c) 2013-2018 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -28,6 +28,8 @@
 
 #include <boost/system/error_code.hpp>
 
+#include <atomic>
+
 namespace ndn {
 
 /** \brief provides TLV-block delivery service
@@ -106,6 +108,18 @@ public:
   bool
   isReceiving() const;
 
+  /** \brief get number of packets waiting to be written to the underlying socket
+   *  \note This method can be called from any thread.
+   */
+  size_t
+  getSendQueueLength() const;
+
+  /** \brief get number of bytes waiting to be written to the underlying socket
+   *  \note This method can be called from any thread.
+   */
+  size_t
+  getSendQueueBytes() const;
+
 protected:
   /** \brief invoke the receive callback
    */
@@ -117,6 +131,8 @@ protected:
   bool m_isConnected;
   bool m_isReceiving;
   ReceiveCallback m_receiveCallback;
+  std::atomic<size_t> m_sendQueueLength;
+  std::atomic<size_t> m_sendQueueBytes;
 };
 
 inline bool
@@ -131,6 +147,18 @@ Transport::isReceiving() const
   return m_isReceiving;
 }
 
+inline size_t
+Transport::getSendQueueLength() const
+{
+  return m_sendQueueLength.load(std::memory_order_relaxed);
+}
+
+inline size_t
+Transport::getSendQueueBytes() const
+{
+  return m_sendQueueBytes.load(std::memory_order_relaxed);
+}
+
 inline void
 Transport::receive(const Block& wire)
 {
@@ -0,0 +1,699 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "text-codec.hpp"
+
+#include <atomic>
+#include <cstring>
+
+// SIMD kernels are compiled with per-function target attributes and selected at runtime,
+// so that the library does not require AVX2 or SSSE3 to be enabled at compile time.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NDN_CXX_HAVE_X86_SIMD_CODEC
+#include <immintrin.h>
+#define NDN_CXX_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define NDN_CXX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+static const char HEX_UPPER[] = "0123456789ABCDEF";
+static const char HEX_LOWER[] = "0123456789abcdef";
+
+// hex decoding table: 0-15 are nibbles, -1 is invalid
+static const int8_t C2H[] = {
+// 0   1   2   3   4   5   6   7   8   9   10  11  12  13  14  15
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 0-15
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 16-31
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 32-47
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1, // 48-63
+  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 64-79
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 80-95
+  -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 96-111
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 112-127
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 128-143
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 144-159
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 160-175
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 176-191
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 192-207
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 208-223
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 224-239
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 240-255
+};
+static_assert(std::extent<decltype(C2H)>::value == 256, "");
+
+static const char BASE64_ALPHABET[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const int8_t B64_WHITESPACE = -2;
+static const int8_t B64_PADDING = -3;
+
+// base64 decoding table: 0-63 are sextets, -2 is whitespace, -3 is padding, -1 is invalid
+static const int8_t C2B[] = {
+// 0   1   2   3   4   5   6   7   8   9   10  11  12  13  14  15
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -1, -1, // 0-15
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 16-31
+  -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63, // 32-47
+  52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -3, -1, -1, // 48-63
+  -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, // 64-79
+  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1, // 80-95
+  -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, // 96-111
+  41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1, // 112-127
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 128-143
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 144-159
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 160-175
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 176-191
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 192-207
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 208-223
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 224-239
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, // 240-255
+};
+static_assert(std::extent<decltype(C2B)>::value == 256, "");
+
+// ---- instruction set selection ----
+
+static SimdLevel
+detectSimdLevel() noexcept
+{
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return SimdLevel::AVX2;
+  if (__builtin_cpu_supports("ssse3"))
+    return SimdLevel::SSSE3;
+#endif
+  return SimdLevel::NONE;
+}
+
+static SimdLevel
+getMaxSimdLevel() noexcept
+{
+  static const SimdLevel level = detectSimdLevel();
+  return level;
+}
+
+static std::atomic<SimdLevel>&
+getSelectedSimdLevel() noexcept
+{
+  static std::atomic<SimdLevel> level(getMaxSimdLevel());
+  return level;
+}
+
+SimdLevel
+getSimdLevel() noexcept
+{
+  return getSelectedSimdLevel().load(std::memory_order_relaxed);
+}
+
+SimdLevel
+setSimdLevel(SimdLevel level) noexcept
+{
+  level = std::min(level, getMaxSimdLevel());
+  getSelectedSimdLevel().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+// ---- SSSE3 kernels ----
+//
+// Each kernel processes whole blocks from the start of the input and returns the number of
+// input octets or characters it has consumed.  Decoding kernels stop before the first block
+// that contains an unexpected character.  Every kernel reads all of a block before writing
+// its output, and never writes past the output of the blocks it has consumed, so that
+// decoding may be done in place.
+//
+// The base64 kernels follow the algorithms described by Wojciech Mula and Daniel Lemire in
+// "Faster Base64 Encoding and Decoding Using AVX2 Instructions" (ACM TWEB, 2018).
+
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+
+NDN_CXX_TARGET_SSSE3 static size_t
+encodeHexSsse3(const uint8_t* in, size_t n, char* out, bool wantUpperCase) noexcept
+{
+  const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wantUpperCase ?
+                                                                       HEX_UPPER : HEX_LOWER));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+    __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+/** @brief Convert hex characters to nibbles
+ *  @param[out] isValid 0xFF in every byte that holds a hex character, 0x00 elsewhere
+ */
+NDN_CXX_TARGET_SSSE3 static inline __m128i
+hexToNibblesSsse3(__m128i c, __m128i& isValid) noexcept
+{
+  __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+  isValid = _mm_or_si128(isDigit, isLetter);
+  return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                      _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+NDN_CXX_TARGET_SSSE3 static size_t
+decodeHexSsse3(const char* in, size_t n, uint8_t* out) noexcept
+{
+  // each pair of nibbles (high, low) is combined as high * 0x10 + low * 0x01
+  const __m128i weights = _mm_set1_epi16(0x0110);
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m128i isValid0, isValid1;
+    __m128i x0 = hexToNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)),
+                                   isValid0);
+    __m128i x1 = hexToNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)),
+                                   isValid1);
+    if (_mm_movemask_epi8(_mm_and_si128(isValid0, isValid1)) != 0xFFFF)
+      break;
+
+    __m128i y = _mm_packus_epi16(_mm_maddubs_epi16(x0, weights), _mm_maddubs_epi16(x1, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), y);
+  }
+  return i;
+}
+
+/** @brief Split every 3 octets in the low 12 octets of each 128-bit lane into 4 sextets
+ *  @param x 16 octets, each 32-bit element holding octets (1, 0, 2, 1) of a group
+ */
+NDN_CXX_TARGET_SSSE3 static inline __m128i
+splitSextetsSsse3(__m128i x) noexcept
+{
+  __m128i t0 = _mm_and_si128(x, _mm_set1_epi32(0x0fc0fc00));
+  __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  __m128i t2 = _mm_and_si128(x, _mm_set1_epi32(0x003f03f0));
+  __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+/** @brief Convert sextets to base64 characters
+ */
+NDN_CXX_TARGET_SSSE3 static inline __m128i
+sextetsToBase64Ssse3(__m128i x) noexcept
+{
+  // offset to add to each sextet, indexed by 0 for 26-51, 1-10 for 52-61, 11 for 62,
+  // 12 for 63, and 13 for 0-25
+  const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  __m128i index = _mm_subs_epu8(x, _mm_set1_epi8(51));
+  __m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), x);
+  index = _mm_or_si128(index, _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(x, _mm_shuffle_epi8(offsets, index));
+}
+
+NDN_CXX_TARGET_SSSE3 static size_t
+encodeBase64Ssse3(const uint8_t* in, size_t n, char* out) noexcept
+{
+  const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+  // 12 octets are encoded per iteration, but 16 are loaded
+  size_t i = 0;
+  for (; i + 16 <= n; i += 12, out += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    x = sextetsToBase64Ssse3(splitSextetsSsse3(_mm_shuffle_epi8(x, shuffle)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+  }
+  return i;
+}
+
+/** @brief Convert base64 characters to sextets
+ *  @return false if any character is not in the base64 alphabet
+ */
+NDN_CXX_TARGET_SSSE3 static inline bool
+base64ToSextetsSsse3(__m128i& x) noexcept
+{
+  // a character is valid if the bit patterns selected by its low and high nibbles do not overlap
+  const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  // offset to add to each character, indexed by its high nibble, or 1 for '/'
+  const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                        0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask2F = _mm_set1_epi8(0x2f);
+
+  __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(x, 4), mask2F);
+  __m128i loNibbles = _mm_and_si128(x, mask2F);
+  __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+  __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+  if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+    return false;
+
+  __m128i isSlash = _mm_cmpeq_epi8(x, mask2F);
+  x = _mm_add_epi8(x, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, hiNibbles)));
+  return true;
+}
+
+/** @brief Pack every 4 sextets into 3 octets at the start of each 32-bit element
+ */
+NDN_CXX_TARGET_SSSE3 static inline __m128i
+packSextetsSsse3(__m128i x) noexcept
+{
+  __m128i pairs = _mm_maddubs_epi16(x, _mm_set1_epi32(0x01400140));
+  return _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+}
+
+NDN_CXX_TARGET_SSSE3 static size_t
+decodeBase64Ssse3(const char* in, size_t n, uint8_t* out) noexcept
+{
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16, out += 12) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    if (!base64ToSextetsSsse3(x))
+      break;
+
+    x = _mm_shuffle_epi8(packSextetsSsse3(x), shuffle);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), x);
+    uint32_t tail = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x, 8)));
+    std::memcpy(out + 8, &tail, sizeof(tail));
+  }
+  return i;
+}
+
+// ---- AVX2 kernels ----
+
+NDN_CXX_TARGET_AVX2 static size_t
+encodeHexAvx2(const uint8_t* in, size_t n, char* out, bool wantUpperCase) noexcept
+{
+  const __m256i lut = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(wantUpperCase ? HEX_UPPER : HEX_LOWER)));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, mask));
+    // unpack works within 128-bit lanes: y0 holds octets 0-7 and 16-23, y1 holds 8-15 and 24-31
+    __m256i y0 = _mm256_unpacklo_epi8(hi, lo);
+    __m256i y1 = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+                        _mm256_permute2x128_si256(y0, y1, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),
+                        _mm256_permute2x128_si256(y0, y1, 0x31));
+  }
+  return i;
+}
+
+NDN_CXX_TARGET_AVX2 static inline __m256i
+hexToNibblesAvx2(__m256i c, __m256i& isValid) noexcept
+{
+  __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+  __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)),
+                                   _mm256_set1_epi8('a'));
+  __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+  isValid = _mm256_or_si256(isDigit, isLetter);
+  return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                         _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+NDN_CXX_TARGET_AVX2 static size_t
+decodeHexAvx2(const char* in, size_t n, uint8_t* out) noexcept
+{
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __m256i isValid0, isValid1;
+    __m256i x0 = hexToNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)),
+                                  isValid0);
+    __m256i x1 = hexToNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)),
+                                  isValid1);
+    if (_mm256_movemask_epi8(_mm256_and_si256(isValid0, isValid1)) != -1)
+      break;
+
+    // pack works within 128-bit lanes, so that 64-bit elements come out in order 0, 2, 1, 3
+    __m256i y = _mm256_packus_epi16(_mm256_maddubs_epi16(x0, weights),
+                                    _mm256_maddubs_epi16(x1, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2),
+                        _mm256_permute4x64_epi64(y, 0xD8));
+  }
+  return i;
+}
+
+NDN_CXX_TARGET_AVX2 static inline __m256i
+splitSextetsAvx2(__m256i x) noexcept
+{
+  __m256i t0 = _mm256_and_si256(x, _mm256_set1_epi32(0x0fc0fc00));
+  __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  __m256i t2 = _mm256_and_si256(x, _mm256_set1_epi32(0x003f03f0));
+  __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+NDN_CXX_TARGET_AVX2 static inline __m256i
+sextetsToBase64Avx2(__m256i x) noexcept
+{
+  const __m256i offsets = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                  '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+  __m256i index = _mm256_subs_epu8(x, _mm256_set1_epi8(51));
+  __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), x);
+  index = _mm256_or_si256(index, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(x, _mm256_shuffle_epi8(offsets, index));
+}
+
+NDN_CXX_TARGET_AVX2 static size_t
+encodeBase64Avx2(const uint8_t* in, size_t n, char* out) noexcept
+{
+  // the low lane is loaded from octet 0 and uses octets 0-11;
+  // the high lane is loaded from octet 8 and uses octets 12-23
+  const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                           5, 4, 6, 5, 8, 7, 9, 8, 11, 10, 12, 11, 14, 13, 15, 14);
+
+  size_t i = 0;
+  for (; i + 24 <= n; i += 24, out += 32) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+    __m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    x = sextetsToBase64Avx2(splitSextetsAvx2(_mm256_shuffle_epi8(x, shuffle)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), x);
+  }
+  return i;
+}
+
+NDN_CXX_TARGET_AVX2 static inline bool
+base64ToSextetsAvx2(__m256i& x) noexcept
+{
+  const __m256i lutLo = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                  0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+  const __m256i lutHi = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i lutRoll = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i mask2F = _mm256_set1_epi8(0x2f);
+
+  __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(x, 4), mask2F);
+  __m256i loNibbles = _mm256_and_si256(x, mask2F);
+  __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+  __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+  if (!_mm256_testz_si256(lo, hi))
+    return false;
+
+  __m256i isSlash = _mm256_cmpeq_epi8(x, mask2F);
+  x = _mm256_add_epi8(x, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(isSlash, hiNibbles)));
+  return true;
+}
+
+NDN_CXX_TARGET_AVX2 static size_t
+decodeBase64Avx2(const char* in, size_t n, uint8_t* out) noexcept
+{
+  const __m256i shuffle = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  // move the 12 octets of the high lane right after the 12 octets of the low lane
+  const __m256i permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32, out += 24) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    if (!base64ToSextetsAvx2(x))
+      break;
+
+    // pack 4 sextets into 3 bytes in each 32-bit lane, and gather them in each 128-bit lane
+    x = _mm256_maddubs_epi16(x, _mm256_set1_epi32(0x01400140));
+    x = _mm256_madd_epi16(x, _mm256_set1_epi32(0x00011000));
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_permutevar8x32_epi32(x, permute);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(x));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(x, 1));
+  }
+  return i;
+}
+
+#endif // NDN_CXX_HAVE_X86_SIMD_CODEC
+
+// ---- hex ----
+
+void
+encodeHex(const uint8_t* in, size_t n, char* out, bool wantUpperCase) noexcept
+{
+  size_t i = 0;
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+  switch (getSimdLevel()) {
+    case SimdLevel::AVX2:
+      i = encodeHexAvx2(in, n, out, wantUpperCase);
+      break;
+    case SimdLevel::SSSE3:
+      i = encodeHexSsse3(in, n, out, wantUpperCase);
+      break;
+    case SimdLevel::NONE:
+      break;
+  }
+#endif
+
+  const char* encodePad = wantUpperCase ? HEX_UPPER : HEX_LOWER;
+  for (; i < n; ++i) {
+    out[2 * i] = encodePad[in[i] >> 4];
+    out[2 * i + 1] = encodePad[in[i] & 0x0f];
+  }
+}
+
+bool
+decodeHex(const char* in, size_t n, uint8_t* out) noexcept
+{
+  BOOST_ASSERT(n % 2 == 0);
+
+  size_t i = 0;
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+  switch (getSimdLevel()) {
+    case SimdLevel::AVX2:
+      i = decodeHexAvx2(in, n, out);
+      break;
+    case SimdLevel::SSSE3:
+      i = decodeHexSsse3(in, n, out);
+      break;
+    case SimdLevel::NONE:
+      break;
+  }
+#endif
+
+  for (; i < n; i += 2) {
+    int hi = C2H[static_cast<uint8_t>(in[i])];
+    int lo = C2H[static_cast<uint8_t>(in[i + 1])];
+    if (hi < 0 || lo < 0)
+      return false;
+    out[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+  return true;
+}
+
+// ---- base64 ----
+
+/** @brief Encode the longest prefix of @p n octets that is a multiple of 3, without padding
+ *  @return number of octets consumed
+ */
+static size_t
+encodeBase64Groups(const uint8_t* in, size_t n, char* out) noexcept
+{
+  size_t i = 0;
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+  switch (getSimdLevel()) {
+    case SimdLevel::AVX2:
+      i = encodeBase64Avx2(in, n, out);
+      break;
+    case SimdLevel::SSSE3:
+      i = encodeBase64Ssse3(in, n, out);
+      break;
+    case SimdLevel::NONE:
+      break;
+  }
+  out += i / 3 * 4;
+#endif
+
+  for (; i + 3 <= n; i += 3, out += 4) {
+    uint32_t bits = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+    out[0] = BASE64_ALPHABET[bits >> 18];
+    out[1] = BASE64_ALPHABET[(bits >> 12) & 0x3f];
+    out[2] = BASE64_ALPHABET[(bits >> 6) & 0x3f];
+    out[3] = BASE64_ALPHABET[bits & 0x3f];
+  }
+  return i;
+}
+
+/** @brief Encode @p n octets without line breaks, with padding
+ *  @return number of characters written
+ */
+static size_t
+encodeBase64Line(const uint8_t* in, size_t n, char* out) noexcept
+{
+  size_t i = encodeBase64Groups(in, n, out);
+  char* tail = out + i / 3 * 4;
+  switch (n - i) {
+    case 1:
+      tail[0] = BASE64_ALPHABET[in[i] >> 2];
+      tail[1] = BASE64_ALPHABET[(in[i] & 0x03) << 4];
+      tail[2] = '=';
+      tail[3] = '=';
+      tail += 4;
+      break;
+    case 2:
+      tail[0] = BASE64_ALPHABET[in[i] >> 2];
+      tail[1] = BASE64_ALPHABET[((in[i] & 0x03) << 4) | (in[i + 1] >> 4)];
+      tail[2] = BASE64_ALPHABET[(in[i + 1] & 0x0f) << 2];
+      tail[3] = '=';
+      tail += 4;
+      break;
+  }
+  return tail - out;
+}
+
+size_t
+encodeBase64(const uint8_t* in, size_t n, char* out, bool needBreak) noexcept
+{
+  if (!needBreak) {
+    return encodeBase64Line(in, n, out);
+  }
+
+  // 48 octets make a line of 64 characters
+  char* output = out;
+  for (size_t i = 0; i < n; i += 48) {
+    output += encodeBase64Line(in + i, std::min<size_t>(48, n - i), output);
+    *output++ = '\n';
+  }
+  return output - out;
+}
+
+/** @brief Decode the longest prefix of @p n characters that consists of whole groups of
+ *         4 characters in the base64 alphabet
+ *  @return number of characters consumed
+ */
+static size_t
+decodeBase64Groups(const char* in, size_t n, uint8_t* out) noexcept
+{
+  size_t i = 0;
+#ifdef NDN_CXX_HAVE_X86_SIMD_CODEC
+  switch (getSimdLevel()) {
+    case SimdLevel::AVX2:
+      i = decodeBase64Avx2(in, n, out);
+      break;
+    case SimdLevel::SSSE3:
+      i = decodeBase64Ssse3(in, n, out);
+      break;
+    case SimdLevel::NONE:
+      break;
+  }
+  out += i / 4 * 3;
+#endif
+
+  for (; i + 4 <= n; i += 4, out += 3) {
+    int a = C2B[static_cast<uint8_t>(in[i])];
+    int b = C2B[static_cast<uint8_t>(in[i + 1])];
+    int c = C2B[static_cast<uint8_t>(in[i + 2])];
+    int d = C2B[static_cast<uint8_t>(in[i + 3])];
+    if ((a | b | c | d) < 0)
+      break;
+
+    uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<uint8_t>(bits >> 16);
+    out[1] = static_cast<uint8_t>(bits >> 8);
+    out[2] = static_cast<uint8_t>(bits);
+  }
+  return i;
+}
+
+size_t
+Base64Decoder::decode(const char* in, size_t n, uint8_t* out) noexcept
+{
+  const char* last = in + n;
+  uint8_t* output = out;
+  while (in != last && !m_hasError) {
+    if (m_nChars == 0 && !m_hasPadding) {
+      size_t nConsumed = decodeBase64Groups(in, last - in, output);
+      in += nConsumed;
+      output += nConsumed / 4 * 3;
+    }
+
+    // decode one character at a time up to the next group boundary,
+    // skipping whitespace and handling padding
+    while (in != last && !m_hasError) {
+      output += decodeChar(static_cast<uint8_t>(*in++), output);
+      if (m_nChars == 0 && m_nPads == 0)
+        break;
+    }
+  }
+  return output - out;
+}
+
+size_t
+Base64Decoder::decodeChar(uint8_t c, uint8_t* out) noexcept
+{
+  int8_t value = C2B[c];
+
+  if (value >= 0) {
+    if (m_hasPadding || m_nPads > 0) {
+      m_hasError = true;
+      return 0;
+    }
+    m_bits = (m_bits << 6) | static_cast<uint32_t>(value);
+    if (++m_nChars < 4)
+      return 0;
+
+    out[0] = static_cast<uint8_t>(m_bits >> 16);
+    out[1] = static_cast<uint8_t>(m_bits >> 8);
+    out[2] = static_cast<uint8_t>(m_bits);
+    m_bits = 0;
+    m_nChars = 0;
+    return 3;
+  }
+
+  if (value == B64_WHITESPACE)
+    return 0;
+
+  if (value == B64_PADDING && !m_hasPadding && m_nChars >= 2) {
+    if (m_nChars + ++m_nPads < 4)
+      return 0;
+
+    // 2 characters carry 1 octet, 3 characters carry 2 octets
+    uint32_t bits = m_bits << (6 * m_nPads);
+    size_t nOctets = m_nChars - 1;
+    out[0] = static_cast<uint8_t>(bits >> 16);
+    if (nOctets == 2)
+      out[1] = static_cast<uint8_t>(bits >> 8);
+    m_bits = 0;
+    m_nChars = 0;
+    m_nPads = 0;
+    m_hasPadding = true;
+    return nOctets;
+  }
+
+  m_hasError = true;
+  return 0;
+}
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
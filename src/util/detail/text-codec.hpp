@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_DETAIL_TEXT_CODEC_HPP
+#define NDN_UTIL_DETAIL_TEXT_CODEC_HPP
+
+#include "../../common.hpp"
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+/** @brief Instruction set used by the hex and base64 codecs
+ *
+ *  The codecs process long runs of input with SSSE3 or AVX2 instructions if the CPU supports
+ *  them, and the remainder one character at a time.  The output does not depend on the level.
+ */
+enum class SimdLevel {
+  NONE,
+  SSSE3,
+  AVX2
+};
+
+/** @brief Get the instruction set used by the codecs
+ */
+SimdLevel
+getSimdLevel() noexcept;
+
+/** @brief Select the instruction set used by the codecs, for tests and benchmarks
+ *  @return the selected level, which is @p level capped to what the CPU supports
+ */
+SimdLevel
+setSimdLevel(SimdLevel level) noexcept;
+
+/** @brief Write @p n octets at @p in as `2 * n` hex characters at @p out
+ */
+void
+encodeHex(const uint8_t* in, size_t n, char* out, bool wantUpperCase) noexcept;
+
+/** @brief Decode @p n hex characters at @p in into `n / 2` octets at @p out
+ *  @pre @p n is even
+ *  @param out may be the same as @p in
+ *  @return false if the input contains a non-hex character; content of @p out is then unspecified
+ */
+bool
+decodeHex(const char* in, size_t n, uint8_t* out) noexcept;
+
+/** @brief Get the length of base64 encoding of @p n octets
+ *  @param needBreak whether a newline is inserted after every 64 characters and at the end
+ */
+constexpr size_t
+getBase64EncodedSize(size_t n, bool needBreak) noexcept
+{
+  return (n + 2) / 3 * 4 + (needBreak ? (n + 47) / 48 : 0);
+}
+
+/** @brief Write base64 encoding of @p n octets at @p in to @p out, with padding
+ *  @param needBreak whether a newline is inserted after every 64 characters and at the end
+ *  @return number of characters written, which is `getBase64EncodedSize(n, needBreak)`
+ */
+size_t
+encodeBase64(const uint8_t* in, size_t n, char* out, bool needBreak) noexcept;
+
+/** @brief Incremental base64 decoder
+ *
+ *  Whitespace is skipped anywhere in the input.  Padding is required, and nothing but
+ *  whitespace may follow it.
+ */
+class Base64Decoder
+{
+public:
+  /** @brief Decode @p n characters at @p in
+   *  @param out receives the decoded octets; it needs room for `(n + 3) / 4 * 3` octets,
+   *             and may be the same as @p in on the first invocation
+   *  @return number of octets written
+   *
+   *  Up to three characters that do not form a complete group are kept until the next
+   *  invocation.  If the input is invalid, hasError() becomes true, and this and every
+   *  subsequent invocation write nothing further.
+   */
+  size_t
+  decode(const char* in, size_t n, uint8_t* out) noexcept;
+
+  /** @brief Check if invalid input has been encountered
+   */
+  bool
+  hasError() const noexcept
+  {
+    return m_hasError;
+  }
+
+  /** @brief Check if the input so far is valid and ends at a group boundary
+   */
+  bool
+  isComplete() const noexcept
+  {
+    return !m_hasError && m_nChars == 0 && m_nPads == 0;
+  }
+
+private:
+  /** @brief Decode one character
+   *  @return number of octets written
+   */
+  size_t
+  decodeChar(uint8_t c, uint8_t* out) noexcept;
+
+private:
+  uint32_t m_bits = 0;
+  uint8_t m_nChars = 0;
+  uint8_t m_nPads = 0;
+  bool m_hasPadding = false;
+  bool m_hasError = false;
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DETAIL_TEXT_CODEC_HPP
@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-metrics.hpp"
+#include "../face.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../encoding/encoding-buffer.hpp"
+#include "../encoding/tlv-nfd.hpp"
+#include "../mgmt/status-dataset-context.hpp"
+
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+/** \brief TLV-TYPE numbers of FaceMetrics fields that have no NFD general status counterpart
+ *
+ *  These are application-specific numbers, within the range that the NDN packet format
+ *  specification leaves to applications; see
+ *  https://named-data.net/doc/NDN-packet-spec/current/types.html
+ *  They are only meaningful within a FaceMetrics payload.
+ */
+namespace tlv_face_metrics {
+
+enum {
+  NSatisfiedInterests  = 160,
+  NTimedOutInterests   = 161,
+  NNackedInterests     = 162,
+  NPitEntries          = 163,
+  MaxPitEntries        = 164,
+  SendQueueLength      = 165,
+  SendQueueBytes       = 166,
+  LatencyBucket        = 167,
+  BucketIndex          = 168,
+  BucketCount          = 169,
+  NSuppressedInterests = 170,
+};
+
+} // namespace tlv_face_metrics
+
+constexpr size_t LatencyHistogram::N_SUB_BUCKETS;
+constexpr size_t LatencyHistogram::N_BUCKETS;
+
+size_t
+LatencyHistogram::getBucketIndex(time::nanoseconds latency)
+{
+  uint64_t us = static_cast<uint64_t>(std::max<time::microseconds::rep>(0,
+                  time::duration_cast<time::microseconds>(latency).count()));
+  if (us < N_SUB_BUCKETS) {
+    return static_cast<size_t>(us);
+  }
+
+  // exponent is floor(log2(us)), at least 2
+  size_t exponent = 0;
+  for (uint64_t v = us; v > 1; v >>= 1) {
+    ++exponent;
+  }
+  size_t index = N_SUB_BUCKETS * (exponent - 1) + ((us >> (exponent - 2)) & (N_SUB_BUCKETS - 1));
+  return std::min(index, N_BUCKETS - 1);
+}
+
+time::nanoseconds
+LatencyHistogram::getBucketLowerBound(size_t index)
+{
+  BOOST_ASSERT(index < N_BUCKETS);
+  if (index < N_SUB_BUCKETS) {
+    return time::microseconds(index);
+  }
+
+  size_t exponent = index / N_SUB_BUCKETS + 1;
+  uint64_t mantissa = N_SUB_BUCKETS + index % N_SUB_BUCKETS;
+  return time::microseconds(static_cast<time::microseconds::rep>(mantissa << (exponent - 2)));
+}
+
+uint64_t
+LatencyHistogram::getCount() const
+{
+  uint64_t total = 0;
+  for (uint64_t count : m_counts) {
+    total += count;
+  }
+  return total;
+}
+
+time::nanoseconds
+LatencyHistogram::getQuantile(double quantile) const
+{
+  uint64_t total = getCount();
+  if (total == 0) {
+    return time::nanoseconds::zero();
+  }
+
+  // rank of the quantile among counted latencies, 1-based
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * total)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return getBucketLowerBound(i);
+    }
+  }
+  return getBucketLowerBound(N_BUCKETS - 1);
+}
+
+FaceMetrics::FaceMetrics(const Block& payload)
+{
+  this->wireDecode(payload);
+}
+
+template<encoding::Tag TAG>
+size_t
+FaceMetrics::wireEncode(EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  for (size_t i = LatencyHistogram::N_BUCKETS; i-- > 0;) {
+    uint64_t count = satisfyLatency.getBucketCount(i);
+    if (count == 0) {
+      continue;
+    }
+    size_t bucketLength = 0;
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::BucketCount, count);
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::BucketIndex, i);
+    bucketLength += encoder.prependVarNumber(bucketLength);
+    bucketLength += encoder.prependVarNumber(tlv_face_metrics::LatencyBucket);
+    totalLength += bucketLength;
+  }
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::NSuppressedInterests,
+                                                nSuppressedInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::SendQueueBytes,
+                                                sendQueueBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::SendQueueLength,
+                                                sendQueueLength);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::MaxPitEntries,
+                                                maxPitEntries);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::NPitEntries,
+                                                nPitEntries);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::NNackedInterests,
+                                                nNackedInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::NTimedOutInterests,
+                                                nTimedOutInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv_face_metrics::NSatisfiedInterests,
+                                                nSatisfiedInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, nOutNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutData, nOutData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests, nOutInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInNacks, nInNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInData, nInData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInInterests, nInInterests);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::Content);
+  return totalLength;
+}
+
+template size_t
+FaceMetrics::wireEncode<encoding::EncoderTag>(EncodingImpl<encoding::EncoderTag>&) const;
+
+template size_t
+FaceMetrics::wireEncode<encoding::EstimatorTag>(EncodingImpl<encoding::EstimatorTag>&) const;
+
+Block
+FaceMetrics::wireEncode() const
+{
+  EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+  return buffer.block();
+}
+
+void
+FaceMetrics::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::Content) {
+    BOOST_THROW_EXCEPTION(Error("expecting Content block for FaceMetrics payload"));
+  }
+  wire.parse();
+
+  *this = FaceMetrics();
+  for (const Block& element : wire.elements()) {
+    switch (element.type()) {
+      case tlv::nfd::NInInterests:
+        nInInterests = readNonNegativeInteger(element);
+        break;
+      case tlv::nfd::NInData:
+        nInData = readNonNegativeInteger(element);
+        break;
+      case tlv::nfd::NInNacks:
+        nInNacks = readNonNegativeInteger(element);
+        break;
+      case tlv::nfd::NOutInterests:
+        nOutInterests = readNonNegativeInteger(element);
+        break;
+      case tlv::nfd::NOutData:
+        nOutData = readNonNegativeInteger(element);
+        break;
+      case tlv::nfd::NOutNacks:
+        nOutNacks = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::NSatisfiedInterests:
+        nSatisfiedInterests = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::NTimedOutInterests:
+        nTimedOutInterests = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::NNackedInterests:
+        nNackedInterests = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::NPitEntries:
+        nPitEntries = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::MaxPitEntries:
+        maxPitEntries = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::SendQueueLength:
+        sendQueueLength = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::SendQueueBytes:
+        sendQueueBytes = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::NSuppressedInterests:
+        nSuppressedInterests = readNonNegativeInteger(element);
+        break;
+      case tlv_face_metrics::LatencyBucket: {
+        element.parse();
+        auto index = element.find(tlv_face_metrics::BucketIndex);
+        auto count = element.find(tlv_face_metrics::BucketCount);
+        if (index == element.elements_end() || count == element.elements_end()) {
+          BOOST_THROW_EXCEPTION(Error("LatencyBucket is missing BucketIndex or BucketCount"));
+        }
+        uint64_t i = readNonNegativeInteger(*index);
+        if (i >= LatencyHistogram::N_BUCKETS) {
+          BOOST_THROW_EXCEPTION(Error("BucketIndex is out of range"));
+        }
+        satisfyLatency.setBucketCount(static_cast<size_t>(i), readNonNegativeInteger(*count));
+        break;
+      }
+      default:
+        if (tlv::isCriticalType(element.type())) {
+          BOOST_THROW_EXCEPTION(Error("unrecognized element of critical type " +
+                                      to_string(element.type())));
+        }
+        break;
+    }
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const FaceMetrics& metrics)
+{
+  os << "FaceMetrics(\n"
+     << "  Counters: {Interests: {in: " << metrics.nInInterests << ", "
+     << "out: " << metrics.nOutInterests << "},\n"
+     << "             Data: {in: " << metrics.nInData << ", "
+     << "out: " << metrics.nOutData << "},\n"
+     << "             Nacks: {in: " << metrics.nInNacks << ", "
+     << "out: " << metrics.nOutNacks << "}}\n"
+     << "  ExpressedInterests: {satisfied: " << metrics.nSatisfiedInterests << ", "
+     << "timedOut: " << metrics.nTimedOutInterests << ", "
+     << "nacked: " << metrics.nNackedInterests << ", "
+     << "suppressed: " << metrics.nSuppressedInterests << "}\n"
+     << "  PendingInterests: {current: " << metrics.nPitEntries << ", "
+     << "max: " << metrics.maxPitEntries << "}\n"
+     << "  SendQueue: {packets: " << metrics.sendQueueLength << ", "
+     << "bytes: " << metrics.sendQueueBytes << "}\n"
+     << "  SatisfyLatency: {p50: " << metrics.satisfyLatency.getQuantile(0.5) << ", "
+     << "p99: " << metrics.satisfyLatency.getQuantile(0.99) << "}\n"
+     << "  )";
+  return os;
+}
+
+FaceMetricsCollector::FaceMetricsCollector()
+  : m_nInInterests(0)
+  , m_nInData(0)
+  , m_nInNacks(0)
+  , m_nOutInterests(0)
+  , m_nOutData(0)
+  , m_nOutNacks(0)
+  , m_nSatisfiedInterests(0)
+  , m_nTimedOutInterests(0)
+  , m_nNackedInterests(0)
+  , m_nSuppressedInterests(0)
+  , m_nPitEntries(0)
+  , m_maxPitEntries(0)
+{
+  for (auto& count : m_satisfyLatency) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+void
+FaceMetricsCollector::recordPitSize(size_t nPitEntries)
+{
+  m_nPitEntries.store(nPitEntries, std::memory_order_relaxed);
+
+  // the PIT is only modified in one thread, so the high-water mark needs no compare-exchange
+  if (nPitEntries > m_maxPitEntries.load(std::memory_order_relaxed)) {
+    m_maxPitEntries.store(nPitEntries, std::memory_order_relaxed);
+  }
+}
+
+FaceMetrics
+FaceMetricsCollector::snapshot() const
+{
+  FaceMetrics metrics;
+  metrics.nInInterests = m_nInInterests.load(std::memory_order_relaxed);
+  metrics.nInData = m_nInData.load(std::memory_order_relaxed);
+  metrics.nInNacks = m_nInNacks.load(std::memory_order_relaxed);
+  metrics.nOutInterests = m_nOutInterests.load(std::memory_order_relaxed);
+  metrics.nOutData = m_nOutData.load(std::memory_order_relaxed);
+  metrics.nOutNacks = m_nOutNacks.load(std::memory_order_relaxed);
+  metrics.nSatisfiedInterests = m_nSatisfiedInterests.load(std::memory_order_relaxed);
+  metrics.nTimedOutInterests = m_nTimedOutInterests.load(std::memory_order_relaxed);
+  metrics.nNackedInterests = m_nNackedInterests.load(std::memory_order_relaxed);
+  metrics.nSuppressedInterests = m_nSuppressedInterests.load(std::memory_order_relaxed);
+  metrics.nPitEntries = m_nPitEntries.load(std::memory_order_relaxed);
+  metrics.maxPitEntries = m_maxPitEntries.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < LatencyHistogram::N_BUCKETS; ++i) {
+    metrics.satisfyLatency.setBucketCount(i, m_satisfyLatency[i].load(std::memory_order_relaxed));
+  }
+  return metrics;
+}
+
+mgmt::StatusDatasetHandler
+makeFaceMetricsDatasetHandler(const Face& face)
+{
+  return [&face] (const Name&, const Interest&, mgmt::StatusDatasetContext& context) {
+    Block wire = face.getMetrics().wireEncode();
+    wire.parse();
+    for (const Block& element : wire.elements()) {
+      context.append(element);
+    }
+    context.end();
+  };
+}
+
+} // namespace util
+} // namespace ndn
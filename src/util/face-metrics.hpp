@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_FACE_METRICS_HPP
+#define NDN_UTIL_FACE_METRICS_HPP
+
+#include "../encoding/block.hpp"
+#include "../encoding/encoding-buffer-fwd.hpp"
+#include "../mgmt/status-dataset-context.hpp"
+#include "time.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace ndn {
+
+class Face;
+
+namespace util {
+
+/** \brief latency histogram with logarithmic buckets
+ *
+ *  Latencies are counted in microseconds.  Each power of two is split into
+ *  \p N_SUB_BUCKETS linear sub-buckets, so that the relative error of a bucket's lower bound
+ *  is at most 25%, regardless of the magnitude of the latency.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr size_t N_SUB_BUCKETS = 4;
+  static constexpr size_t N_BUCKETS = 160;
+
+  /** \return index of the bucket that counts \p latency
+   */
+  static size_t
+  getBucketIndex(time::nanoseconds latency);
+
+  /** \return smallest latency counted in the bucket at \p index
+   */
+  static time::nanoseconds
+  getBucketLowerBound(size_t index);
+
+  void
+  add(time::nanoseconds latency, uint64_t count = 1)
+  {
+    m_counts[getBucketIndex(latency)] += count;
+  }
+
+  uint64_t
+  getBucketCount(size_t index) const
+  {
+    return m_counts.at(index);
+  }
+
+  void
+  setBucketCount(size_t index, uint64_t count)
+  {
+    m_counts.at(index) = count;
+  }
+
+  /** \return total number of latencies counted
+   */
+  uint64_t
+  getCount() const;
+
+  /** \return lower bound of the bucket containing the \p quantile, or zero if histogram is empty
+   *  \param quantile a number within [0, 1]
+   */
+  time::nanoseconds
+  getQuantile(double quantile) const;
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_counts{};
+};
+
+/** \brief snapshot of the packet and latency counters of a Face
+ *
+ *  FaceMetrics is encoded as a Content block in the same style as nfd::ForwarderStatus.
+ *  In/out packet counters reuse the TLV-TYPE numbers of NFD general status (NInInterests etc.).
+ *  Other fields use application-specific TLV-TYPE numbers 160-170; see tlv_face_metrics in
+ *  face-metrics.cpp.
+ */
+class FaceMetrics
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  FaceMetrics() = default;
+
+  explicit
+  FaceMetrics(const Block& payload);
+
+  /** \brief prepend FaceMetrics as a Content block to the encoder
+   */
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const;
+
+  /** \brief encode FaceMetrics as a Content block
+   */
+  Block
+  wireEncode() const;
+
+  /** \brief decode FaceMetrics from a Content block
+   */
+  void
+  wireDecode(const Block& wire);
+
+public:
+  uint64_t nInInterests = 0;
+  uint64_t nInData = 0;
+  uint64_t nInNacks = 0;
+  uint64_t nOutInterests = 0;
+  uint64_t nOutData = 0;
+  uint64_t nOutNacks = 0;
+
+  uint64_t nSatisfiedInterests = 0; ///< expressed Interests satisfied by Data
+  uint64_t nTimedOutInterests = 0; ///< expressed Interests that timed out
+  uint64_t nNackedInterests = 0; ///< expressed Interests rejected by Nack
+  uint64_t nSuppressedInterests = 0; ///< expressed Interests aggregated without being sent
+
+  uint64_t nPitEntries = 0; ///< current number of pending Interests
+  uint64_t maxPitEntries = 0; ///< high-water mark of the number of pending Interests
+
+  uint64_t sendQueueLength = 0; ///< packets waiting in the transport send queue
+  uint64_t sendQueueBytes = 0; ///< bytes waiting in the transport send queue
+
+  LatencyHistogram satisfyLatency; ///< latency between expressing an Interest and receiving Data
+};
+
+std::ostream&
+operator<<(std::ostream& os, const FaceMetrics& metrics);
+
+/** \brief collects metrics of a Face
+ *
+ *  Counters are updated from the Face's io_service thread, and may be read from any thread
+ *  through snapshot().  All operations are lock-free.  A snapshot is not an atomic view of
+ *  all counters, but each counter is individually consistent.
+ */
+class FaceMetricsCollector : noncopyable
+{
+public:
+  FaceMetricsCollector();
+
+  void
+  recordInInterest()
+  {
+    increment(m_nInInterests);
+  }
+
+  void
+  recordInData()
+  {
+    increment(m_nInData);
+  }
+
+  void
+  recordInNack()
+  {
+    increment(m_nInNacks);
+  }
+
+  void
+  recordOutInterest()
+  {
+    increment(m_nOutInterests);
+  }
+
+  void
+  recordOutData()
+  {
+    increment(m_nOutData);
+  }
+
+  void
+  recordOutNack()
+  {
+    increment(m_nOutNacks);
+  }
+
+  void
+  recordSatisfiedInterest(time::nanoseconds latency)
+  {
+    increment(m_nSatisfiedInterests);
+    increment(m_satisfyLatency[LatencyHistogram::getBucketIndex(latency)]);
+  }
+
+  void
+  recordTimedOutInterest()
+  {
+    increment(m_nTimedOutInterests);
+  }
+
+  void
+  recordNackedInterest()
+  {
+    increment(m_nNackedInterests);
+  }
+
+  void
+  recordSuppressedInterest()
+  {
+    increment(m_nSuppressedInterests);
+  }
+
+  /** \brief record the current number of pending Interests
+   */
+  void
+  recordPitSize(size_t nPitEntries);
+
+  FaceMetrics
+  snapshot() const;
+
+private:
+  static void
+  increment(std::atomic<uint64_t>& counter)
+  {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> m_nInInterests;
+  std::atomic<uint64_t> m_nInData;
+  std::atomic<uint64_t> m_nInNacks;
+  std::atomic<uint64_t> m_nOutInterests;
+  std::atomic<uint64_t> m_nOutData;
+  std::atomic<uint64_t> m_nOutNacks;
+  std::atomic<uint64_t> m_nSatisfiedInterests;
+  std::atomic<uint64_t> m_nTimedOutInterests;
+  std::atomic<uint64_t> m_nNackedInterests;
+  std::atomic<uint64_t> m_nSuppressedInterests;
+  std::atomic<uint64_t> m_nPitEntries;
+  std::atomic<uint64_t> m_maxPitEntries;
+  std::array<std::atomic<uint64_t>, LatencyHistogram::N_BUCKETS> m_satisfyLatency;
+};
+
+/** \brief make a mgmt::StatusDatasetHandler that publishes the metrics of \p face
+ *
+ *  Usage:
+ *  \code
+ *  dispatcher.addStatusDataset("face-metrics", mgmt::makeAcceptAllAuthorization(),
+ *                              util::makeFaceMetricsDatasetHandler(face));
+ *  \endcode
+ *  The dataset payload can be decoded with FaceMetrics(Block(tlv::Content, payload)).
+ */
+mgmt::StatusDatasetHandler
+makeFaceMetricsDatasetHandler(const Face& face);
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_FACE_METRICS_HPP
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-pool.hpp"
+#include "logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace util {
+
+NDN_LOG_INIT(ndn.FacePool);
+
+/** \brief a Face together with the io_service and thread that drive it
+ */
+class FacePool::Shard : noncopyable
+{
+public:
+  Shard(size_t index, const FaceCreator& createFace)
+    : m_index(index)
+    , m_isStopping(false)
+  {
+    if (createFace == nullptr) {
+      face = make_unique<Face>(nullptr, ioService);
+    }
+    else {
+      face = createFace(ioService);
+      BOOST_ASSERT(face != nullptr);
+      BOOST_ASSERT(&face->getIoService() == &ioService);
+    }
+
+    m_thread = std::thread([this] { this->run(); });
+  }
+
+  ~Shard()
+  {
+    stop();
+  }
+
+  void
+  stop()
+  {
+    if (!m_thread.joinable()) {
+      return;
+    }
+
+    m_isStopping = true;
+    // handlers posted from one thread are executed in order, so asyncShutdown runs before stop
+    face->shutdown();
+    ioService.post([this] { ioService.stop(); });
+    m_thread.join();
+  }
+
+private:
+  void
+  run()
+  {
+    while (!m_isStopping) {
+      try {
+        face->processEvents(time::milliseconds::zero(), true);
+      }
+      catch (const std::exception& e) {
+        NDN_LOG_ERROR("face " << m_index << " processEvents error: " << e.what());
+      }
+    }
+  }
+
+public:
+  boost::asio::io_service ioService;
+  unique_ptr<Face> face;
+
+private:
+  const size_t m_index;
+  std::atomic<bool> m_isStopping;
+  std::thread m_thread;
+};
+
+FacePool::FacePool(size_t nFaces, ShardingPolicy policy, const FaceCreator& createFace)
+  : m_callbackIo(nullptr)
+  , m_policy(policy)
+  , m_nextFace(0)
+  , m_isShutdown(false)
+{
+  construct(nFaces, createFace);
+}
+
+FacePool::FacePool(boost::asio::io_service& callbackIo, size_t nFaces,
+                   ShardingPolicy policy, const FaceCreator& createFace)
+  : m_callbackIo(&callbackIo)
+  , m_policy(policy)
+  , m_nextFace(0)
+  , m_isShutdown(false)
+{
+  construct(nFaces, createFace);
+}
+
+FacePool::~FacePool()
+{
+  shutdown();
+}
+
+void
+FacePool::construct(size_t nFaces, const FaceCreator& createFace)
+{
+  if (nFaces == 0) {
+    BOOST_THROW_EXCEPTION(Error("FacePool must contain at least one Face"));
+  }
+
+  m_shards.reserve(nFaces);
+  for (size_t i = 0; i < nFaces; ++i) {
+    m_shards.push_back(make_unique<Shard>(i, createFace));
+  }
+  NDN_LOG_DEBUG("started " << nFaces << " faces");
+}
+
+Face&
+FacePool::getFace(size_t index) const
+{
+  return *m_shards.at(index)->face;
+}
+
+size_t
+FacePool::selectFace(const Name& name)
+{
+  switch (m_policy) {
+    case ShardingPolicy::NAME_HASH:
+      return std::hash<Name>()(name) % m_shards.size();
+    case ShardingPolicy::ROUND_ROBIN:
+      return m_nextFace++ % m_shards.size();
+  }
+  BOOST_ASSERT(false);
+  return 0;
+}
+
+FacePool::PendingInterestHandle
+FacePool::expressInterest(const Interest& interest,
+                          const DataCallback& afterSatisfied,
+                          const NackCallback& afterNacked,
+                          const TimeoutCallback& afterTimeout)
+{
+  size_t index = selectFace(interest.getName());
+  Face& face = *m_shards[index]->face;
+
+  if (m_callbackIo == nullptr) {
+    return {index, face.expressInterest(interest, afterSatisfied, afterNacked, afterTimeout)};
+  }
+
+  boost::asio::io_service& io = *m_callbackIo;
+  DataCallback onData;
+  if (afterSatisfied != nullptr) {
+    onData = [&io, afterSatisfied] (const Interest& i, const Data& d) {
+      io.post([afterSatisfied, i, d] { afterSatisfied(i, d); });
+    };
+  }
+  NackCallback onNack;
+  if (afterNacked != nullptr) {
+    onNack = [&io, afterNacked] (const Interest& i, const lp::Nack& n) {
+      io.post([afterNacked, i, n] { afterNacked(i, n); });
+    };
+  }
+  TimeoutCallback onTimeout;
+  if (afterTimeout != nullptr) {
+    onTimeout = [&io, afterTimeout] (const Interest& i) {
+      io.post([afterTimeout, i] { afterTimeout(i); });
+    };
+  }
+
+  return {index, face.expressInterest(interest, onData, onNack, onTimeout)};
+}
+
+void
+FacePool::removePendingInterest(const PendingInterestHandle& handle)
+{
+  if (handle.getPendingInterestId() == nullptr || handle.getFaceIndex() >= m_shards.size()) {
+    return;
+  }
+  m_shards[handle.getFaceIndex()]->face->removePendingInterest(handle.getPendingInterestId());
+}
+
+void
+FacePool::shutdown()
+{
+  if (m_isShutdown) {
+    return;
+  }
+  m_isShutdown = true;
+
+  for (auto& shard : m_shards) {
+    shard->stop();
+  }
+  NDN_LOG_DEBUG("stopped " << m_shards.size() << " faces");
+}
+
+} // namespace util
+} // namespace ndn
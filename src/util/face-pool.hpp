@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_FACE_POOL_HPP
+#define NDN_UTIL_FACE_POOL_HPP
+
+#include "../face.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+/** \brief a set of Faces that spreads a consumer workload across multiple threads
+ *
+ *  Every Face in the pool has its own io_service, its own transport connection and its own
+ *  PIT, and is driven by a dedicated thread.  Interests expressed through the pool are
+ *  assigned to one of the Faces according to a ShardingPolicy.
+ *
+ *  By default, Data/Nack/timeout callbacks are invoked in the thread of the Face that
+ *  expressed the Interest.  If a callback io_service is given, all callbacks are instead
+ *  posted to that io_service, so that the application observes them from a single thread.
+ *
+ *  \note expressInterest and removePendingInterest may be called from any thread.
+ *        Face::expressInterest assigns a missing Nonce in the calling thread; this is safe
+ *        because random::generateWord32 uses a per-thread engine.
+ */
+class FacePool : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** \brief determines which Face an expressed Interest is assigned to
+   */
+  enum class ShardingPolicy {
+    NAME_HASH,  ///< Interests with the same name are always assigned to the same Face
+    ROUND_ROBIN ///< Interests are assigned to each Face in turn
+  };
+
+  /** \brief a function that creates a Face operating on the given io_service
+   */
+  using FaceCreator = function<unique_ptr<Face>(boost::asio::io_service&)>;
+
+  /** \brief identifies an Interest expressed through FacePool
+   */
+  class PendingInterestHandle
+  {
+  public:
+    PendingInterestHandle()
+      : m_faceIndex(0)
+      , m_id(nullptr)
+    {
+    }
+
+    PendingInterestHandle(size_t faceIndex, const PendingInterestId* id)
+      : m_faceIndex(faceIndex)
+      , m_id(id)
+    {
+    }
+
+    /** \return index of the Face through which the Interest was expressed
+     */
+    size_t
+    getFaceIndex() const
+    {
+      return m_faceIndex;
+    }
+
+    const PendingInterestId*
+    getPendingInterestId() const
+    {
+      return m_id;
+    }
+
+  private:
+    size_t m_faceIndex;
+    const PendingInterestId* m_id;
+  };
+
+  /** \brief create a pool of Faces and start their threads
+   *  \param nFaces number of Faces, must be positive
+   *  \param policy how Interests are assigned to Faces
+   *  \param createFace creates each Face; if empty, Faces use the default transport
+   *                    (see Face(shared_ptr<Transport>, boost::asio::io_service&))
+   *  \throw Error nFaces is zero
+   */
+  explicit
+  FacePool(size_t nFaces, ShardingPolicy policy = ShardingPolicy::NAME_HASH,
+           const FaceCreator& createFace = nullptr);
+
+  /** \brief create a pool of Faces and start their threads, merging callback delivery
+   *  \param callbackIo all Data/Nack/timeout callbacks are posted to this io_service
+   *  \param nFaces number of Faces, must be positive
+   *  \param policy how Interests are assigned to Faces
+   *  \param createFace creates each Face; if empty, Faces use the default transport
+   *  \throw Error nFaces is zero
+   */
+  FacePool(boost::asio::io_service& callbackIo, size_t nFaces,
+           ShardingPolicy policy = ShardingPolicy::NAME_HASH,
+           const FaceCreator& createFace = nullptr);
+
+  /** \brief shut down all Faces and join their threads
+   */
+  ~FacePool();
+
+  /** \return number of Faces in the pool
+   */
+  size_t
+  size() const
+  {
+    return m_shards.size();
+  }
+
+  /** \return the index-th Face
+   *  \warning The Face is driven by its own thread; use Face::getIoService().post
+   *           to access it safely.
+   */
+  Face&
+  getFace(size_t index) const;
+
+  /** \return index of the Face that an Interest with the given name would be assigned to
+   *  \note With ROUND_ROBIN policy, each call advances the round-robin position.
+   */
+  size_t
+  selectFace(const Name& name);
+
+  /** \brief express Interest through one of the Faces
+   *  \sa Face::expressInterest
+   */
+  PendingInterestHandle
+  expressInterest(const Interest& interest,
+                  const DataCallback& afterSatisfied,
+                  const NackCallback& afterNacked,
+                  const TimeoutCallback& afterTimeout);
+
+  /** \brief cancel an Interest previously expressed through this pool
+   */
+  void
+  removePendingInterest(const PendingInterestHandle& handle);
+
+  /** \brief shut down all Faces and join their threads
+   *
+   *  Pending Interests are dropped without invoking their callbacks.
+   *  This is called by the destructor; calling it more than once has no effect.
+   */
+  void
+  shutdown();
+
+private:
+  class Shard;
+
+  void
+  construct(size_t nFaces, const FaceCreator& createFace);
+
+private:
+  boost::asio::io_service* m_callbackIo;
+  const ShardingPolicy m_policy;
+  std::vector<unique_ptr<Shard>> m_shards;
+  std::atomic<size_t> m_nextFace;
+  bool m_isShutdown;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_FACE_POOL_HPP
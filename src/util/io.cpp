@@ -20,39 +20,70 @@
  */
 
 #include "io.hpp"
-#include "../encoding/buffer-stream.hpp"
-#include "../security/transform.hpp"
+#include "string-helper.hpp"
+#include "detail/text-codec.hpp"
+#include "../encoding/buffer.hpp"
 
 namespace ndn {
 namespace io {
 
+/** \brief reads all remaining bytes from a stream
+ *  \return the bytes, or nullptr if a read error occurs
+ */
+static shared_ptr<Buffer>
+readAll(std::istream& is)
+{
+  const size_t CHUNK_SIZE = 4096;
+  auto buffer = make_shared<Buffer>();
+  size_t size = 0;
+  do {
+    buffer->resize(size + CHUNK_SIZE);
+    is.read(reinterpret_cast<char*>(buffer->data() + size), CHUNK_SIZE);
+    size += static_cast<size_t>(is.gcount());
+  } while (is);
+
+  if (is.bad()) {
+    return nullptr;
+  }
+  buffer->resize(size);
+  return buffer;
+}
+
 optional<Block>
 loadBlock(std::istream& is, IoEncoding encoding)
 {
-  namespace t = ndn::security::transform;
+  shared_ptr<Buffer> buffer = readAll(is);
+  if (buffer == nullptr) {
+    return nullopt;
+  }
 
-  OBufferStream os;
-  try {
-    switch (encoding) {
-      case NO_ENCODING:
-        t::streamSource(is) >> t::streamSink(os);
-        break;
-      case BASE64:
-        t::streamSource(is) >> t::stripSpace("\n") >> t::base64Decode(false) >> t::streamSink(os);
-        break;
-      case HEX:
-        t::streamSource(is) >> t::hexDecode() >> t::streamSink(os);
-        break;
-      default:
+  // decode in place, as the decoded content is never longer than its encoding
+  char* text = reinterpret_cast<char*>(buffer->data());
+  switch (encoding) {
+    case NO_ENCODING:
+      break;
+    case BASE64: {
+      util::detail::Base64Decoder decoder;
+      size_t size = decoder.decode(text, buffer->size(), buffer->data());
+      if (!decoder.isComplete()) {
         return nullopt;
+      }
+      buffer->resize(size);
+      break;
     }
-  }
-  catch (const t::Error&) {
-    return nullopt;
+    case HEX:
+      if (buffer->size() % 2 != 0 ||
+          !util::detail::decodeHex(text, buffer->size(), buffer->data())) {
+        return nullopt;
+      }
+      buffer->resize(buffer->size() / 2);
+      break;
+    default:
+      return nullopt;
   }
 
   try {
-    return make_optional<Block>(os.buf());
+    return make_optional<Block>(buffer);
   }
   catch (const tlv::Error&) {
     return nullopt;
@@ -65,25 +96,26 @@ loadBlock(std::istream& is, IoEncoding encoding)
 void
 saveBlock(const Block& block, std::ostream& os, IoEncoding encoding)
 {
-  namespace t = ndn::security::transform;
-
-  try {
-    switch (encoding) {
-      case NO_ENCODING:
-        t::bufferSource(block.wire(), block.size()) >> t::streamSink(os);
-        break;
-      case BASE64:
-        t::bufferSource(block.wire(), block.size()) >> t::base64Encode() >> t::streamSink(os);
-        break;
-      case HEX:
-        t::bufferSource(block.wire(), block.size()) >> t::hexEncode(true) >> t::streamSink(os);
-        break;
-      default:
-        BOOST_THROW_EXCEPTION(Error("unrecognized IoEncoding"));
+  switch (encoding) {
+    case NO_ENCODING:
+      os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+      break;
+    case BASE64: {
+      std::string text = toBase64(block.wire(), block.size());
+      os.write(text.data(), text.size());
+      break;
     }
+    case HEX: {
+      std::string text = toHex(block.wire(), block.size(), true);
+      os.write(text.data(), text.size());
+      break;
+    }
+    default:
+      BOOST_THROW_EXCEPTION(Error("unrecognized IoEncoding"));
   }
-  catch (const t::Error& e) {
-    BOOST_THROW_EXCEPTION(Error(e.what()));
+
+  if (os.bad()) {
+    BOOST_THROW_EXCEPTION(Error("Fail to write data into output stream"));
   }
 }
 
@@ -22,8 +22,14 @@
 #include "random.hpp"
 #include "../security/detail/openssl.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 #include <random>
 
+#include <pthread.h>
+
 namespace ndn {
 namespace random {
 
@@ -43,8 +49,63 @@ generateSecureWord64()
   return random;
 }
 
-void
-generateSecureBytes(uint8_t* bytes, size_t size)
+static const size_t POOL_SIZE = 512;
+static const size_t MAX_POOLED_REQUEST = 32;
+
+/** @brief incremented in the child process after fork()
+ *
+ *  Random state inherited from the parent process is discarded when this changes, so that the
+ *  parent and the child do not generate the same numbers.
+ */
+static std::atomic<unsigned> g_forkGeneration(0);
+
+namespace {
+
+/** @brief random state of a thread
+ */
+class ThreadState : noncopyable
+{
+public:
+  ThreadState()
+    : engine(0)
+    , engineGeneration(0)
+    , isEngineSeeded(false)
+    , poolPos(POOL_SIZE)
+    , poolGeneration(0)
+  {
+    static std::once_flag registerForkHandler;
+    std::call_once(registerForkHandler, [] {
+      pthread_atfork(nullptr, nullptr, [] { ++g_forkGeneration; });
+    });
+  }
+
+  ~ThreadState()
+  {
+    OPENSSL_cleanse(pool.data(), pool.size());
+  }
+
+public:
+  RandomNumberEngine engine;
+  unsigned engineGeneration;
+  bool isEngineSeeded;
+
+  /// secure random bytes; the bytes before poolPos have been consumed and cleared
+  std::array<uint8_t, POOL_SIZE> pool;
+  size_t poolPos;
+  unsigned poolGeneration;
+};
+
+} // namespace
+
+static ThreadState&
+getThreadState()
+{
+  thread_local ThreadState state;
+  return state;
+}
+
+static void
+fillSecureBytes(uint8_t* bytes, size_t size)
 {
   if (RAND_bytes(bytes, size) != 1) {
     BOOST_THROW_EXCEPTION(std::runtime_error("Failed to generate random bytes (error code " +
@@ -52,25 +113,75 @@ generateSecureBytes(uint8_t* bytes, size_t size)
   }
 }
 
-static std::mt19937&
-getRandomGenerator()
+void
+generateSecureBytes(uint8_t* bytes, size_t size)
 {
-  static std::mt19937 rng{std::random_device{}()};
-  return rng;
+  if (size > MAX_POOLED_REQUEST) {
+    fillSecureBytes(bytes, size);
+    return;
+  }
+
+  ThreadState& state = getThreadState();
+  unsigned generation = g_forkGeneration;
+  if (state.poolGeneration != generation) {
+    OPENSSL_cleanse(state.pool.data(), state.pool.size());
+    state.poolPos = POOL_SIZE;
+    state.poolGeneration = generation;
+  }
+
+  if (state.poolPos + size > POOL_SIZE) {
+    state.poolPos = POOL_SIZE;
+    fillSecureBytes(state.pool.data(), state.pool.size());
+    state.poolPos = 0;
+  }
+  std::memcpy(bytes, state.pool.data() + state.poolPos, size);
+  OPENSSL_cleanse(state.pool.data() + state.poolPos, size);
+  state.poolPos += size;
+}
+
+RandomNumberEngine::RandomNumberEngine(uint64_t seed)
+{
+  // expand the seed with SplitMix64, as recommended by the authors of xoshiro256**
+  for (uint64_t& word : m_state) {
+    seed += 0x9e3779b97f4a7c15;
+    uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    word = z ^ (z >> 31);
+  }
+}
+
+RandomNumberEngine&
+getRandomNumberEngine()
+{
+  ThreadState& state = getThreadState();
+  unsigned generation = g_forkGeneration;
+  if (!state.isEngineSeeded || state.engineGeneration != generation) {
+    uint64_t seed = 0;
+    try {
+      seed = generateSecureWord64();
+    }
+    catch (const std::runtime_error&) {
+      std::random_device device;
+      seed = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    state.engine = RandomNumberEngine(seed);
+    state.engineGeneration = generation;
+    state.isEngineSeeded = true;
+  }
+  return state.engine;
 }
 
 uint32_t
 generateWord32()
 {
-  static std::uniform_int_distribution<uint32_t> distribution;
-  return distribution(getRandomGenerator());
+  return static_cast<uint32_t>(getRandomNumberEngine()() >> 32);
 }
 
 uint64_t
 generateWord64()
 {
-  static std::uniform_int_distribution<uint64_t> distribution;
-  return distribution(getRandomGenerator());
+  return getRandomNumberEngine()();
 }
 
 } // namespace random
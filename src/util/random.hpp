@@ -46,11 +46,82 @@ generateSecureWord64();
 /**
  * @brief Fill @p bytes of @p size with cryptographically secure random bytes
  *
+ * Requests of up to 32 bytes are served from a per-thread pool, which is refilled from the
+ * OpenSSL generator in batches, and discarded in the child process after fork().
+ *
  * @throw std::runtime_error if generation fails.
  */
 void
 generateSecureBytes(uint8_t* bytes, size_t size);
 
+/**
+ * @brief A fast pseudo-random number engine, implementing the xoshiro256** algorithm
+ *
+ * This satisfies the UniformRandomBitGenerator requirements, so that it can be used with the
+ * distributions of the standard library.  It must not be used when cryptographically secure
+ * random numbers are needed.
+ *
+ * @sa David Blackman, Sebastiano Vigna, "Scrambled Linear Pseudorandom Number Generators",
+ *     ACM Transactions on Mathematical Software 47(4), 2021
+ */
+class RandomNumberEngine
+{
+public:
+  using result_type = uint64_t;
+
+  /**
+   * @brief Create an engine whose state is expanded from @p seed
+   */
+  explicit
+  RandomNumberEngine(uint64_t seed);
+
+  static constexpr result_type
+  min()
+  {
+    return 0;
+  }
+
+  static constexpr result_type
+  max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type
+  operator()()
+  {
+    const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+    const uint64_t t = m_state[1] << 17;
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = rotl(m_state[3], 45);
+    return result;
+  }
+
+private:
+  static uint64_t
+  rotl(uint64_t x, int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+private:
+  uint64_t m_state[4];
+};
+
+/**
+ * @brief Returns the pseudo-random number engine of the calling thread
+ *
+ * Every thread has its own engine, which is seeded with cryptographically secure random bytes
+ * when the thread first calls this function.  Therefore, the engine can be used without
+ * synchronization.
+ */
+RandomNumberEngine&
+getRandomNumberEngine();
+
 /**
  * @brief Generate a non-cryptographically-secure random integer in the range [0, 2^32)
  *
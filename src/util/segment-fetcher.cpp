@@ -200,9 +200,8 @@ SegmentFetcher::fetchSegmentsInWindow(const Interest& origInterest, shared_ptr<S
     interest.setCanBePrefix(false);
     interest.setMustBeFresh(false);
 
-    Name interestName(m_versionedDataName);
-    interestName.appendSegment(segment.first);
-    interest.setName(interestName);
+    m_segmentName.set(-1, Name::Component::fromSegment(segment.first));
+    interest.setName(m_segmentName);
     interest.setInterestLifetime(m_options.interestLifetime);
     m_nSegmentsInFlight++;
     auto pendingInterest = m_face.expressInterest(interest,
@@ -308,6 +307,9 @@ SegmentFetcher::afterValidationSuccess(const Data& data,
 
   if (m_receivedSegments.size() == 1) {
     m_versionedDataName = data.getName().getPrefix(-1);
+    // leave room for the largest segment component, which replaces the last component in place
+    m_segmentName = data.getName();
+    m_segmentName.reserve(m_segmentName.size(), m_segmentName.wireEncode().value_size() + 8);
     if (currentSegment == 0) {
       // We received the first segment in response, so we can increment the next segment number
       m_nextSegmentNum++;
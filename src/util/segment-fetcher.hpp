@@ -365,6 +365,7 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   time::steady_clock::TimePoint m_timeLastSegmentReceived;
   std::queue<uint64_t> m_retxQueue;
   Name m_versionedDataName;
+  Name m_segmentName; ///< m_versionedDataName followed by the most recently requested segment
   uint64_t m_nextSegmentNum;
   double m_cwnd;
   double m_ssthresh;
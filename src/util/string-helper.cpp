@@ -20,12 +20,8 @@
  */
 
 #include "string-helper.hpp"
+#include "detail/text-codec.hpp"
 #include "../encoding/buffer.hpp"
-#include "../encoding/buffer-stream.hpp"
-#include "../security/transform/buffer-source.hpp"
-#include "../security/transform/hex-decode.hpp"
-#include "../security/transform/hex-encode.hpp"
-#include "../security/transform/stream-sink.hpp"
 
 #include <sstream>
 
@@ -52,9 +48,17 @@ printHex(std::ostream& os, uint64_t num, bool wantUpperCase)
 void
 printHex(std::ostream& os, const uint8_t* buffer, size_t length, bool wantUpperCase)
 {
-  namespace tr = security::transform;
   BOOST_ASSERT(buffer != nullptr || length == 0);
-  tr::bufferSource(buffer, length) >> tr::hexEncode(wantUpperCase) >> tr::streamSink(os);
+
+  // encode in chunks that fit on the stack
+  char chunk[512];
+  while (length > 0) {
+    size_t n = std::min(length, sizeof(chunk) / 2);
+    util::detail::encodeHex(buffer, n, chunk, wantUpperCase);
+    os.write(chunk, 2 * n);
+    buffer += n;
+    length -= n;
+  }
 }
 
 void
@@ -66,9 +70,11 @@ printHex(std::ostream& os, const Buffer& buffer, bool wantUpperCase)
 std::string
 toHex(const uint8_t* buffer, size_t length, bool wantUpperCase)
 {
-  std::ostringstream result;
-  printHex(result, buffer, length, wantUpperCase);
-  return result.str();
+  BOOST_ASSERT(buffer != nullptr || length == 0);
+
+  std::string result(2 * length, '\0');
+  util::detail::encodeHex(buffer, length, &result[0], wantUpperCase);
+  return result;
 }
 
 std::string
@@ -80,17 +86,46 @@ toHex(const Buffer& buffer, bool wantUpperCase)
 shared_ptr<Buffer>
 fromHex(const std::string& hexString)
 {
-  namespace tr = security::transform;
-
-  OBufferStream os;
-  try {
-    tr::bufferSource(hexString) >> tr::hexDecode() >> tr::streamSink(os);
+  if (hexString.size() % 2 != 0) {
+    BOOST_THROW_EXCEPTION(StringHelperError("Conversion from hex failed: Incomplete input"));
   }
-  catch (const tr::Error& e) {
-    BOOST_THROW_EXCEPTION(StringHelperError("Conversion from hex failed: "s + e.what()));
+
+  auto buffer = make_shared<Buffer>(hexString.size() / 2);
+  if (!util::detail::decodeHex(hexString.data(), hexString.size(), buffer->data())) {
+    BOOST_THROW_EXCEPTION(StringHelperError("Conversion from hex failed: Wrong input byte"));
   }
+  return buffer;
+}
+
+std::string
+toBase64(const uint8_t* buffer, size_t length, bool needBreak)
+{
+  BOOST_ASSERT(buffer != nullptr || length == 0);
+
+  std::string result(util::detail::getBase64EncodedSize(length, needBreak), '\0');
+  util::detail::encodeBase64(buffer, length, &result[0], needBreak);
+  return result;
+}
+
+std::string
+toBase64(const Buffer& buffer, bool needBreak)
+{
+  return toBase64(buffer.data(), buffer.size(), needBreak);
+}
 
-  return os.buf();
+shared_ptr<Buffer>
+fromBase64(const std::string& base64String)
+{
+  auto buffer = make_shared<Buffer>((base64String.size() + 3) / 4 * 3);
+  util::detail::Base64Decoder decoder;
+  size_t length = decoder.decode(base64String.data(), base64String.size(), buffer->data());
+  if (!decoder.isComplete()) {
+    BOOST_THROW_EXCEPTION(StringHelperError(decoder.hasError() ?
+                                            "Conversion from base64 failed: Wrong input byte" :
+                                            "Conversion from base64 failed: Incomplete input"));
+  }
+  buffer->resize(length);
+  return buffer;
 }
 
 std::string
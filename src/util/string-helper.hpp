@@ -150,6 +150,43 @@ toHex(const Buffer& buffer, bool wantUpperCase = true);
 shared_ptr<Buffer>
 fromHex(const std::string& hexString);
 
+/**
+ * @brief Return a string containing the base64 encoding of the bytes in @p buffer
+ *
+ * @param buffer Pointer to an array of bytes
+ * @param length Size of the array
+ * @param needBreak if true (the default), insert a newline after every 64 characters and
+ *                  at the end of the output
+ *
+ * Examples:
+ *
+ * @code
+ * toBase64("foobar", false) == "Zm9vYmFy"
+ * toBase64("fooba", false) == "Zm9vYmE="
+ * @endcode
+ */
+std::string
+toBase64(const uint8_t* buffer, size_t length, bool needBreak = true);
+
+/**
+ * @brief Return a string containing the base64 encoding of the bytes in @p buffer
+ *
+ * @param buffer Buffer of bytes to convert to base64 format
+ * @param needBreak if true (the default), insert a newline after every 64 characters and
+ *                  at the end of the output
+ */
+std::string
+toBase64(const Buffer& buffer, bool needBreak = true);
+
+/**
+ * @brief Convert the base64 string to buffer
+ * @param base64String base64 encoding with padding; whitespace is ignored anywhere
+ *        (e.g., "Zm9v\nYmE=\n")
+ * @throw StringHelperError if input is invalid
+ */
+shared_ptr<Buffer>
+fromBase64(const std::string& base64String);
+
 /**
  * @brief Convert (the least significant nibble of) @p n to the corresponding hex character
  */
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Codec Benchmark
+
+#include "util/string-helper.hpp"
+#include "util/detail/text-codec.hpp"
+#include "util/io.hpp"
+#include "encoding/buffer-stream.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "security/transform/base64-decode.hpp"
+#include "security/transform/base64-encode.hpp"
+#include "security/transform/buffer-source.hpp"
+#include "security/transform/stream-sink.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+#include <sstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+using detail::SimdLevel;
+
+const size_t INPUT_SIZE = 1024 * 1024;
+const int N_ITERATIONS = 200;
+
+static Buffer
+makeInput()
+{
+  Buffer input(INPUT_SIZE);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 2654435761U >> 13);
+  }
+  return input;
+}
+
+static std::ostream&
+operator<<(std::ostream& os, SimdLevel level)
+{
+  switch (level) {
+    case SimdLevel::NONE:
+      return os << "none";
+    case SimdLevel::SSSE3:
+      return os << "ssse3";
+    case SimdLevel::AVX2:
+      return os << "avx2";
+  }
+  return os;
+}
+
+// Benchmark of hex and base64 conversion of a 1 MiB buffer with each instruction set.
+// Run this benchmark with:
+//    ./codec-benchmark -t Direct
+// For accurate results, it is required to compile ndn-cxx in release mode.
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  const Buffer input = makeInput();
+  SimdLevel defaultLevel = detail::getSimdLevel();
+
+  for (SimdLevel level : {SimdLevel::NONE, SimdLevel::SSSE3, SimdLevel::AVX2}) {
+    if (detail::setSimdLevel(level) != level) {
+      std::cout << level << " not supported" << std::endl;
+      continue;
+    }
+
+    std::string hex;
+    auto d1 = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        hex = toHex(input);
+      }
+    });
+    shared_ptr<Buffer> hexDecoded;
+    auto d2 = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        hexDecoded = fromHex(hex);
+      }
+    });
+    BOOST_CHECK(*hexDecoded == input);
+
+    std::string base64;
+    auto d3 = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        base64 = toBase64(input);
+      }
+    });
+    shared_ptr<Buffer> base64Decoded;
+    auto d4 = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        base64Decoded = fromBase64(base64);
+      }
+    });
+    BOOST_CHECK(*base64Decoded == input);
+
+    std::cout << level << " toHex " << d1 << ", fromHex " << d2
+              << ", toBase64 " << d3 << ", fromBase64 " << d4 << std::endl;
+  }
+
+  detail::setSimdLevel(defaultLevel);
+}
+
+// Benchmark of base64 conversion through the transform chain and through io::loadBlock and
+// io::saveBlock, with the instruction set selected at runtime.
+// Run this benchmark with:
+//    ./codec-benchmark -t Chain
+BOOST_AUTO_TEST_CASE(Chain)
+{
+  namespace tr = security::transform;
+
+  const Buffer input = makeInput();
+
+  std::string base64;
+  auto d1 = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      std::ostringstream os;
+      tr::bufferSource(input) >> tr::base64Encode() >> tr::streamSink(os);
+      base64 = os.str();
+    }
+  });
+  BOOST_CHECK_EQUAL(base64, toBase64(input));
+
+  ConstBufferPtr decoded;
+  auto d2 = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      OBufferStream os;
+      tr::bufferSource(base64) >> tr::base64Decode() >> tr::streamSink(os);
+      decoded = os.buf();
+    }
+  });
+  BOOST_CHECK(*decoded == input);
+
+  EncodingBuffer encoder;
+  encoder.prependByteArrayBlock(tlv::Content, input.data(), input.size());
+  Block block = encoder.block();
+
+  std::string saved;
+  auto d3 = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      std::ostringstream os;
+      io::saveBlock(block, os);
+      saved = os.str();
+    }
+  });
+
+  optional<Block> loaded;
+  auto d4 = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      std::istringstream is(saved);
+      loaded = io::loadBlock(is);
+    }
+  });
+  BOOST_REQUIRE(loaded);
+  BOOST_CHECK(*loaded == block);
+
+  std::cout << detail::getSimdLevel() << " base64Encode " << d1 << ", base64Decode " << d2
+            << ", io::saveBlock " << d3 << ", io::loadBlock " << d4 << std::endl;
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
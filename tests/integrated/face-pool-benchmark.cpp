@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx FacePool Benchmark
+
+#include "util/face-pool.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+/** \brief a stand-in forwarder that answers every Interest with a Data of the same name
+ */
+static FacePool::FaceCreator
+makeEchoFaces(KeyChain& keyChain)
+{
+  return [&keyChain] (boost::asio::io_service& io) {
+    auto face = make_unique<DummyClientFace>(io, keyChain, DummyClientFace::Options{false, false});
+    DummyClientFace* facePtr = face.get();
+    face->onSendInterest.connect([facePtr] (const Interest& interest) {
+      auto data = makeData(interest.getName());
+      facePtr->getIoService().post([facePtr, data] { facePtr->receive(*data); });
+    });
+    return face;
+  };
+}
+
+/** \brief keep a fixed window of Interests outstanding until nInterests are satisfied
+ */
+static time::nanoseconds
+runWorkload(FacePool& pool, size_t nInterests, size_t window)
+{
+  std::atomic<size_t> nSent(0);
+  std::atomic<size_t> nReceived(0);
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  function<void()> sendNext = [&] {
+    size_t seq = nSent++;
+    if (seq >= nInterests) {
+      return;
+    }
+    pool.expressInterest(*makeInterest(Name("/bench").appendSequenceNumber(seq)),
+                         [&] (const Interest&, const Data&) {
+                           if (++nReceived == nInterests) {
+                             std::lock_guard<std::mutex> lock(mutex);
+                             cv.notify_one();
+                           }
+                           else {
+                             sendNext();
+                           }
+                         },
+                         nullptr, nullptr);
+  };
+
+  return timedExecute([&] {
+    for (size_t i = 0; i < window; ++i) {
+      sendNext();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return nReceived == nInterests; });
+  });
+}
+
+BOOST_AUTO_TEST_CASE(Scaling)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+
+  const size_t nInterests = 200000;
+  const size_t window = 1000;
+  size_t maxFaces = std::max(1U, std::min(8U, std::thread::hardware_concurrency()));
+
+  for (size_t nFaces = 1; nFaces <= maxFaces; nFaces *= 2) {
+    FacePool pool(nFaces, FacePool::ShardingPolicy::ROUND_ROBIN, makeEchoFaces(keyChain));
+    time::nanoseconds d = runWorkload(pool, nInterests, window);
+
+    double rate = nInterests / (d.count() / 1e9);
+    std::cout << nFaces << " faces: " << nInterests << " Interests in " << d
+              << ", " << static_cast<uint64_t>(rate) << " Interests/s" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
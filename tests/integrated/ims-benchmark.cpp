@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx InMemoryStorage Benchmark
+
+#include "ims/in-memory-storage-persistent.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <iostream>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+  boost::asio::io_service io;
+  InMemoryStoragePersistent ims(io);
+
+  // /bench/<prefix>/<seq>: every prefix has nChildren entries, the first half of them are stale
+  const size_t nPrefixes = 1000;
+  const size_t nChildren = 1000;
+  const size_t nEntries = nPrefixes * nChildren;
+
+  auto d1 = timedExecute([&] {
+    for (size_t i = 0; i < nEntries; ++i) {
+      auto data = makeData(Name("/bench").appendNumber(i / nChildren).appendNumber(i % nChildren));
+      bool isStale = i % nChildren < nChildren / 2;
+      ims.insert(*data, isStale ? 1_ms : InMemoryStorage::INFINITE_WINDOW);
+    }
+  });
+  std::cout << "insert " << nEntries << " Data: " << d1 << std::endl;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  io.run();
+
+  const size_t nLookups = 100000;
+  std::vector<shared_ptr<Interest>> interests;
+  for (size_t i = 0; i < nLookups; ++i) {
+    auto interest = makeInterest(Name("/bench").appendNumber(i * 7919 % nPrefixes), true);
+    interest->setMustBeFresh(i % 2 == 0);
+    interest->setChildSelector(i % 4 < 2 ? 0 : 1);
+    interests.push_back(interest);
+  }
+
+  size_t nFound = 0;
+  auto d2 = timedExecute([&] {
+    for (const auto& interest : interests) {
+      nFound += ims.find(*interest) != nullptr;
+    }
+  });
+  BOOST_CHECK_EQUAL(nFound, nLookups);
+  std::cout << "find " << nLookups << " CanBePrefix Interests (half MustBeFresh, half rightmost): "
+            << d2 << std::endl;
+
+  auto d3 = timedExecute([&] {
+    for (size_t i = 0; i < nLookups; ++i) {
+      size_t j = i * 7919 % nEntries;
+      nFound += ims.find(Name("/bench").appendNumber(j / nChildren).appendNumber(j % nChildren))
+                != nullptr;
+    }
+  });
+  BOOST_CHECK_EQUAL(nFound, 2 * nLookups);
+  std::cout << "find " << nLookups << " Names: " << d3 << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(InsertFreshness)
+{
+  boost::asio::io_service io;
+  InMemoryStoragePersistent ims(io);
+
+  const size_t nEntries = 200000;
+  std::vector<shared_ptr<Data>> packets;
+  for (size_t i = 0; i < nEntries; ++i) {
+    packets.push_back(makeData(Name("/bench").appendNumber(i / 1000).appendNumber(i % 1000)));
+    packets.back()->getFullName(); // exclude digest computation from the measurement
+  }
+
+  auto d1 = timedExecute([&] {
+    for (const auto& data : packets) {
+      ims.insert(*data, 10_s);
+    }
+  });
+  std::cout << "insert " << nEntries << " Data with MustBeFresh processing window: " << d1
+            << std::endl;
+
+  auto interest = makeInterest("/bench", true);
+  interest->setMustBeFresh(true);
+  auto d2 = timedExecute([&] {
+    for (size_t i = 0; i < nEntries; ++i) {
+      ims.find(*interest);
+    }
+  });
+  std::cout << "find " << nEntries << " MustBeFresh Interests: " << d2 << std::endl;
+
+  ims.erase("/");
+}
+
+} // namespace tests
+} // namespace ndn
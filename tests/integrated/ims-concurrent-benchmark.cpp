@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx ConcurrentInMemoryStorage Benchmark
+
+#include "ims/concurrent-in-memory-storage.hpp"
+#include "ims/in-memory-storage-lru.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+#include "timed-execute.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+// Producer threads insert Data under their own namespaces, while the same number of reader
+// threads look up Interests for packets of every producer.  A single InMemoryStorageLru
+// protected by one mutex is compared with a ConcurrentInMemoryStorage.
+
+const size_t MAX_THREADS = 4;
+const size_t N_PACKETS_PER_PRODUCER = 50000;
+const size_t N_LOOKUPS_PER_READER = 200000;
+const size_t LIMIT = 100000;
+
+struct Workload
+{
+  std::vector<std::vector<shared_ptr<Data>>> packets;
+  std::vector<shared_ptr<Interest>> interests;
+};
+
+static Workload
+makeWorkload()
+{
+  Workload workload;
+  workload.packets.resize(MAX_THREADS);
+  for (size_t i = 0; i < MAX_THREADS; ++i) {
+    for (size_t j = 0; j < N_PACKETS_PER_PRODUCER; ++j) {
+      workload.packets[i].push_back(makeData(Name("/producer").appendNumber(i).appendNumber(j)));
+    }
+  }
+  for (size_t k = 0; k < 20000; ++k) {
+    size_t i = k % MAX_THREADS;
+    size_t j = k * 7919 % N_PACKETS_PER_PRODUCER;
+    workload.interests.push_back(makeInterest(workload.packets[i][j]->getName()));
+  }
+  return workload;
+}
+
+template<typename Insert, typename Find>
+static void
+runWorkload(const std::string& label, const Workload& workload, size_t nThreads,
+            const Insert& insert, const Find& find)
+{
+  std::atomic<size_t> nFound(0);
+  auto d = timedExecute([&] {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&workload, &insert, i] {
+        for (const auto& data : workload.packets[i]) {
+          insert(*data);
+        }
+      });
+      threads.emplace_back([&workload, &find, &nFound, i] {
+        size_t n = 0;
+        for (size_t j = 0; j < N_LOOKUPS_PER_READER; ++j) {
+          n += find(*workload.interests[(i * 7919 + j) % workload.interests.size()]) != nullptr;
+        }
+        nFound += n;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+
+  double seconds = time::duration_cast<time::duration<double>>(d).count();
+  std::cout << std::left << std::setw(36) << label << std::right
+            << nThreads << "+" << nThreads << " threads  "
+            << std::setw(10) << static_cast<size_t>(nThreads * N_PACKETS_PER_PRODUCER / seconds)
+            << " inserts/s  "
+            << std::setw(10) << static_cast<size_t>(nThreads * N_LOOKUPS_PER_READER / seconds)
+            << " finds/s  " << nFound << " found" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  Workload workload = makeWorkload();
+  std::cout << "hardware concurrency " << std::thread::hardware_concurrency()
+            << ", storage limit " << LIMIT << " packets" << std::endl;
+
+  for (size_t nThreads = 1; nThreads <= MAX_THREADS; nThreads *= 2) {
+    {
+      InMemoryStorageLru ims(LIMIT);
+      std::mutex mutex;
+      runWorkload("InMemoryStorageLru with one mutex", workload, nThreads,
+        [&] (const Data& data) {
+          std::lock_guard<std::mutex> lock(mutex);
+          ims.insert(data);
+        },
+        [&] (const Interest& interest) {
+          std::lock_guard<std::mutex> lock(mutex);
+          return ims.find(interest);
+        });
+    }
+    {
+      ConcurrentInMemoryStorage ims(LIMIT, 16, 3);
+      runWorkload("ConcurrentInMemoryStorage", workload, nThreads,
+        [&] (const Data& data) { ims.insert(data); },
+        [&] (const Interest& interest) { return ims.find(interest); });
+    }
+  }
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx InMemoryStorage Trace Benchmark
+
+#include "ims/in-memory-storage-arc.hpp"
+#include "ims/in-memory-storage-fifo.hpp"
+#include "ims/in-memory-storage-lfu.hpp"
+#include "ims/in-memory-storage-lru.hpp"
+#include "ims/in-memory-storage-tinylfu.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+#include "timed-execute.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace ndn {
+namespace tests {
+
+// Usage: ims-trace-benchmark [-- <trace-file> [<cache-size>]]
+//
+// A trace file contains one Name URI per line, which is requested in order.  Each request looks
+// up the Name in the storage, and inserts a Data of that Name if it is not found.
+// Without a trace file, a synthetic trace is generated, in which requests for a Zipf-distributed
+// catalogue are interleaved with bulk consumers fetching long sequences of segments once.
+
+using Trace = std::vector<Name>;
+
+static Trace
+loadTrace(const std::string& filename)
+{
+  std::ifstream is(filename);
+  if (!is) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("cannot open " + filename));
+  }
+
+  Trace trace;
+  std::string line;
+  while (std::getline(is, line)) {
+    if (!line.empty()) {
+      trace.emplace_back(line);
+    }
+  }
+  return trace;
+}
+
+static Trace
+makeSyntheticTrace(size_t nRequests, size_t nObjects, size_t scanLength)
+{
+  const double zipfExponent = 0.9;
+  std::vector<double> cdf(nObjects);
+  double sum = 0;
+  for (size_t i = 0; i < nObjects; ++i) {
+    sum += 1.0 / std::pow(i + 1, zipfExponent);
+    cdf[i] = sum;
+  }
+
+  std::mt19937 rng(4242);
+  std::uniform_real_distribution<double> uniform(0, sum);
+  std::bernoulli_distribution isScanRequest(0.3);
+
+  Trace trace;
+  trace.reserve(nRequests);
+  size_t nScans = 0;
+  size_t scanPos = scanLength;
+  while (trace.size() < nRequests) {
+    if (isScanRequest(rng)) {
+      if (scanPos == scanLength) {
+        ++nScans;
+        scanPos = 0;
+      }
+      trace.push_back(Name("/bulk").appendNumber(nScans).appendSegment(scanPos++));
+    }
+    else {
+      size_t object = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+      trace.push_back(Name("/popular").appendNumber(object));
+    }
+  }
+  return trace;
+}
+
+template<typename Ims>
+static void
+replay(const std::string& policy, const Trace& trace,
+       const std::unordered_map<Name, shared_ptr<Data>>& packets, size_t cacheSize)
+{
+  Ims ims(cacheSize);
+  size_t nHits = 0;
+
+  auto d = timedExecute([&] {
+    for (const Name& name : trace) {
+      if (ims.find(name) != nullptr) {
+        ++nHits;
+      }
+      else {
+        ims.insert(*packets.at(name));
+      }
+    }
+  });
+
+  std::cout << std::left << std::setw(10) << policy << std::right
+            << " hit ratio " << std::fixed << std::setprecision(4)
+            << static_cast<double>(nHits) / trace.size()
+            << ", " << std::setw(10) << static_cast<uint64_t>(trace.size() / (d.count() / 1e9))
+            << " requests/s" << std::endl;
+  std::cout.unsetf(std::ios::fixed);
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  auto& args = boost::unit_test::framework::master_test_suite();
+  Trace trace = args.argc > 1 ? loadTrace(args.argv[1]) :
+                makeSyntheticTrace(500000, 50000, 5000);
+  size_t cacheSize = args.argc > 2 ? std::strtoul(args.argv[2], nullptr, 10) : 2500;
+  BOOST_REQUIRE(!trace.empty());
+
+  std::unordered_map<Name, shared_ptr<Data>> packets;
+  for (const Name& name : trace) {
+    if (packets.count(name) == 0) {
+      packets.emplace(name, makeData(name));
+    }
+  }
+  std::cout << trace.size() << " requests for " << packets.size() << " distinct Names, "
+            << "storage limit " << cacheSize << " packets" << std::endl;
+
+  replay<InMemoryStorageFifo>("FIFO", trace, packets, cacheSize);
+  replay<InMemoryStorageLru>("LRU", trace, packets, cacheSize);
+  replay<InMemoryStorageLfu>("LFU", trace, packets, cacheSize);
+  replay<InMemoryStorageArc>("ARC", trace, packets, cacheSize);
+  replay<InMemoryStorageTinyLfu>("W-TinyLFU", trace, packets, cacheSize);
+}
+
+} // namespace tests
+} // namespace ndn
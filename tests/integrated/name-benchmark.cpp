@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Name Benchmark
+
+#include "name.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_CASE(SegmentNames)
+{
+  const Name prefix("/localhost/nfd/faces/list/%FD%00%00%01%62%3A%1C%2B%00");
+  const size_t nSegments = 1000000;
+  size_t totalSize = 0;
+
+  auto d1 = timedExecute([&] {
+    for (uint64_t segment = 0; segment < nSegments; ++segment) {
+      Name name(prefix);
+      name.appendSegment(segment);
+      totalSize += name.wireEncode().size();
+    }
+  });
+
+  auto d2 = timedExecute([&] {
+    Name name(prefix);
+    name.reserve(prefix.size() + 1, prefix.wireEncode().value_size() + 11);
+    name.appendSegment(0);
+    for (uint64_t segment = 0; segment < nSegments; ++segment) {
+      name.set(-1, name::Component::fromSegment(segment));
+      totalSize += name.wireEncode().size();
+    }
+  });
+
+  // each name is retained until the next one is generated, so the buffer is copied every time
+  auto d3 = timedExecute([&] {
+    Name name(prefix);
+    name.reserve(prefix.size() + 1, prefix.wireEncode().value_size() + 11);
+    name.appendSegment(0);
+    Name previous;
+    for (uint64_t segment = 0; segment < nSegments; ++segment) {
+      name.set(-1, name::Component::fromSegment(segment));
+      totalSize += name.wireEncode().size();
+      previous = name;
+    }
+  });
+
+  std::cout << "copy prefix and appendSegment " << nSegments << " times: " << d1 << std::endl;
+  std::cout << "set(-1) on reserved name " << nSegments << " times: " << d2 << std::endl;
+  std::cout << "set(-1) on shared reserved name " << nSegments << " times: " << d3 << std::endl;
+  BOOST_CHECK_GT(totalSize, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UriRoundTrip)
+{
+  std::vector<std::string> uris;
+  for (size_t i = 0; i < 1000; ++i) {
+    uris.push_back("/ndn/edu/ucla/%C1.Router/cs/" + to_string(i) + "/sensor-" + to_string(i % 7) +
+                   "/%FD%00%00%01%82%3A%1C%2B%00/%00%0" + to_string(i % 10));
+  }
+  const size_t nRepeats = 1000;
+  std::vector<Name> names(uris.size());
+  size_t totalLength = 0;
+
+  auto d1 = timedExecute([&] {
+    for (size_t r = 0; r < nRepeats; ++r) {
+      for (size_t i = 0; i < uris.size(); ++i) {
+        names[i] = Name(uris[i]);
+      }
+    }
+  });
+
+  auto d2 = timedExecute([&] {
+    for (size_t r = 0; r < nRepeats; ++r) {
+      for (const Name& name : names) {
+        totalLength += name.toUri().size();
+      }
+    }
+  });
+
+  for (size_t i = 0; i < uris.size(); ++i) {
+    BOOST_CHECK_EQUAL(names[i].toUri(), uris[i]);
+  }
+
+  size_t nNames = uris.size() * nRepeats;
+  std::cout << "parse " << nNames << " URIs: " << d1 << std::endl;
+  std::cout << "print " << nNames << " URIs: " << d2 << std::endl;
+  BOOST_CHECK_GT(totalLength, 0);
+}
+
+} // namespace tests
+} // namespace ndn
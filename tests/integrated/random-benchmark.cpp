@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Random Benchmark
+
+#include "interest.hpp"
+#include "util/random.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+const size_t N_ITERATIONS = 10000000;
+
+BOOST_AUTO_TEST_CASE(Words)
+{
+  uint64_t sink = 0;
+
+  auto d1 = timedExecute([&] {
+    for (size_t i = 0; i < N_ITERATIONS; ++i) {
+      sink += random::generateWord32();
+    }
+  });
+
+  auto d2 = timedExecute([&] {
+    for (size_t i = 0; i < N_ITERATIONS; ++i) {
+      sink += random::generateSecureWord32();
+    }
+  });
+
+  std::cout << "generateWord32 " << N_ITERATIONS << " times: " << d1 << std::endl;
+  std::cout << "generateSecureWord32 " << N_ITERATIONS << " times: " << d2 << std::endl;
+  BOOST_CHECK_NE(sink, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Nonces)
+{
+  const size_t nInterests = 1000000;
+  std::vector<Interest> interests(nInterests, Interest("/A"));
+
+  auto d1 = timedExecute([&] {
+    for (Interest& interest : interests) {
+      interest.setNonce(random::generateWord32());
+    }
+  });
+
+  auto d2 = timedExecute([&] {
+    Interest::setRandomNonces(interests.begin(), interests.end());
+  });
+
+  std::cout << "setNonce(generateWord32()) " << nInterests << " Interests: " << d1 << std::endl;
+  std::cout << "setRandomNonces " << nInterests << " Interests: " << d2 << std::endl;
+}
+
+} // namespace tests
+} // namespace ndn
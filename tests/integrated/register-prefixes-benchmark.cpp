@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Bulk Prefix Registration Benchmark
+
+#include "face.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+
+static std::vector<Name>
+makePrefixes(size_t nPrefixes)
+{
+  std::vector<Name> prefixes;
+  prefixes.reserve(nPrefixes);
+  for (size_t i = 0; i < nPrefixes; ++i) {
+    prefixes.push_back(Name("/bench").appendNumber(i));
+  }
+  return prefixes;
+}
+
+static void
+printRate(const std::string& label, size_t nPrefixes, time::nanoseconds d)
+{
+  double rate = nPrefixes / (d.count() / 1e9);
+  std::cout << label << ": " << nPrefixes << " prefixes in " << d
+            << ", " << static_cast<uint64_t>(rate) << " registrations/s" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  keyChain.createIdentity("/bench/identity");
+
+  const size_t nPrefixes = 5000;
+  std::vector<Name> prefixes = makePrefixes(nPrefixes);
+
+  // baseline: one registerPrefix call per prefix
+  {
+    DummyClientFace face(keyChain, DummyClientFace::Options{false, true});
+    size_t nRegistered = 0;
+    time::nanoseconds d = timedExecute([&] {
+      for (const Name& prefix : prefixes) {
+        face.registerPrefix(prefix, [&] (const Name&) { ++nRegistered; }, nullptr);
+      }
+      face.processEvents();
+    });
+    BOOST_CHECK_EQUAL(nRegistered, nPrefixes);
+    printRate("registerPrefix", nPrefixes, d);
+  }
+
+  for (size_t window : {1, 16, 64, 256}) {
+    DummyClientFace face(keyChain, DummyClientFace::Options{false, true});
+    RegisterPrefixesOptions options;
+    options.window = window;
+
+    RegisterPrefixesResult result;
+    time::nanoseconds d = timedExecute([&] {
+      face.registerPrefixes(prefixes, [&] (const RegisterPrefixesResult& r) { result = r; },
+                            options);
+      face.processEvents();
+    });
+    BOOST_CHECK_EQUAL(result.registered.size(), nPrefixes);
+    printRate("registerPrefixes window=" + to_string(window), nPrefixes, d);
+  }
+}
+
+} // namespace tests
+} // namespace ndn
@@ -341,6 +341,72 @@ BOOST_AUTO_TEST_CASE(UnrecognizedCriticalElement)
     tlv::Error);
 }
 
+BOOST_AUTO_TEST_CASE(Lazy)
+{
+  Block wire("063D 0703080144 140D 180101 19020FA0 1A0408026662 1500 16031B0100 "
+             "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block);
+  Data eager(wire);
+  d.wireDecodeLazy(wire);
+  BOOST_CHECK_EQUAL(d.getName(), "/D");
+  BOOST_CHECK_EQUAL(d.getContent().value_size(), 0);
+
+  // const getters of deferred fields do not decode them
+  BOOST_CHECK(d.hasLazyFields());
+  BOOST_CHECK_THROW(d.getMetaInfo(), Data::Error);
+  BOOST_CHECK_THROW(d.getSignature(), Data::Error);
+  BOOST_CHECK_THROW(d.getFreshnessPeriod(), Data::Error);
+  BOOST_CHECK(d.hasLazyFields());
+
+  d.decodeLazyFields();
+  BOOST_CHECK(!d.hasLazyFields());
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), 4000_ms);
+  BOOST_CHECK_EQUAL(d.getContentType(), 1);
+  BOOST_CHECK_EQUAL(d.getFinalBlock().value(), name::Component("fb"));
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), tlv::DigestSha256);
+  BOOST_CHECK_EQUAL(d.getSignature().getValue().value_size(), 32);
+  BOOST_CHECK_EQUAL(d, eager);
+
+  // deprecated getter reads the deferred MetaInfo as well
+  d.wireDecodeLazy(wire);
+  BOOST_CHECK_THROW(d.getFinalBlockId(), Data::Error);
+  d.decodeLazyFields();
+  BOOST_CHECK_EQUAL(d.getFinalBlockId(), name::Component("fb"));
+
+  // encode without modification: retain original wire encoding
+  d.wireDecodeLazy(wire);
+  BOOST_CHECK_EQUAL(d.wireEncode().value_size(), 61);
+  BOOST_CHECK_EQUAL(d.getFullName(), eager.getFullName());
+  BOOST_CHECK(d.hasLazyFields());
+
+  // modify then re-encode: lazy fields are decoded before wire encoding is discarded
+  d.wireDecodeLazy(wire);
+  d.setName("/E");
+  eager.setName("/E");
+  BOOST_CHECK_EQUAL(d.wireEncode(), eager.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(LazyMalformedMetaInfo)
+{
+  Block wire("0635 0703080144 1405 1803FFFFFF 1500 16031B0100 "
+             "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block);
+  BOOST_CHECK_THROW(d.wireDecode(wire), tlv::Error);
+
+  BOOST_CHECK_NO_THROW(d.wireDecodeLazy(wire));
+  BOOST_CHECK_EQUAL(d.getName(), "/D");
+  BOOST_CHECK_THROW(d.decodeLazyFields(), tlv::Error);
+  BOOST_CHECK_THROW(d.setName("/E"), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(LazyOutOfOrder)
+{
+  // element order is checked immediately
+  BOOST_CHECK_THROW(d.wireDecodeLazy(
+    "0630 0703080145 1500 1400 16031B0100 "
+    "1720612A79399E60304A9F701C1ECAC7956BF2F1B046E6C6F0D6C29B3FE3A29BAD76"_block),
+    tlv::Error);
+  BOOST_CHECK_THROW(d.wireDecodeLazy("0605 0703080144"_block), tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Decode03
 
 BOOST_FIXTURE_TEST_CASE(FullName, IdentityManagementFixture)
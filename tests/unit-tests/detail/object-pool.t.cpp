@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "detail/object-pool.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+class Counted
+{
+public:
+  explicit
+  Counted(int value)
+    : value(value)
+  {
+    ++nInstances;
+  }
+
+  ~Counted()
+  {
+    --nInstances;
+  }
+
+public:
+  int value;
+  static int nInstances;
+};
+
+int Counted::nInstances = 0;
+
+class Throwing
+{
+public:
+  explicit
+  Throwing(bool shouldThrow)
+  {
+    if (shouldThrow) {
+      BOOST_THROW_EXCEPTION(std::runtime_error("Throwing"));
+    }
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(Detail)
+BOOST_AUTO_TEST_SUITE(TestObjectPool)
+
+BOOST_AUTO_TEST_CASE(SlotReuse)
+{
+  ObjectPool<Counted> pool(2);
+  BOOST_CHECK_EQUAL(pool.capacity(), 0);
+
+  Counted* a = pool.construct(1);
+  Counted* b = pool.construct(2);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.capacity(), 2);
+
+  pool.destroy(a);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  Counted* c = pool.construct(3);
+  BOOST_CHECK_EQUAL(c, a);
+  BOOST_CHECK_EQUAL(c->value, 3);
+  BOOST_CHECK_EQUAL(pool.capacity(), 2);
+
+  // all slots are in use, so a new slab is allocated
+  Counted* d = pool.construct(4);
+  BOOST_CHECK_EQUAL(pool.size(), 3);
+  BOOST_CHECK_EQUAL(pool.capacity(), 4);
+  BOOST_CHECK_NE(d, b);
+  BOOST_CHECK_NE(d, c);
+
+  pool.destroy(b);
+  pool.destroy(c);
+  pool.destroy(d);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  BOOST_CHECK_EQUAL(Counted::nInstances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyWithLiveObjects)
+{
+  ObjectPool<Counted> pool(4);
+  std::vector<Counted*> objs;
+  for (int i = 0; i < 10; ++i) {
+    objs.push_back(pool.construct(i));
+  }
+  BOOST_CHECK_EQUAL(Counted::nInstances, 10);
+
+  // destroying some objects runs their destructors and leaves the others intact
+  for (int i = 0; i < 10; i += 2) {
+    pool.destroy(objs[i]);
+  }
+  BOOST_CHECK_EQUAL(Counted::nInstances, 5);
+  BOOST_CHECK_EQUAL(pool.size(), 5);
+  for (int i = 1; i < 10; i += 2) {
+    BOOST_CHECK_EQUAL(objs[i]->value, i);
+  }
+
+  // freed slots are reused before any new slab is allocated
+  for (int i = 0; i < 10; i += 2) {
+    objs[i] = pool.construct(i + 100);
+  }
+  BOOST_CHECK_EQUAL(pool.capacity(), 12);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(objs[i]->value, i % 2 == 0 ? i + 100 : i);
+  }
+
+  for (Counted* obj : objs) {
+    pool.destroy(obj);
+  }
+  BOOST_CHECK_EQUAL(Counted::nInstances, 0);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConstructorThrows)
+{
+  ObjectPool<Throwing> pool(1);
+  Throwing* a = pool.construct(false);
+  pool.destroy(a);
+
+  BOOST_CHECK_THROW(pool.construct(true), std::runtime_error);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  // the slot of the failed construction is returned to the pool
+  Throwing* b = pool.construct(false);
+  BOOST_CHECK_EQUAL(b, a);
+  BOOST_CHECK_EQUAL(pool.capacity(), 1);
+  pool.destroy(b);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestObjectPool
+BOOST_AUTO_TEST_SUITE_END() // Detail
+
+} // namespace tests
+} // namespace ndn
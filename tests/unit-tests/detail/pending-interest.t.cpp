@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "detail/pending-interest.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+class PendingInterestFixture
+{
+protected:
+  PendingInterestPtr
+  makeRecord(const Name& name)
+  {
+    return PendingInterest::create(pool, makeInterest(name));
+  }
+
+protected:
+  PendingInterestPool pool{4};
+};
+
+BOOST_AUTO_TEST_SUITE(Detail)
+BOOST_FIXTURE_TEST_SUITE(TestPendingInterest, PendingInterestFixture)
+
+BOOST_AUTO_TEST_CASE(Release)
+{
+  PendingInterestPtr record = makeRecord("/A");
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  PendingInterestPtr copy = record;
+  record.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK_EQUAL(copy->getInterest()->getName(), "/A");
+
+  // releasing the last reference returns the record to the pool
+  PendingInterest* slot = copy.get();
+  copy.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  record = makeRecord("/B");
+  BOOST_CHECK_EQUAL(record.get(), slot);
+  BOOST_CHECK_EQUAL(pool.capacity(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Table)
+{
+  int nOnEmpty = 0;
+  {
+    PendingInterestTable table;
+    table.onEmpty.connect([&] { ++nOnEmpty; });
+    BOOST_CHECK(table.empty());
+
+    PendingInterestPtr kept = makeRecord("/A/1");
+    table.insert(kept);
+    table.insert(makeRecord("/A/2"));
+    table.insert(makeRecord("/B/1"));
+    table.insert(makeRecord("/B/2"));
+    BOOST_CHECK_EQUAL(table.size(), 4);
+    BOOST_CHECK_EQUAL(pool.size(), 4);
+
+    std::vector<Name> names;
+    for (const PendingInterest& record : table) {
+      names.push_back(record.getInterest()->getName());
+    }
+    std::vector<Name> expectedNames{"/A/1", "/A/2", "/B/1", "/B/2"};
+    BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(),
+                                  expectedNames.begin(), expectedNames.end());
+
+    // removal releases the table's reference; a record referenced elsewhere stays alive
+    table.remove_if([] (const PendingInterest& record) {
+      return Name("/A").isPrefixOf(record.getInterest()->getName());
+    });
+    BOOST_CHECK_EQUAL(table.size(), 2);
+    BOOST_CHECK_EQUAL(pool.size(), 3);
+    BOOST_CHECK_EQUAL(kept->getInterest()->getName(), "/A/1");
+    BOOST_CHECK_EQUAL(nOnEmpty, 0);
+
+    auto next = table.erase(table.begin());
+    BOOST_CHECK_EQUAL(next->getInterest()->getName(), "/B/2");
+    BOOST_CHECK_EQUAL(table.size(), 1);
+    BOOST_CHECK_EQUAL(pool.size(), 2);
+    BOOST_CHECK_EQUAL(nOnEmpty, 0);
+
+    table.remove_if([] (const PendingInterest&) { return true; });
+    BOOST_CHECK(table.empty());
+    BOOST_CHECK_EQUAL(nOnEmpty, 1);
+
+    table.insert(makeRecord("/C"));
+    table.insert(makeRecord("/D"));
+    table.clear();
+    BOOST_CHECK(table.empty());
+    BOOST_CHECK_EQUAL(pool.size(), 1);
+    BOOST_CHECK_EQUAL(nOnEmpty, 2);
+
+    // records still in the table are released when the table is destroyed
+    table.insert(makeRecord("/E"));
+    BOOST_CHECK_EQUAL(pool.size(), 2);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  BOOST_CHECK_EQUAL(nOnEmpty, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPendingInterest
+BOOST_AUTO_TEST_SUITE_END() // Detail
+
+} // namespace tests
+} // namespace ndn
@@ -146,6 +146,19 @@ BOOST_AUTO_TEST_CASE(Write)
                                 actual, actual + sizeof(BUFFER));
 }
 
+BOOST_AUTO_TEST_CASE(WriteToBuffer)
+{
+  uint8_t actual[sizeof(BUFFER)];
+  size_t length = writeVarNumber(actual, 1);
+  length += writeVarNumber(actual + length, 252);
+  length += writeVarNumber(actual + length, 253);
+  length += writeVarNumber(actual + length, 65536);
+  length += writeVarNumber(actual + length, 4294967296);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(BUFFER, BUFFER + sizeof(BUFFER),
+                                actual, actual + length);
+}
+
 BOOST_AUTO_TEST_CASE(ReadFromBuffer)
 {
   const uint8_t* begin;
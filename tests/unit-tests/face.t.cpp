@@ -21,6 +21,8 @@
 
 #include "face.hpp"
 #include "lp/tags.hpp"
+#include "mgmt/nfd/control-parameters.hpp"
+#include "mgmt/nfd/control-response.hpp"
 #include "transport/tcp-transport.hpp"
 #include "transport/unix-transport.hpp"
 #include "util/dummy-client-face.hpp"
@@ -156,6 +158,34 @@ BOOST_AUTO_TEST_CASE(ExpressInterestTimeout)
   BOOST_CHECK_EQUAL(face.sentNacks.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ExpressInterestTimeoutOrder)
+{
+  std::vector<Name> timedOut;
+  auto onTimeout = [&timedOut] (const Interest& i) { timedOut.push_back(i.getName()); };
+  face.expressInterest(*makeInterest("/A", false, 300_ms), nullptr, nullptr, onTimeout);
+  face.expressInterest(*makeInterest("/B", false, 100_ms), nullptr, nullptr, onTimeout);
+  face.expressInterest(*makeInterest("/C", false, 200_ms), nullptr, nullptr, onTimeout);
+  face.expressInterest(*makeInterest("/D", false, 100_ms), nullptr, nullptr, onTimeout);
+  face.expressInterest(*makeInterest("/E", false, 150_ms), nullptr, nullptr, onTimeout);
+  advanceClocks(10_ms);
+
+  face.receive(*makeData("/E"));
+  advanceClocks(10_ms);
+  face.expressInterest(*makeInterest("/F", false, 50_ms), nullptr, nullptr, onTimeout);
+  advanceClocks(1_ms);
+
+  advanceClocks(49_ms);
+  BOOST_CHECK_EQUAL(timedOut.size(), 0);
+
+  advanceClocks(1_ms);
+  std::vector<Name> expected{"/F"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timedOut.begin(), timedOut.end(), expected.begin(), expected.end());
+
+  advanceClocks(10_ms, 30);
+  expected = {"/F", "/B", "/D", "/C", "/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timedOut.begin(), timedOut.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(ExpressInterestEmptyTimeoutCallback)
 {
   face.expressInterest(*makeInterest("/Hello/World", false, 50_ms),
@@ -239,6 +269,155 @@ BOOST_AUTO_TEST_CASE(ExpressInterestEmptyNackCallback)
   } while (false));
 }
 
+BOOST_AUTO_TEST_CASE(AggregateInterestsData)
+{
+  face.setInterestAggregation(true);
+
+  size_t nData = 0;
+  auto onData = [&] (const Interest& i, const Data& d) {
+    BOOST_CHECK_EQUAL(i.getName(), d.getName());
+    ++nData;
+  };
+  face.expressInterest(*makeInterest("/A", false, 50_ms, 1), onData, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/A", false, 50_ms, 2), onData, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/A", false, 50_ms, 3), onData, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/A", true, 50_ms, 4), onData, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/B", false, 50_ms, 5), onData, nullptr, nullptr);
+  advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face.sentInterests.at(0).getNonce(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.at(1).getNonce(), 4);
+  BOOST_CHECK_EQUAL(face.sentInterests.at(2).getNonce(), 5);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 5);
+  BOOST_CHECK_EQUAL(face.getMetrics().nSuppressedInterests, 2);
+
+  face.receive(*makeData("/A"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nData, 4);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  // aggregation applies only while an equivalent Interest is pending
+  face.expressInterest(*makeInterest("/A", false, 50_ms, 6), onData, nullptr, nullptr);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsNackTimeout)
+{
+  face.setInterestAggregation(true);
+
+  size_t nNacks = 0;
+  auto onNack = [&] (const Interest&, const lp::Nack& n) {
+    BOOST_CHECK_EQUAL(n.getReason(), lp::NackReason::NO_ROUTE);
+    ++nNacks;
+  };
+  std::vector<uint32_t> timedOut;
+  auto onTimeout = [&] (const Interest& i) { timedOut.push_back(i.getNonce()); };
+
+  face.expressInterest(*makeInterest("/A", false, 1_s, 1), nullptr, onNack, onTimeout);
+  face.expressInterest(*makeInterest("/B", false, 1_s, 2), nullptr, onNack, onTimeout);
+  advanceClocks(10_ms);
+  face.expressInterest(*makeInterest("/A", false, 100_ms, 3), nullptr, onNack, onTimeout);
+  face.expressInterest(*makeInterest("/B", false, 100_ms, 4), nullptr, onNack, onTimeout);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+
+  face.receive(makeNack(face.sentInterests.at(0), lp::NackReason::NO_ROUTE));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nNacks, 2);
+
+  // the aggregated Interest times out according to its own InterestLifetime
+  advanceClocks(10_ms, 10);
+  std::vector<uint32_t> expected{4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timedOut.begin(), timedOut.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  advanceClocks(100_ms, 10);
+  expected = {4, 2};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timedOut.begin(), timedOut.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsShorterLeader)
+{
+  face.setInterestAggregation(true);
+
+  std::vector<uint32_t> timedOut;
+  auto onTimeout = [&] (const Interest& i) { timedOut.push_back(i.getNonce()); };
+
+  // an Interest is sent if the pending Interest would expire before it
+  face.expressInterest(*makeInterest("/A", false, 100_ms, 1), nullptr, nullptr, onTimeout);
+  advanceClocks(10_ms);
+  face.expressInterest(*makeInterest("/A", false, 4_s, 2), nullptr, nullptr, onTimeout);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentInterests.at(1).getNonce(), 2);
+  BOOST_CHECK_EQUAL(face.getMetrics().nSuppressedInterests, 0);
+
+  // later Interests are aggregated onto the longer-lived one
+  face.expressInterest(*makeInterest("/A", false, 1_s, 3), nullptr, nullptr, onTimeout);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.getMetrics().nSuppressedInterests, 1);
+
+  advanceClocks(100_ms, 10);
+  std::vector<uint32_t> expected{1, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(timedOut.begin(), timedOut.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsRemoveLeader)
+{
+  face.setInterestAggregation(true);
+
+  size_t nData = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+  const PendingInterestId* leaderId =
+    face.expressInterest(*makeInterest("/A", false, 1_s, 1), onData, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/A", false, 1_s, 2), onData, nullptr, nullptr);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+
+  // an Interest that was aggregated and never sent cannot be aggregated onto
+  face.removePendingInterest(leaderId);
+  advanceClocks(10_ms);
+  face.expressInterest(*makeInterest("/A", false, 1_s, 3), onData, nullptr, nullptr);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentInterests.at(1).getNonce(), 3);
+
+  face.receive(*makeData("/A"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nData, 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregateInterestsMany)
+{
+  face.setInterestAggregation(true);
+
+  // enough distinct names to grow the aggregation index several times
+  size_t nData = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      face.expressInterest(*makeInterest(Name("/A").appendNumber(i), false, 1_s), onData,
+                           nullptr, nullptr);
+    }
+  }
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 200);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 400);
+
+  for (int i = 0; i < 200; ++i) {
+    face.receive(*makeData(Name("/A").appendNumber(i)));
+  }
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nData, 400);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(RemovePendingInterest)
 {
   const PendingInterestId* interestId =
@@ -636,6 +815,104 @@ BOOST_FIXTURE_TEST_CASE(RegisterUnregisterPrefixFail, FacesNoRegistrationReplyFi
   BOOST_CHECK_EQUAL(nRegFailures, 1);
 }
 
+static void
+replyToCommand(DummyClientFace& face, const Interest& interest, uint32_t code)
+{
+  nfd::ControlParameters params(interest.getName().get(-5).blockFromValue());
+  params.setFaceId(1).setOrigin(nfd::ROUTE_ORIGIN_APP).setCost(0);
+
+  auto data = makeData(interest.getName());
+  data->setContent(nfd::ControlResponse(code, "").setBody(params.wireEncode()).wireEncode());
+  face.receive(*data);
+}
+
+BOOST_AUTO_TEST_CASE(RegisterPrefixes)
+{
+  std::vector<Name> prefixes;
+  for (int i = 0; i < 10; ++i) {
+    prefixes.push_back(Name("/Hello").appendNumber(i));
+  }
+
+  size_t nCompletions = 0;
+  RegisterPrefixesResult result;
+  face.registerPrefixes(prefixes, [&] (const RegisterPrefixesResult& r) {
+    result = r;
+    ++nCompletions;
+  });
+
+  advanceClocks(25_ms, 4);
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  BOOST_CHECK_EQUAL(result.failed.size(), 0);
+  BOOST_REQUIRE_EQUAL(result.registered.size(), 10);
+
+  size_t nUnregSuccesses = 0;
+  face.unregisterPrefix(result.registered.front().second,
+                        bind([&nUnregSuccesses] { ++nUnregSuccesses; }),
+                        bind([] { BOOST_FAIL("Unexpected unregisterPrefix failure"); }));
+  advanceClocks(25_ms, 4);
+  BOOST_CHECK_EQUAL(nUnregSuccesses, 1);
+
+  RegisterPrefixesOptions badOptions;
+  badOptions.window = 0;
+  BOOST_CHECK_THROW(face.registerPrefixes(prefixes, nullptr, badOptions), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(RegisterPrefixesWindow, FacesNoRegistrationReplyFixture)
+{
+  std::list<Name> prefixes{"/A", "/B", "/C", "/D", "/E"};
+  RegisterPrefixesOptions options;
+  options.window = 2;
+
+  size_t nCompletions = 0;
+  RegisterPrefixesResult result;
+  face.registerPrefixes(prefixes,
+                        [&] (const RegisterPrefixesResult& r) {
+                          result = r;
+                          ++nCompletions;
+                        },
+                        options);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+
+  // each completed command lets one more command be sent
+  for (size_t i = 0; i < 5; ++i) {
+    replyToCommand(face, face.sentInterests.at(i), i == 3 ? 403 : 200);
+    advanceClocks(1_ms);
+    BOOST_CHECK_EQUAL(face.sentInterests.size(), std::min<size_t>(i + 3, 5));
+  }
+
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  BOOST_CHECK_EQUAL(result.registered.size(), 4);
+  BOOST_REQUIRE_EQUAL(result.failed.size(), 1);
+  BOOST_CHECK_EQUAL(result.failed.front().first, "/D");
+}
+
+BOOST_FIXTURE_TEST_CASE(RegisterPrefixesRetry, FacesNoRegistrationReplyFixture)
+{
+  RegisterPrefixesOptions options;
+  options.maxRetries = 1;
+
+  size_t nCompletions = 0;
+  RegisterPrefixesResult result;
+  face.registerPrefixes(std::vector<Name>{"/A", "/B"},
+                        [&] (const RegisterPrefixesResult& r) { result = r; ++nCompletions; },
+                        options);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+
+  // both commands time out, and are retransmitted once
+  advanceClocks(1_s, 11);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+
+  replyToCommand(face, face.sentInterests.at(2), 200);
+  advanceClocks(1_s, 11);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  BOOST_CHECK_EQUAL(result.registered.size(), 1);
+  BOOST_CHECK_EQUAL(result.failed.size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(SimilarFilters)
 {
   size_t nInInterests1 = 0;
@@ -779,6 +1056,47 @@ BOOST_AUTO_TEST_CASE(DestroyWithoutProcessEvents) // Bug 3248
 
 BOOST_AUTO_TEST_SUITE_END() // IoRoutines
 
+BOOST_AUTO_TEST_CASE(Metrics)
+{
+  face.expressInterest(*makeInterest("/A", false, 1_s), nullptr, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/B", false, 1_s), nullptr, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/C", false, 1_s), nullptr, nullptr, nullptr);
+  face.setInterestFilter(InterestFilter("/E"), bind([] {}));
+  advanceClocks(1_ms);
+  advanceClocks(50_ms);
+
+  face.receive(*makeData("/A"));
+  face.receive(makeNack(face.sentInterests.at(1), lp::NackReason::NO_ROUTE));
+  face.receive(*makeInterest("/D"));
+  face.receive(*makeInterest("/E"));
+  advanceClocks(10_ms);
+
+  util::FaceMetrics metrics = face.getMetrics();
+  BOOST_CHECK_EQUAL(metrics.nOutInterests, 3);
+  BOOST_CHECK_EQUAL(metrics.nInData, 1);
+  BOOST_CHECK_EQUAL(metrics.nInNacks, 1);
+  BOOST_CHECK_EQUAL(metrics.nInInterests, 2);
+  BOOST_CHECK_EQUAL(metrics.nSatisfiedInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nNackedInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nTimedOutInterests, 0);
+  BOOST_CHECK_EQUAL(metrics.nPitEntries, 3);
+  BOOST_CHECK_EQUAL(metrics.maxPitEntries, 3);
+  BOOST_CHECK_EQUAL(metrics.satisfyLatency.getQuantile(0.5),
+                    util::LatencyHistogram::getBucketLowerBound(
+                      util::LatencyHistogram::getBucketIndex(50_ms)));
+  BOOST_CHECK_EQUAL(metrics.sendQueueLength, 0);
+
+  face.put(*makeData("/D"));
+  face.put(makeNack(*makeInterest("/E"), lp::NackReason::NO_ROUTE));
+  advanceClocks(1_s, 4);
+
+  metrics = face.getMetrics();
+  BOOST_CHECK_EQUAL(metrics.nOutData, 1);
+  BOOST_CHECK_EQUAL(metrics.nOutNacks, 1);
+  BOOST_CHECK_EQUAL(metrics.nTimedOutInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nPitEntries, 0);
+}
+
 BOOST_AUTO_TEST_SUITE(Transport)
 
 using ndn::Transport;
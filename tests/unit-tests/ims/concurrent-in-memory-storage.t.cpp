@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ims/concurrent-in-memory-storage.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestConcurrentInMemoryStorage)
+
+/** \return a child of \p prefix whose shard differs from the shard of \p name
+ */
+static Name
+makeNameInOtherShard(const ConcurrentInMemoryStorage& ims, const Name& name, const Name& prefix)
+{
+  for (int i = 0; ; ++i) {
+    Name other = Name(prefix).append("other-" + to_string(i));
+    if (ims.getShardIndex(other) != ims.getShardIndex(name)) {
+      return other;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  ConcurrentInMemoryStorage ims;
+  BOOST_CHECK_EQUAL(ims.getNShards(), 16);
+
+  shared_ptr<Data> data = makeData("/A/B/C");
+  ims.insert(*data);
+  ims.insert(*data);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+
+  BOOST_CHECK_EQUAL(ims.find(*makeInterest("/A/B/C")), data);
+  BOOST_CHECK_EQUAL(ims.find(*makeInterest("/A/B", true)), data);
+  BOOST_CHECK_EQUAL(ims.find(*makeInterest(data->getFullName())), data);
+  BOOST_CHECK(ims.find(*makeInterest("/A/B")) == nullptr);
+  BOOST_CHECK_EQUAL(ims.find(Name("/A/B")), data);
+  BOOST_CHECK(ims.find(Name("/A/D")) == nullptr);
+
+  ims.erase("/A/B");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK(ims.find(Name("/A/B/C")) == nullptr);
+
+  BOOST_CHECK_THROW(ConcurrentInMemoryStorage(10, 0), ConcurrentInMemoryStorage::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ShortName)
+{
+  ConcurrentInMemoryStorage ims(100, 16, 2);
+  Name left("/A/a");
+  Name right = makeNameInOtherShard(ims, left, "/A");
+
+  shared_ptr<Data> leftData = makeData(Name(left).append("1"));
+  shared_ptr<Data> rightData = makeData(Name(right).append("1"));
+  ims.insert(*leftData);
+  ims.insert(*rightData);
+  BOOST_CHECK_EQUAL(ims.getShardSize(ims.getShardIndex(left)), 1);
+  BOOST_CHECK_EQUAL(ims.getShardSize(ims.getShardIndex(right)), 1);
+
+  // an Interest shorter than the shard key is looked up in every shard
+  shared_ptr<Interest> interest = makeInterest("/A", true);
+  BOOST_CHECK_EQUAL(ims.find(*interest), leftData);
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(ims.find(*interest), rightData);
+  BOOST_CHECK_EQUAL(ims.find(Name("/A")), leftData);
+
+  // so is a Data packet whose full name is shorter than the shard key
+  shared_ptr<Data> shortData = makeData("/B");
+  ims.insert(*shortData);
+  BOOST_CHECK_EQUAL(ims.find(*makeInterest("/B")), shortData);
+  BOOST_CHECK_EQUAL(ims.find(*makeInterest(shortData->getFullName())), shortData);
+
+  ims.erase("/A");
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  ims.erase(shortData->getFullName(), false);
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RightmostChild)
+{
+  ConcurrentInMemoryStorage ims(100, 16, 3);
+  Name left("/p/b/0");
+  Name right = makeNameInOtherShard(ims, left, "/p/b");
+  BOOST_REQUIRE_LT(left, right);
+
+  shared_ptr<Data> leftData = makeData(left);
+  ims.insert(*leftData);
+  ims.insert(*makeData(right));
+  ims.insert(*makeData("/p/a/1"));
+
+  // the leftmost packet under the rightmost child, even if another shard has a greater name
+  shared_ptr<Interest> interest = makeInterest("/p", true);
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(ims.find(*interest), leftData);
+}
+
+BOOST_AUTO_TEST_CASE(EvictFromLargestShard)
+{
+  ConcurrentInMemoryStorage ims(4, 16, 1);
+  Name a("/A");
+  Name b = makeNameInOtherShard(ims, a, "/");
+
+  ims.insert(*makeData(Name(a).appendNumber(1)));
+  ims.insert(*makeData(Name(a).appendNumber(2)));
+  ims.insert(*makeData(Name(a).appendNumber(3)));
+  ims.insert(*makeData(Name(b).appendNumber(1)));
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+
+  // the shard of /A evicts its least recently used packet, although /B was inserted last
+  BOOST_CHECK(ims.find(Name(a).appendNumber(1)) != nullptr);
+  ims.insert(*makeData(Name(b).appendNumber(2)));
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+  BOOST_CHECK_EQUAL(ims.getShardSize(ims.getShardIndex(a)), 2);
+  BOOST_CHECK_EQUAL(ims.getShardSize(ims.getShardIndex(b)), 2);
+  BOOST_CHECK(ims.find(Name(a).appendNumber(1)) != nullptr);
+  BOOST_CHECK(ims.find(Name(a).appendNumber(2)) == nullptr);
+  BOOST_CHECK(ims.find(Name(a).appendNumber(3)) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MultiThreaded)
+{
+  const size_t nThreads = 4;
+  const size_t nPacketsPerThread = 1000;
+  const size_t limit = 2000;
+  ConcurrentInMemoryStorage ims(limit, 8, 2);
+
+  std::vector<std::vector<shared_ptr<Data>>> packets(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    for (size_t j = 0; j < nPacketsPerThread; ++j) {
+      packets[i].push_back(makeData(Name("/producer").appendNumber(i).appendNumber(j)));
+    }
+  }
+
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < nThreads; ++i) {
+    producers.emplace_back([&ims, &packets, i] {
+      for (const auto& data : packets[i]) {
+        ims.insert(*data);
+      }
+    });
+  }
+
+  // find packets while they are being inserted and evicted
+  size_t nFound = 0;
+  for (size_t j = 0; j < nPacketsPerThread; ++j) {
+    for (size_t i = 0; i < nThreads; ++i) {
+      nFound += ims.find(packets[i][j]->getName()) != nullptr;
+    }
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  BOOST_TEST_MESSAGE(nFound << " packets found during insertion");
+
+  BOOST_CHECK_EQUAL(ims.size(), limit);
+  size_t nStored = 0;
+  for (size_t i = 0; i < ims.getNShards(); ++i) {
+    nStored += ims.getShardSize(i);
+  }
+  BOOST_CHECK_EQUAL(nStored, limit);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestConcurrentInMemoryStorage
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ims/disk-storage.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+namespace fs = boost::filesystem;
+
+class DiskStorageFixture
+{
+protected:
+  DiskStorageFixture()
+    : path(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "TestDiskStorage")
+  {
+    boost::filesystem::remove_all(path);
+  }
+
+  ~DiskStorageFixture()
+  {
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(path, ec); // ignore error
+  }
+
+  shared_ptr<Data>
+  makeData(const Name& name, size_t payloadSize = 100) const
+  {
+    auto data = ndn::tests::makeData(name);
+    std::vector<uint8_t> payload(payloadSize, 0xBB);
+    data->setContent(payload.data(), payload.size());
+    return signData(data);
+  }
+
+protected:
+  boost::filesystem::path path;
+};
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_FIXTURE_TEST_SUITE(TestDiskStorage, DiskStorageFixture)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  DiskStorage storage(path.string());
+  BOOST_CHECK_EQUAL(storage.getNSegments(), 0);
+  BOOST_CHECK(storage.find(Name("/A")) == nullptr);
+
+  shared_ptr<Data> a1 = makeData("/A/1");
+  shared_ptr<Data> a2 = makeData("/A/2");
+  shared_ptr<Data> b = makeData("/B");
+  storage.insert(*a2);
+  storage.insert(*b);
+  storage.insert(*a1);
+  storage.insert(*a1);
+  BOOST_CHECK_EQUAL(storage.getNSegments(), 1);
+
+  auto found = storage.find(*makeInterest("/A/1"));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->wireEncode(), a1->wireEncode());
+  BOOST_CHECK(storage.find(*makeInterest("/A")) == nullptr);
+
+  shared_ptr<Interest> interest = makeInterest("/A", true);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), "/A/1");
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), "/A/2");
+  BOOST_CHECK_EQUAL(storage.find(*makeInterest(b->getFullName()))->getName(), "/B");
+  BOOST_CHECK(storage.find(*makeInterest(a1->getFullName().getPrefix(-1).append(
+                                         b->getFullName().get(-1)))) == nullptr);
+
+  BOOST_CHECK_EQUAL(storage.find(Name("/A"))->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(storage.find(a2->getFullName())->getName(), "/A/2");
+  BOOST_CHECK(storage.find(Name("/C")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Segments)
+{
+  DiskStorage storage(path.string(), 1000);
+  for (int i = 0; i < 20; ++i) {
+    storage.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  // a packet larger than the segment size gets a segment of its own
+  storage.insert(*makeData("/B", 2000));
+  BOOST_CHECK_GT(storage.getNSegments(), 3);
+
+  for (int i = 0; i < 20; ++i) {
+    auto found = storage.find(Name("/A").appendNumber(i));
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK_EQUAL(found->getName(), Name("/A").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(storage.find(Name("/B"))->getContent().value_size(), 2000);
+
+  shared_ptr<Interest> interest = makeInterest("/A", true);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), Name("/A").appendNumber(0));
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), Name("/A").appendNumber(19));
+  interest = makeInterest("/", true);
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), "/B");
+}
+
+BOOST_AUTO_TEST_CASE(RightmostChild)
+{
+  DiskStorage storage(path.string(), 1000);
+  shared_ptr<Data> b0 = makeData("/p/b/0", 800);
+  storage.insert(*makeData("/p/a/9", 800));
+  storage.insert(*makeData("/p/b/1", 800));
+  storage.insert(*b0);
+  storage.insert(*makeData("/p/b/2", 800));
+  BOOST_CHECK_EQUAL(storage.getNSegments(), 4);
+
+  // the leftmost packet under the rightmost child, even if another segment has a greater name
+  shared_ptr<Interest> interest = makeInterest("/p", true);
+  interest->setChildSelector(1);
+  BOOST_CHECK_EQUAL(storage.find(*interest)->wireEncode(), b0->wireEncode());
+
+  // a child whose packets are all erased is skipped
+  storage.erase("/p/b");
+  BOOST_CHECK_EQUAL(storage.find(*interest)->getName(), "/p/a/9");
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  DiskStorage storage(path.string(), 1000);
+  shared_ptr<Data> b = makeData("/B");
+  for (int i = 0; i < 10; ++i) {
+    storage.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  storage.insert(*b);
+
+  storage.erase(b->getFullName(), false);
+  BOOST_CHECK(storage.find(Name("/B")) == nullptr);
+  storage.erase("/A");
+  BOOST_CHECK(storage.find(Name("/A")) == nullptr);
+  BOOST_CHECK(storage.find(*makeInterest("/", true)) == nullptr);
+
+  // packets inserted after erasure are found
+  storage.insert(*makeData(Name("/A").appendNumber(3)));
+  storage.insert(*b);
+  BOOST_REQUIRE(storage.find(Name("/A")) != nullptr);
+  BOOST_CHECK_EQUAL(storage.find(Name("/A"))->getName(), Name("/A").appendNumber(3));
+  BOOST_REQUIRE(storage.find(Name("/B")) != nullptr);
+  BOOST_CHECK_EQUAL(storage.find(Name("/B"))->getName(), "/B");
+}
+
+BOOST_AUTO_TEST_CASE(Compact)
+{
+  auto getLogsSize = [this] {
+    uintmax_t size = 0;
+    for (fs::directory_iterator it(path); it != fs::directory_iterator(); ++it) {
+      if (it->path().extension() == ".log") {
+        size += fs::file_size(it->path());
+      }
+    }
+    return size;
+  };
+
+  {
+    DiskStorage storage(path.string(), 1000);
+    for (int i = 0; i < 20; ++i) {
+      storage.insert(*makeData(Name("/A").appendNumber(i)));
+    }
+    storage.insert(*makeData("/B/1"));
+    storage.insert(*makeData("/B/2"));
+    size_t nSegments = storage.getNSegments();
+    uintmax_t logsSize = getLogsSize();
+
+    storage.erase(Name("/A").appendNumber(3));
+    storage.erase("/A");
+    storage.insert(*makeData(Name("/A").appendNumber(5)));
+    storage.erase("/B/1");
+    BOOST_CHECK_GT(fs::file_size(path / "erased"), 0);
+
+    storage.compact();
+    BOOST_CHECK_LT(storage.getNSegments(), nSegments);
+    BOOST_CHECK_LT(getLogsSize(), logsSize / 2);
+    // the erase records also affect the active segment, so they are kept
+    BOOST_CHECK_EQUAL(storage.m_erasedPrefixes.size(), 3);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(3)) == nullptr);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(5)) != nullptr);
+    BOOST_CHECK(storage.find(Name("/B/1")) == nullptr);
+    BOOST_CHECK(storage.find(Name("/B/2")) != nullptr);
+
+    storage.insert(*makeData("/C", 1000));
+    storage.compact();
+    BOOST_CHECK(storage.m_erasedPrefixes.empty() && storage.m_erasedNames.empty());
+    BOOST_CHECK_EQUAL(fs::file_size(path / "erased"), 0);
+    storage.flush();
+  }
+
+  // compacted segments are found after reopening, and packets can be erased again
+  DiskStorage storage(path.string(), 1000);
+  BOOST_CHECK(storage.find(Name("/A").appendNumber(0)) == nullptr);
+  BOOST_CHECK_EQUAL(storage.find(Name("/A"))->getName(), Name("/A").appendNumber(5));
+  BOOST_CHECK(storage.find(Name("/B/1")) == nullptr);
+  BOOST_CHECK(storage.find(Name("/B/2")) != nullptr);
+  storage.erase("/B");
+  BOOST_CHECK(storage.find(Name("/B")) == nullptr);
+  storage.insert(*makeData("/B/1"));
+  BOOST_CHECK(storage.find(Name("/B/1")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Reopen)
+{
+  shared_ptr<Data> b = makeData("/B");
+  size_t nSegments = 0;
+  {
+    DiskStorage storage(path.string(), 1000);
+    for (int i = 0; i < 20; ++i) {
+      storage.insert(*makeData(Name("/A").appendNumber(i)));
+    }
+    storage.insert(*b);
+    storage.erase(Name("/A").appendNumber(5));
+    storage.flush();
+    nSegments = storage.getNSegments();
+  }
+
+  {
+    DiskStorage storage(path.string(), 1000);
+    BOOST_CHECK_EQUAL(storage.getNSegments(), nSegments);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(5)) == nullptr);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(19)) != nullptr);
+    BOOST_CHECK_EQUAL(storage.find(*makeInterest("/B"))->wireEncode(), b->wireEncode());
+
+    // the active segment is reopened, instead of starting a new one
+    storage.insert(*b);
+    storage.insert(*makeData("/C"));
+    BOOST_CHECK_EQUAL(storage.getNSegments(), nSegments);
+    storage.insert(*makeData(Name("/A").appendNumber(5)));
+  }
+
+  // a segment whose index file is missing is indexed again
+  boost::filesystem::remove(path / "0000000000.idx");
+  {
+    DiskStorage storage(path.string(), 1000);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(0)) != nullptr);
+    BOOST_CHECK(storage.find(Name("/A").appendNumber(5)) != nullptr);
+    BOOST_CHECK(storage.find(Name("/C")) != nullptr);
+  }
+  BOOST_CHECK(boost::filesystem::exists(path / "0000000000.idx"));
+}
+
+BOOST_AUTO_TEST_CASE(Corrupted)
+{
+  auto fillSegments = [this] {
+    boost::filesystem::remove_all(path);
+    DiskStorage storage(path.string(), 1000);
+    for (int i = 0; i < 20; ++i) {
+      storage.insert(*makeData(Name("/A").appendNumber(i)));
+    }
+  };
+  auto writeFile = [] (const boost::filesystem::path& file, const std::vector<uint8_t>& content) {
+    std::ofstream os(file.string(), std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(content.data()), content.size());
+  };
+  Name name = Name("/A").appendNumber(0);
+
+  // the index is shorter than its number of entries requires
+  fillSegments();
+  writeFile(path / "0000000000.idx", {0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0});
+  BOOST_CHECK_THROW(DiskStorage(path.string(), 1000).find(name), DiskStorage::Error);
+  writeFile(path / "0000000000.idx", {0, 0, 0});
+  BOOST_CHECK_THROW(DiskStorage(path.string(), 1000).find(name), DiskStorage::Error);
+
+  // the name of an entry is outside of the index
+  fillSegments();
+  writeFile(path / "0000000000.idx", {0, 0, 0, 0, 0, 0, 0, 1,
+                                      0, 0, 0, 0, 0, 0, 0, 0,
+                                      0, 0, 0, 0, 0, 1, 0, 0});
+  BOOST_CHECK_THROW(DiskStorage(path.string(), 1000).find(name), DiskStorage::Error);
+
+  // the log is shorter than the index says
+  fillSegments();
+  boost::filesystem::resize_file(path / "0000000000.log", 10);
+  BOOST_CHECK_THROW(DiskStorage(path.string(), 1000).find(name), DiskStorage::Error);
+  boost::filesystem::resize_file(path / "0000000000.log", 0);
+  BOOST_CHECK_THROW(DiskStorage(path.string(), 1000).find(name), DiskStorage::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDiskStorage
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ims/in-memory-storage-arc.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestInMemoryStorageArc)
+
+/** \return whether \p ims contains a packet named \p name, without counting a request
+ */
+static bool
+contains(const InMemoryStorage& ims, const Name& name)
+{
+  return std::any_of(ims.begin(), ims.end(),
+                     [&name] (const Data& data) { return data.getName() == name; });
+}
+
+BOOST_AUTO_TEST_CASE(RecencyAndFrequency)
+{
+  InMemoryStorageArc ims(3);
+  ims.insert(*makeData("/A"));
+  ims.insert(*makeData("/B"));
+  ims.insert(*makeData("/C"));
+  ims.find(Name("/A"));
+  BOOST_CHECK_EQUAL(ims.m_t1.size(), 2);
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 1);
+
+  // /B is the least recently used packet found only once
+  ims.insert(*makeData("/D"));
+  BOOST_CHECK(contains(ims, "/A"));
+  BOOST_CHECK(!contains(ims, "/B"));
+  BOOST_CHECK(contains(ims, "/C"));
+  BOOST_CHECK(contains(ims, "/D"));
+  BOOST_CHECK_EQUAL(ims.m_b1.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GhostHit)
+{
+  InMemoryStorageArc ims(3);
+  shared_ptr<Data> dataA = makeData("/A");
+  ims.insert(*dataA);
+  ims.insert(*makeData("/B"));
+  ims.find(Name("/B"));
+  ims.insert(*makeData("/C"));
+  ims.insert(*makeData("/D"));
+  BOOST_CHECK(!contains(ims, "/A"));
+  BOOST_CHECK_EQUAL(ims.m_b1.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_target, 0);
+
+  // reinserting an evicted packet grows the target size of T1, and places the packet in T2
+  ims.insert(*dataA);
+  BOOST_CHECK_EQUAL(ims.m_target, 1);
+  BOOST_CHECK(contains(ims, "/A"));
+  BOOST_CHECK(contains(ims, "/B"));
+  BOOST_CHECK(!contains(ims, "/C"));
+  BOOST_CHECK(contains(ims, "/D"));
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 2);
+  BOOST_CHECK_EQUAL(ims.m_b1.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageArc ims(100);
+  for (int i = 0; i < 50; ++i) {
+    ims.insert(*makeData(Name("/hot").appendNumber(i)));
+    BOOST_REQUIRE(ims.find(Name("/hot").appendNumber(i)) != nullptr);
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    ims.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 100);
+
+  size_t nHot = 0;
+  for (int i = 0; i < 50; ++i) {
+    nHot += contains(ims, Name("/hot").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(nHot, 50);
+  BOOST_CHECK_LE(ims.m_b1.size() + ims.m_b2.size(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorageArc
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ims/in-memory-storage-name-tree.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+class NameTreeFixture
+{
+protected:
+  InMemoryStorageEntry*
+  insert(const Name& name)
+  {
+    entries.push_back(make_unique<InMemoryStorageEntry>());
+    InMemoryStorageEntry* entry = entries.back().get();
+    entry->setData(*makeData(name));
+    tree.insert(entry);
+    return entry;
+  }
+
+  void
+  markStale(InMemoryStorageEntry* entry)
+  {
+    tree.beforeMarkStale(entry);
+    entry->markStale();
+  }
+
+  Name
+  find(const Interest& interest)
+  {
+    InMemoryStorageEntry* entry = tree.find(interest);
+    return entry == nullptr ? Name() : entry->getName();
+  }
+
+protected:
+  InMemoryStorageNameTree tree;
+  std::vector<unique_ptr<InMemoryStorageEntry>> entries;
+};
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_FIXTURE_TEST_SUITE(TestInMemoryStorageNameTree, NameTreeFixture)
+
+BOOST_AUTO_TEST_CASE(InsertErase)
+{
+  BOOST_CHECK_EQUAL(tree.getNodeCount(), 1);
+
+  auto a1 = insert("/A/1");
+  BOOST_CHECK_EQUAL(tree.getNodeCount(), 4); // root, /A, /A/1, /A/1/<digest>
+  auto a2 = insert("/A/2");
+  BOOST_CHECK_EQUAL(tree.getNodeCount(), 6);
+
+  tree.erase(a1);
+  BOOST_CHECK_EQUAL(tree.getNodeCount(), 4);
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A", true)), "/A/2");
+
+  tree.erase(a2);
+  BOOST_CHECK_EQUAL(tree.getNodeCount(), 1);
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A", true)), Name());
+}
+
+BOOST_AUTO_TEST_CASE(ChildSelector)
+{
+  insert("/A/1/x");
+  insert("/A/1/y");
+  insert("/A/2/x");
+  insert("/A/2/y");
+  insert("/B/1");
+
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A", true)), "/A/1/x");
+  BOOST_CHECK_EQUAL(find(makeInterest("/A", true)->setChildSelector(1)), "/A/2/x");
+  BOOST_CHECK_EQUAL(find(makeInterest("/A/2", true)->setChildSelector(1)), "/A/2/y");
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A/3", true)), Name());
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A/1/x", false)), "/A/1/x");
+  BOOST_CHECK_EQUAL(find(*makeInterest("/A/1", false)), Name());
+}
+
+BOOST_AUTO_TEST_CASE(SkipStale)
+{
+  std::vector<InMemoryStorageEntry*> stale;
+  for (int i = 0; i < 100; ++i) {
+    stale.push_back(insert(Name("/A").appendNumber(i)));
+  }
+  insert("/A/fresh");
+  for (auto entry : stale) {
+    markStale(entry);
+  }
+  markStale(stale.front()); // no effect
+
+  auto interest = makeInterest("/A", true);
+  interest->setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(*interest), "/A/fresh");
+  interest->setMustBeFresh(false);
+  BOOST_CHECK_EQUAL(find(*interest), Name("/A").appendNumber(0));
+
+  interest->setMustBeFresh(true).setChildSelector(1);
+  BOOST_CHECK_EQUAL(find(*interest), "/A/fresh");
+
+  // erasing a stale entry does not affect fresh counts
+  tree.erase(stale.back());
+  interest->setChildSelector(0);
+  BOOST_CHECK_EQUAL(find(*interest), "/A/fresh");
+}
+
+BOOST_AUTO_TEST_CASE(Exclude)
+{
+  insert("/A/1");
+  insert("/A/2");
+
+  auto interest = makeInterest("/A", true);
+  interest->setExclude(ndn::Exclude().excludeOne(name::Component("1")));
+  BOOST_CHECK_EQUAL(find(*interest), "/A/2");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorageNameTree
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
@@ -58,6 +58,34 @@ BOOST_AUTO_TEST_CASE(InsertAndDouble)
   BOOST_CHECK_EQUAL(ims.getCapacity(), 20);
 }
 
+BOOST_AUTO_TEST_CASE(ByteLimit)
+{
+  InMemoryStoragePersistent ims;
+  shared_ptr<Data> data1 = makeData("/A/1");
+  shared_ptr<Data> data2 = makeData("/A/2");
+  ims.setByteLimit(data1->wireEncode().size());
+
+  // packets are never evicted, so a packet that does not fit is rejected
+  BOOST_CHECK_EQUAL(ims.insert(*data1), true);
+  BOOST_CHECK_EQUAL(ims.insert(*data2), false);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), data1->wireEncode().size());
+  BOOST_CHECK(ims.find(data1->getName()) != nullptr);
+  BOOST_CHECK_EQUAL(ims.insert(*data1), true);
+}
+
+BOOST_AUTO_TEST_CASE(PrefixQuota)
+{
+  InMemoryStoragePersistent ims;
+  shared_ptr<Data> data1 = makeData("/A/1");
+  ims.setPrefixQuota("/A", data1->wireEncode().size());
+
+  BOOST_CHECK_EQUAL(ims.insert(*data1), true);
+  BOOST_CHECK_EQUAL(ims.insert(*makeData("/A/2")), false);
+  BOOST_CHECK_EQUAL(ims.insert(*makeData("/B/1")), true);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStoragePersistent
 BOOST_AUTO_TEST_SUITE_END() // Ims
 
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ims/in-memory-storage-tinylfu.hpp"
+
+#include "boost-test.hpp"
+#include "make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestInMemoryStorageTinyLfu)
+
+/** \return whether \p ims contains a packet named \p name, without counting a request
+ */
+static bool
+contains(const InMemoryStorage& ims, const Name& name)
+{
+  return std::any_of(ims.begin(), ims.end(),
+                     [&name] (const Data& data) { return data.getName() == name; });
+}
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  InMemoryStorageTinyLfu::FrequencySketch sketch;
+  sketch.ensureCapacity(16); // halves counters every 160 increments
+  size_t a = std::hash<Name>()("/A");
+  size_t b = std::hash<Name>()("/B");
+  BOOST_CHECK_EQUAL(sketch.estimate(a), 0);
+
+  for (int i = 0; i < 5; ++i) {
+    sketch.increment(a);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(a), 5);
+  BOOST_CHECK_EQUAL(sketch.estimate(b), 0);
+
+  for (int i = 0; i < 154; ++i) {
+    sketch.increment(b);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(a), 5);
+  BOOST_CHECK_EQUAL(sketch.estimate(b), InMemoryStorageTinyLfu::FrequencySketch::MAX_COUNT);
+
+  sketch.increment(b);
+  BOOST_CHECK_EQUAL(sketch.estimate(a), 2);
+  BOOST_CHECK_EQUAL(sketch.estimate(b), 7);
+
+  // growing the sketch keeps the estimates
+  sketch.ensureCapacity(1000);
+  BOOST_CHECK_EQUAL(sketch.estimate(a), 2);
+  BOOST_CHECK_EQUAL(sketch.estimate(b), 7);
+  sketch.ensureCapacity(16);
+  BOOST_CHECK_EQUAL(sketch.estimate(b), 7);
+}
+
+BOOST_AUTO_TEST_CASE(Admission)
+{
+  InMemoryStorageTinyLfu ims(3);
+  ims.insert(*makeData("/A"));
+  ims.insert(*makeData("/B"));
+  ims.insert(*makeData("/C"));
+  BOOST_CHECK_EQUAL(ims.m_window.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_probation.size(), 2);
+
+  // /C leaves the window and wins against /A, the least recently used packet of the main area
+  for (int i = 0; i < 3; ++i) {
+    ims.find(Name("/C"));
+  }
+  ims.insert(*makeData("/D"));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(!contains(ims, "/A"));
+  BOOST_CHECK(contains(ims, "/B"));
+  BOOST_CHECK(contains(ims, "/C"));
+  BOOST_CHECK(contains(ims, "/D"));
+
+  // /D leaves the window but is not requested more often than /B, so it is evicted
+  ims.insert(*makeData("/E"));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(contains(ims, "/B"));
+  BOOST_CHECK(contains(ims, "/C"));
+  BOOST_CHECK(!contains(ims, "/D"));
+  BOOST_CHECK(contains(ims, "/E"));
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageTinyLfu ims(100);
+  for (int i = 0; i < 50; ++i) {
+    ims.insert(*makeData(Name("/hot").appendNumber(i)));
+  }
+  for (int j = 0; j < 5; ++j) {
+    for (int i = 0; i < 50; ++i) {
+      BOOST_REQUIRE(ims.find(Name("/hot").appendNumber(i)) != nullptr);
+    }
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    ims.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 100);
+
+  size_t nHot = 0;
+  for (int i = 0; i < 50; ++i) {
+    nHot += contains(ims, Name("/hot").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(nHot, 50);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  InMemoryStorageTinyLfu ims(10);
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  ims.find(Name("/A").appendNumber(0));
+
+  ims.erase("/A");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.m_positions.size(), 0);
+  BOOST_CHECK(!ims.evictItem());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorageTinyLfu
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
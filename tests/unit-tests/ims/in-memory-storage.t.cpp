@@ -20,10 +20,12 @@
  */
 
 #include "ims/in-memory-storage.hpp"
+#include "ims/in-memory-storage-arc.hpp"
 #include "ims/in-memory-storage-fifo.hpp"
 #include "ims/in-memory-storage-lfu.hpp"
 #include "ims/in-memory-storage-lru.hpp"
 #include "ims/in-memory-storage-persistent.hpp"
+#include "ims/in-memory-storage-tinylfu.hpp"
 #include "security/signature-sha256-with-rsa.hpp"
 #include "util/sha256.hpp"
 
@@ -44,7 +46,9 @@ BOOST_AUTO_TEST_SUITE(TestInMemoryStorage)
 using InMemoryStorages = boost::mpl::vector<InMemoryStoragePersistent,
                                             InMemoryStorageFifo,
                                             InMemoryStorageLfu,
-                                            InMemoryStorageLru>;
+                                            InMemoryStorageLru,
+                                            InMemoryStorageTinyLfu,
+                                            InMemoryStorageArc>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(Insertion, T, InMemoryStorages)
 {
@@ -628,9 +632,12 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ExcludeSelector, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(found3->getName(), "/c/a");
 }
 
+// InMemoryStorageTinyLfu is not listed, because its admission policy may evict a new packet
+// in favor of an older one, which these test cases do not expect
 using InMemoryStoragesLimited = boost::mpl::vector<InMemoryStorageFifo,
                                                    InMemoryStorageLfu,
-                                                   InMemoryStorageLru>;
+                                                   InMemoryStorageLru,
+                                                   InMemoryStorageArc>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(SetCapacity, T, InMemoryStoragesLimited)
 {
@@ -696,6 +703,125 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesLimited)
   BOOST_CHECK(found == nullptr);
 }
 
+static shared_ptr<Data>
+makeDataWithContentSize(const Name& name, size_t contentSize)
+{
+  shared_ptr<Data> data = makeData(name);
+  std::vector<uint8_t> content(contentSize);
+  data->setContent(content.data(), content.size());
+  signData(data);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ByteLimit, T, InMemoryStoragesLimited)
+{
+  T ims(100);
+  shared_ptr<Data> data1 = makeDataWithContentSize("/A/1", 1000);
+  shared_ptr<Data> data2 = makeDataWithContentSize("/A/2", 1000);
+  shared_ptr<Data> data3 = makeDataWithContentSize("/A/3", 1000);
+  size_t wireSize = data1->wireEncode().size();
+  BOOST_REQUIRE_EQUAL(data3->wireEncode().size(), wireSize);
+
+  ims.setByteLimit(2 * wireSize + wireSize / 2);
+  BOOST_CHECK_EQUAL(ims.getByteLimit(), 2 * wireSize + wireSize / 2);
+  ims.insert(*data1);
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 2 * wireSize);
+
+  ims.insert(*data3);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 2 * wireSize);
+
+  // a packet that exceeds the limit by itself is not inserted
+  BOOST_CHECK_EQUAL(ims.insert(*makeDataWithContentSize("/A/4", 3 * wireSize)), false);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+
+  ims.setByteLimit(wireSize);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), wireSize);
+  BOOST_CHECK(ims.find(data1->getName()) == nullptr);
+  BOOST_CHECK(ims.find(data2->getName()) == nullptr);
+  BOOST_CHECK(ims.find(data3->getName()) != nullptr);
+
+  ims.erase("/A");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(PrefixQuota, T, InMemoryStoragesLimited)
+{
+  T ims(100);
+  size_t wireSize = makeDataWithContentSize("/hot/1", 100)->wireEncode().size();
+
+  ims.setPrefixQuota("/hot", 2 * wireSize);
+  ims.insert(*makeDataWithContentSize("/old/1", 100));
+  ims.insert(*makeDataWithContentSize("/old/2", 100));
+  for (int i = 1; i <= 5; ++i) {
+    ims.insert(*makeDataWithContentSize(Name("/hot").append(to_string(i)), 100));
+  }
+
+  // the busy namespace evicts its own packets only
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 4 * wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 2 * wireSize);
+  BOOST_CHECK(ims.find("/old/1") != nullptr);
+  BOOST_CHECK(ims.find("/old/2") != nullptr);
+  BOOST_CHECK(ims.find("/hot/3") == nullptr);
+  BOOST_CHECK(ims.find("/hot/5") != nullptr);
+
+  // a packet is counted against the quota of the longest prefix
+  ims.setPrefixQuota("/hot/5", wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot/5"), wireSize);
+  ims.unsetPrefixQuota("/hot/5");
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 2 * wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot/5"), 0);
+
+  ims.setPrefixQuota("/hot", wireSize);
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), wireSize);
+
+  ims.unsetPrefixQuota("/hot");
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 0);
+  ims.insert(*makeDataWithContentSize("/hot/6", 100));
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(NestedPrefixQuota, T, InMemoryStoragesLimited)
+{
+  T ims(100);
+  size_t wireSize = makeDataWithContentSize("/hot/a/1", 100)->wireEncode().size();
+
+  ims.setPrefixQuota("/hot", 2 * wireSize);
+  ims.setPrefixQuota("/hot/a", wireSize);
+  ims.insert(*makeDataWithContentSize("/hot/b/1", 100));
+  ims.insert(*makeDataWithContentSize("/hot/a/1", 100));
+  ims.insert(*makeDataWithContentSize("/hot/a/2", 100));
+  ims.insert(*makeDataWithContentSize("/hot/b/2", 100));
+  ims.insert(*makeDataWithContentSize("/hot/b/3", 100));
+
+  // each quota evicts packets counted against itself only
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 2 * wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot/a"), wireSize);
+  BOOST_CHECK(ims.find("/hot/b/1") == nullptr);
+  BOOST_CHECK(ims.find("/hot/a/1") == nullptr);
+  BOOST_CHECK(ims.find("/hot/a/2") != nullptr);
+  BOOST_CHECK(ims.find("/hot/b/2") != nullptr);
+  BOOST_CHECK(ims.find("/hot/b/3") != nullptr);
+
+  // packets of a removed quota are counted against the quota of the next shorter prefix
+  ims.unsetPrefixQuota("/hot/a");
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 2 * wireSize);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot/a"), 0);
+
+  ims.erase("/hot");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.getPrefixQuotaUsage("/hot"), 0);
+}
+
 // Find function is implemented at the base case, so it's sufficient to test for one derived class.
 class FindFixture : public tests::UnitTestTimeFixture
 {
@@ -1052,6 +1178,29 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   BOOST_CHECK_EQUAL(find(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(MustBeFreshAfterErase)
+{
+  Name data1Name = insert(1, "ndn:/A/1", 500_ms);
+  insert(2, "ndn:/A/2", 1500_ms);
+  m_ims.erase(data1Name, false);
+
+  // the erased entry is reused before its MustBeFresh processing window elapses
+  insert(3, "ndn:/A/3", 2500_ms);
+  advanceClocks(1000_ms);
+  startInterest("ndn:/A")
+    .setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(find(), 2);
+
+  advanceClocks(1000_ms);
+  BOOST_CHECK_EQUAL(find(), 3);
+
+  m_ims.erase("ndn:/A/3");
+  BOOST_CHECK_EQUAL(find(), 0);
+  startInterest("ndn:/A")
+    .setMustBeFresh(false);
+  BOOST_CHECK_EQUAL(find(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorage
 BOOST_AUTO_TEST_SUITE_END() // Ims
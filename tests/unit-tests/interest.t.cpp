@@ -250,8 +250,140 @@ BOOST_AUTO_TEST_CASE(UnrecognizedCriticalElement)
   BOOST_CHECK_THROW(i.wireDecode("0507 0703080149 FB00"_block), tlv::Error);
 }
 
+BOOST_AUTO_TEST_CASE(Lazy)
+{
+  Block wire("053B FC00 0703080149 FC00 2100 FC00 1200 "
+             "FC00 1E0B(1F09 1E023E15 0703080148) FC00 0A044ACB1E4C "
+             "FC00 0C0276A1 FC00 2201D6 FC00 2304C0C1C2C3 FC00"_block);
+  Interest eager(wire);
+  i.wireDecodeLazy(wire);
+  BOOST_CHECK_EQUAL(i.getName(), "/I");
+  BOOST_CHECK_EQUAL(i.getNonce(), 0x4c1ecb4a);
+  BOOST_CHECK_EQUAL(i.getInterestLifetime(), 30369_ms);
+  BOOST_CHECK_EQUAL(i.getCanBePrefix(), true);
+  BOOST_CHECK_EQUAL(i.getMustBeFresh(), true);
+
+  // const getters of deferred fields do not decode them
+  BOOST_CHECK(i.hasLazyFields());
+  BOOST_CHECK_THROW(i.getForwardingHint(), Interest::Error);
+  BOOST_CHECK(i.hasLazyFields());
+
+  i.decodeLazyFields();
+  BOOST_CHECK(!i.hasLazyFields());
+  BOOST_CHECK_EQUAL(i.getForwardingHint(), DelegationList({{15893, "/H"}}));
+  BOOST_CHECK_EQUAL(i, eager);
+
+  // encode without modification: retain original wire encoding
+  i.wireDecodeLazy(wire);
+  BOOST_CHECK_EQUAL(i.wireEncode().value_size(), 59);
+
+  // modify then re-encode: lazy fields are decoded before wire encoding is discarded
+  i.wireDecodeLazy(wire);
+  i.setInterestLifetime(1_s);
+  eager.setInterestLifetime(1_s);
+  BOOST_CHECK_EQUAL(i.wireEncode(), eager.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(LazyMalformedForwardingHint)
+{
+  Block wire("0511 0703080149 1E04(1F021E00) 0A044ACB1E4C"_block);
+  BOOST_CHECK_THROW(i.wireDecode(wire), tlv::Error);
+
+  BOOST_CHECK_NO_THROW(i.wireDecodeLazy(wire));
+  BOOST_CHECK_EQUAL(i.getName(), "/I");
+  BOOST_CHECK_EQUAL(i.getNonce(), 0x4c1ecb4a);
+  BOOST_CHECK_THROW(i.decodeLazyFields(), tlv::Error);
+  BOOST_CHECK_THROW(i.setNonce(1), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(LazyOutOfOrder)
+{
+  // element order is checked immediately
+  BOOST_CHECK_THROW(i.wireDecodeLazy(
+    "0529 0703080149 2100 1200 0A044ACB1E4C "
+    "1E0B(1F09 1E023E15 0703080148) 0C0276A1 2201D6 2304C0C1C2C3"_block),
+    tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Decode03
 
+BOOST_AUTO_TEST_CASE(DecodeLazy02)
+{
+  Interest i1;
+  i1.setName("/local/ndn/prefix");
+  i1.setCanBePrefix(true);
+  i1.setMinSuffixComponents(1);
+  i1.setMustBeFresh(true);
+  i1.setNonce(1);
+  i1.setForwardingHint({{1, "/A"}});
+  Block wire = i1.wireEncode();
+
+  Interest i2;
+  i2.wireDecodeLazy(wire);
+  BOOST_CHECK_EQUAL(i2.getName(), "/local/ndn/prefix");
+  BOOST_CHECK_EQUAL(i2.getNonce(), 1);
+  BOOST_CHECK_THROW(i2.getMinSuffixComponents(), Interest::Error);
+  BOOST_CHECK_THROW(i2.getMustBeFresh(), Interest::Error);
+  BOOST_CHECK_THROW(i2.getForwardingHint(), Interest::Error);
+  i2.decodeLazyFields();
+  BOOST_CHECK_EQUAL(i2.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i2.getMustBeFresh(), true);
+  BOOST_CHECK_EQUAL(i2.getForwardingHint(), DelegationList({{1, "/A"}}));
+  BOOST_CHECK_EQUAL(i1, i2);
+
+  Interest i3;
+  i3.wireDecodeLazy(wire);
+  i3.setMaxSuffixComponents(4);
+  BOOST_CHECK_EQUAL(i3.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i3.getForwardingHint(), DelegationList({{1, "/A"}}));
+}
+
+BOOST_AUTO_TEST_CASE(DecodeLazyModify)
+{
+  Interest i1;
+  i1.setName("/A");
+  i1.setCanBePrefix(false);
+  i1.setMustBeFresh(true);
+  i1.setNonce(1);
+  i1.setForwardingHint({{1, "/F"}});
+  const Block wire02 = i1.wireEncode();
+  const Block wire03("053B FC00 0703080149 FC00 2100 FC00 1200 "
+                     "FC00 1E0B(1F09 1E023E15 0703080148) FC00 0A044ACB1E4C "
+                     "FC00 0C0276A1 FC00 2201D6 FC00 2304C0C1C2C3 FC00"_block);
+
+  // every mutator must decode the deferred fields before discarding the wire encoding
+  const std::vector<std::function<void(Interest&)>> modifiers{
+    [] (Interest& i) { i.setName("/B"); },
+    [] (Interest& i) { i.setCanBePrefix(true); },
+    [] (Interest& i) { i.setMustBeFresh(false); },
+    [] (Interest& i) { i.setForwardingHint({{2, "/G"}}); },
+    [] (Interest& i) { i.modifyForwardingHint([] (DelegationList& fh) { fh.insert(3, "/H"); }); },
+    [] (Interest& i) { i.setNonce(2); },
+    [] (Interest& i) { i.refreshNonce(); i.setNonce(3); },
+    [] (Interest& i) { i.setInterestLifetime(1_s); },
+    [] (Interest& i) { i.setSelectors(Selectors().setChildSelector(1)); },
+    [] (Interest& i) { i.setMinSuffixComponents(2); },
+    [] (Interest& i) { i.setMaxSuffixComponents(4); },
+    [] (Interest& i) { i.setPublisherPublicKeyLocator(KeyLocator("/K")); },
+    [] (Interest& i) { i.setExclude(Exclude().excludeOne(name::Component("x"))); },
+    [] (Interest& i) { i.setChildSelector(1); },
+  };
+
+  for (const Block& wire : {wire02, wire03}) {
+    for (size_t n = 0; n < modifiers.size(); ++n) {
+      BOOST_TEST_MESSAGE("wire size " << wire.size() << ", modifier " << n);
+      Interest eager(wire);
+      modifiers[n](eager);
+
+      Interest lazy;
+      lazy.wireDecodeLazy(wire);
+      modifiers[n](lazy);
+      BOOST_CHECK_EQUAL(lazy, eager);
+      BOOST_CHECK_EQUAL(lazy.wireEncode(), eager.wireEncode());
+    }
+  }
+}
+
 // ---- matching ----
 
 BOOST_AUTO_TEST_CASE(MatchesData)
@@ -461,6 +593,26 @@ BOOST_AUTO_TEST_CASE(RefreshNonce)
   BOOST_CHECK_NE(i.getNonce(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(SetRandomNonces)
+{
+  std::vector<Interest> interests(5, Interest("/A"));
+  for (Interest& interest : interests) {
+    interest.setCanBePrefix(false);
+  }
+  interests[1].setNonce(1);
+  interests[1].wireEncode();
+  Interest::setRandomNonces(interests.begin(), interests.end());
+
+  std::set<uint32_t> nonces;
+  for (const Interest& interest : interests) {
+    BOOST_CHECK(interest.hasNonce());
+    nonces.insert(interest.getNonce());
+  }
+  BOOST_CHECK_NE(interests[1].getNonce(), 1);
+  BOOST_CHECK_EQUAL(Interest(interests[1].wireEncode()).getNonce(), interests[1].getNonce());
+  BOOST_CHECK_EQUAL(nonces.size(), interests.size()); // collisions are extremely unlikely
+}
+
 BOOST_AUTO_TEST_CASE(SetInterestLifetime)
 {
   BOOST_CHECK_THROW(Interest("/A", time::milliseconds(-1)), std::invalid_argument);
@@ -61,7 +61,44 @@ BOOST_AUTO_TEST_CASE(FieldAccess)
   BOOST_CHECK(packet.empty());
 }
 
-/// \todo test field access methods with a REPEATABLE field
+BOOST_AUTO_TEST_CASE(FieldAccessRepeatable)
+{
+  Packet packet;
+  packet.add<AckField>(2);
+  packet.add<FragIndexField>(7);
+  packet.add<AckField>(4);
+  packet.add<TxSequenceField>(9);
+  packet.add<AckField>(3);
+
+  BOOST_CHECK_EQUAL(packet.count<AckField>(), 3);
+  BOOST_CHECK_EQUAL(packet.get<AckField>(0), 2);
+  BOOST_CHECK_EQUAL(packet.get<AckField>(1), 4);
+  BOOST_CHECK_EQUAL(packet.get<AckField>(2), 3);
+  BOOST_CHECK_THROW(packet.get<AckField>(3), std::out_of_range);
+  BOOST_CHECK_EQUAL(packet.get<FragIndexField>(), 7);
+  BOOST_CHECK_EQUAL(packet.get<TxSequenceField>(), 9);
+
+  packet.remove<AckField>(1);
+  std::vector<Sequence> acks = packet.list<AckField>();
+  BOOST_REQUIRE_EQUAL(acks.size(), 2);
+  BOOST_CHECK_EQUAL(acks[0], 2);
+  BOOST_CHECK_EQUAL(acks[1], 3);
+  BOOST_CHECK_EQUAL(packet.get<TxSequenceField>(), 9);
+
+  packet.clear<FragIndexField>();
+  BOOST_CHECK(!packet.has<FragIndexField>());
+  BOOST_CHECK_EQUAL(packet.count<AckField>(), 2);
+  BOOST_CHECK_EQUAL(packet.get<AckField>(1), 3);
+  BOOST_CHECK_EQUAL(packet.get<TxSequenceField>(), 9);
+
+  Packet decoded(packet.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.count<AckField>(), 2);
+  BOOST_CHECK_EQUAL(decoded.get<AckField>(0), 2);
+  BOOST_CHECK_EQUAL(decoded.get<AckField>(1), 3);
+  BOOST_CHECK_EQUAL(decoded.get<TxSequenceField>(), 9);
+  BOOST_CHECK(!decoded.has<FragIndexField>());
+  BOOST_CHECK(!decoded.has<FragmentField>());
+}
 
 BOOST_AUTO_TEST_CASE(EncodeFragment)
 {
@@ -393,14 +393,30 @@ BOOST_AUTO_TEST_CASE(StatusDataset)
   advanceClocks(1_ms, 10);
 
   // two data packets are generated, the first one will be sent to both places
-  // while the second one will only be inserted into the in-memory storage
+  // while the second one will be signed when requested
   BOOST_CHECK_EQUAL(face.sentData.size(), 1);
-  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(storage.size(), 1);
 
   // segment0 should be sent through the face
   const auto& component = face.sentData[0].getName().at(-1);
   BOOST_CHECK(component.isSegment());
   BOOST_CHECK_EQUAL(component.toSegment(), 0);
+  BOOST_CHECK(!face.sentData[0].getFinalBlock());
+
+  // segment1 is signed upon request, and then inserted into the in-memory storage
+  Name segment1Name = face.sentData[0].getName().getPrefix(-1).appendSegment(1);
+  face.receive(*makeInterest(segment1Name));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), segment1Name);
+  BOOST_CHECK_EQUAL(face.sentData[1].getFinalBlock().value(), segment1Name[-1]);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+
+  // segment1 is served from the in-memory storage afterwards
+  face.receive(*makeInterest(segment1Name));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_EQUAL(face.sentData[2].wireEncode(), face.sentData[1].wireEncode());
 
   std::vector<Data> dataInStorage;
   std::copy(storage.begin(), storage.end(), std::back_inserter(dataInStorage));
@@ -436,6 +452,41 @@ BOOST_AUTO_TEST_CASE(StatusDataset)
   BOOST_CHECK_EQUAL(storage.size(), 0); // the nack packet will not be inserted into the in-memory storage
 }
 
+BOOST_AUTO_TEST_CASE(StatusDatasetPendingSegmentExpiry)
+{
+  Block largeBlock = makeBinaryBlock(129, std::vector<uint8_t>(MAX_NDN_PACKET_SIZE, 1).data(),
+                                     MAX_NDN_PACKET_SIZE);
+  dispatcher.addStatusDataset("test/large",
+                              makeTestAuthorization(),
+                              [&largeBlock] (const Name& prefix, const Interest& interest,
+                                             StatusDatasetContext& context) {
+                                context.setExpiry(100_ms);
+                                context.append(largeBlock);
+                                context.end();
+                              });
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  face.receive(*makeInterest("/root/test/large/valid"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  Name prefix = face.sentData[0].getName().getPrefix(-1);
+
+  face.receive(*makeInterest(Name(prefix).appendSegment(1)));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+
+  BOOST_CHECK_EQUAL(dispatcher.m_pendingDatasets.size(), 1);
+
+  // unsigned segments are discarded when the response expires
+  advanceClocks(10_ms, 10);
+  BOOST_CHECK_EQUAL(dispatcher.m_pendingDatasets.size(), 0);
+  face.receive(*makeInterest(Name(prefix).appendSegment(2)));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(NotificationStream)
 {
   const uint8_t buf[] = {0x82, 0x01, 0x02};
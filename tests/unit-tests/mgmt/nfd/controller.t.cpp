@@ -148,6 +148,65 @@ BOOST_AUTO_TEST_CASE(OptionsPrefix)
   BOOST_CHECK(Name("/localhop/net/example/router1/nfd/rib/register").isPrefixOf(requestInterest.getName()));
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  std::vector<ControlParameters> parametersList;
+  for (int i = 0; i < 3; ++i) {
+    parametersList.push_back(ControlParameters().setName(Name("/ndn/com/example").appendNumber(i)));
+  }
+
+  controller.start<RibRegisterCommand>(parametersList, succeedCallback, commandFailCallback);
+  this->advanceClocks(1_ms);
+
+  // all commands are expressed without waiting for responses
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 3);
+  for (size_t i = 0; i < face.sentInterests.size(); ++i) {
+    const Interest& requestInterest = face.sentInterests[i];
+    BOOST_CHECK(Name("/localhost/nfd/rib/register").isPrefixOf(requestInterest.getName()));
+    ControlParameters request(requestInterest.getName().at(4).blockFromValue());
+    BOOST_CHECK_EQUAL(request.getName(), parametersList[i].getName());
+    BOOST_CHECK_EQUAL(requestInterest.getInterestLifetime(), CommandOptions::DEFAULT_TIMEOUT);
+    if (i > 0) {
+      BOOST_CHECK_GT(requestInterest.getName().at(command_interest::POS_TIMESTAMP),
+                     face.sentInterests[i - 1].getName().at(command_interest::POS_TIMESTAMP));
+    }
+  }
+
+  // responses may arrive in any order
+  for (size_t i : {2, 0, 1}) {
+    auto responseData = makeData(face.sentInterests.at(i).getName());
+    ControlParameters responseBody(parametersList[i]);
+    responseBody.setFaceId(1)
+                .setOrigin(ROUTE_ORIGIN_APP)
+                .setCost(0)
+                .setFlags(ROUTE_FLAG_CHILD_INHERIT);
+    ControlResponse response(200, "OK");
+    response.setBody(responseBody.wireEncode());
+    responseData->setContent(response.wireEncode());
+    face.receive(*responseData);
+    this->advanceClocks(1_ms);
+  }
+
+  BOOST_CHECK_EQUAL(failCodes.size(), 0);
+  BOOST_REQUIRE_EQUAL(succeeds.size(), 3);
+  BOOST_CHECK_EQUAL(succeeds[0].getName(), parametersList[2].getName());
+  BOOST_CHECK_EQUAL(succeeds[1].getName(), parametersList[0].getName());
+  BOOST_CHECK_EQUAL(succeeds[2].getName(), parametersList[1].getName());
+}
+
+BOOST_AUTO_TEST_CASE(BatchInvalidRequest)
+{
+  std::vector<ControlParameters> parametersList(2);
+  parametersList[0].setName("/ndn/com/example");
+  // Name is missing in parametersList[1]
+
+  BOOST_CHECK_THROW(controller.start<RibRegisterCommand>(
+                      parametersList, succeedCallback, commandFailCallback),
+                    ControlCommand::ArgumentError);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(InvalidRequest)
 {
   ControlParameters parameters;
@@ -134,6 +134,33 @@ BOOST_AUTO_TEST_CASE(InvalidType)
   BOOST_CHECK_THROW(Component::fromEscapedString("+9=A"), Component::Error);
 }
 
+BOOST_AUTO_TEST_CASE(Percent)
+{
+  BOOST_CHECK_EQUAL(Component::fromEscapedString("%41%2f"), Component("A/"));
+  BOOST_CHECK_EQUAL(Component::fromEscapedString("%4G%"), Component("%4G%"));
+  BOOST_CHECK_EQUAL(Component::fromEscapedString("A%4"), Component("A%4"));
+  BOOST_CHECK_EQUAL(Component::fromEscapedString("%%41"), Component("%%41"));
+  BOOST_CHECK_EQUAL(Component::fromEscapedString("/A/%42/", 3, 6), Component("B"));
+}
+
+BOOST_AUTO_TEST_CASE(ToUriBuffer)
+{
+  char buf[16];
+  std::fill_n(buf, sizeof(buf), 'x');
+  Component comp("0907 6E646E2F637878"_block);
+  BOOST_CHECK_EQUAL(comp.toUri(buf, 11), 11);
+  BOOST_CHECK_EQUAL(std::string(buf, 12), "9=ndn%2Fcxxx");
+
+  std::fill_n(buf, sizeof(buf), 'x');
+  BOOST_CHECK_EQUAL(comp.toUri(buf, 10), 11);
+  BOOST_CHECK_EQUAL(std::string(buf, 11), "xxxxxxxxxxx");
+  BOOST_CHECK_EQUAL(comp.toUri(nullptr, 0), 11);
+
+  comp.wireDecode("0800"_block);
+  BOOST_CHECK_EQUAL(comp.toUri(buf, sizeof(buf)), 3);
+  BOOST_CHECK_EQUAL(std::string(buf, 3), "...");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Decode
 
 BOOST_AUTO_TEST_CASE(Compare)
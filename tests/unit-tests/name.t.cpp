@@ -88,6 +88,46 @@ BOOST_AUTO_TEST_CASE(ParseUri)
   BOOST_CHECK_THROW(Name("/hello/../world"), name::Component::Error);
 }
 
+BOOST_AUTO_TEST_CASE(ParseUriWithLength)
+{
+  std::string uris = "/A/%42/C /D/0=E /F";
+  BOOST_CHECK_EQUAL(Name(uris.data(), 8), Name("/A/B/C"));
+  BOOST_CHECK_EQUAL(Name(uris.data(), 6), Name("/A/B"));
+  BOOST_CHECK_EQUAL(Name(uris.data(), 0), Name());
+  BOOST_CHECK_EQUAL(Name(uris.data() + 16, 2), Name("/F"));
+  BOOST_CHECK_THROW(Name(uris.data() + 9, 6), name::Component::Error);
+
+  Name name(uris.data(), 8);
+  BOOST_CHECK(name.hasWire());
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0709 080141 080142 080143"_block);
+
+  // TLV-LENGTH of the Name and the component needs three octets
+  std::string longUri = "/" + std::string(300, 'A');
+  name = Name(longUri.data(), longUri.size());
+  BOOST_CHECK_EQUAL(name.size(), 1);
+  BOOST_CHECK_EQUAL(name.wireEncode().size(), 1 + 3 + 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(name.toUri(), longUri);
+}
+
+BOOST_AUTO_TEST_CASE(ToUriBuffer)
+{
+  Name name("/hello/9=world/%00%01");
+  char buf[32];
+  BOOST_CHECK_EQUAL(name.toUri(buf, sizeof(buf)), 21);
+  BOOST_CHECK_EQUAL(std::string(buf, 21), "/hello/9=world/%00%01");
+  BOOST_CHECK_EQUAL(name.toUri(buf, 20), 21);
+  BOOST_CHECK_EQUAL(name.toUri(nullptr, 0), 21);
+
+  BOOST_CHECK_EQUAL(Name().toUri(buf, sizeof(buf)), 1);
+  BOOST_CHECK_EQUAL(buf[0], '/');
+
+  // longer than the stack buffer used by operator<<
+  std::string longUri = "/" + std::string(200, 'A') + "/" + std::string(200, '+');
+  std::ostringstream os;
+  os << Name(longUri);
+  BOOST_CHECK_EQUAL(os.str().size(), 1 + 200 + 1 + 600);
+}
+
 BOOST_AUTO_TEST_CASE(DeepCopy)
 {
   Name n1("/hello/world");
@@ -282,6 +322,119 @@ BOOST_AUTO_TEST_CASE(Markers)
   BOOST_CHECK_EQUAL(number, 11676);
 }
 
+BOOST_AUTO_TEST_CASE(SetComponent)
+{
+  Name name("/A/B/C");
+  name.set(1, Component("XY"));
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070A 080141 08025859 080143"_block);
+
+  name.set(-1, Component("Z"));
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070A 080141 08025859 08015A"_block);
+
+  name.set(0, name[2]);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070A 08015A 08025859 08015A"_block);
+}
+
+BOOST_AUTO_TEST_SUITE(Reserve)
+
+BOOST_AUTO_TEST_CASE(Append)
+{
+  Name name;
+  name.reserve(4, 16);
+  BOOST_CHECK_EQUAL(name.capacity(), 16);
+  BOOST_CHECK(name.hasWire());
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0700"_block);
+
+  name.append(Component("Emid"));
+  BOOST_CHECK(name.hasWire());
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0706 0804456D6964"_block);
+
+  name.append(25042, reinterpret_cast<const uint8_t*>("P3"), 2);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070C 0804456D6964 FD61D2025033"_block);
+
+  name.append("0100"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0710 0804456D6964 FD61D2025033 08020100"_block);
+  BOOST_CHECK_EQUAL(name.capacity(), 16);
+
+  // TLV-LENGTH exceeds capacity
+  name.append("080109"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0713 0804456D6964 FD61D2025033 08020100 080109"_block);
+  BOOST_CHECK_EQUAL(name.capacity(), 32);
+  BOOST_CHECK_EQUAL(name, Name("/Emid/25042=P3/%01%00/%09"));
+  BOOST_CHECK_EQUAL(name[1].type(), 25042);
+  BOOST_CHECK_EQUAL(name[1].wireEncode(), "FD61D2025033"_block);
+
+  name.clear();
+  BOOST_CHECK(name.empty());
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0700"_block);
+  BOOST_CHECK_EQUAL(name.capacity(), 32);
+
+  name.appendSegment(0x0102);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0705 0803000102"_block);
+}
+
+BOOST_AUTO_TEST_CASE(ExistingComponents)
+{
+  Name name("/A/B");
+  name.reserve(3, 10);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0706 080141 080142"_block);
+
+  name.append(name[0]);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0709 080141 080142 080141"_block);
+
+  name.append(PartialName("/C"));
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070C 080141 080142 080141 080143"_block);
+}
+
+BOOST_AUTO_TEST_CASE(SetInPlace)
+{
+  Name name("/A");
+  name.reserve(2, 16);
+  name.appendSegment(0);
+  const uint8_t* wire = name.wireEncode().wire();
+
+  for (uint64_t segment = 1; segment < 300; ++segment) {
+    name.set(-1, Component::fromSegment(segment));
+    BOOST_CHECK_EQUAL(name.at(-1).toSegment(), segment);
+  }
+  BOOST_CHECK_EQUAL(name.wireEncode().wire(), wire);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0708 080141 080300012B"_block);
+
+  name.set(0, Component("BCD"));
+  BOOST_CHECK_EQUAL(name.wireEncode(), "070A 0803424344 080300012B"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode().wire(), wire);
+  BOOST_CHECK_EQUAL(name[1].wire(), wire + 7);
+}
+
+BOOST_AUTO_TEST_CASE(CopyOnWrite)
+{
+  Name name("/A");
+  name.reserve(2, 16);
+  name.appendSegment(0);
+
+  Name copy = name;
+  name.set(-1, Component::fromSegment(1));
+  BOOST_CHECK_EQUAL(copy.wireEncode(), "0707 080141 08020000"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0707 080141 08020001"_block);
+
+  Component component = name[-1];
+  Block wire = name.wireEncode();
+  name.set(-1, Component::fromSegment(2));
+  BOOST_CHECK_EQUAL(component.wireEncode(), "08020001"_block);
+  BOOST_CHECK_EQUAL(wire, "0707 080141 08020001"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0707 080141 08020002"_block);
+
+  copy.append("B");
+  BOOST_CHECK_EQUAL(copy.wireEncode(), "070A 080141 08020000 080142"_block);
+  BOOST_CHECK_EQUAL(name.wireEncode(), "0707 080141 08020002"_block);
+
+  Name deepCopy = name.deepCopy();
+  BOOST_CHECK_EQUAL(deepCopy.capacity(), 0);
+  BOOST_CHECK_EQUAL(deepCopy, name);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Reserve
+
 // ---- algorithms ----
 
 BOOST_AUTO_TEST_CASE(GetSuccessor)
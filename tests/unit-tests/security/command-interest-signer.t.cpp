@@ -21,6 +21,7 @@
 
 #include "security/command-interest-signer.hpp"
 #include "security/signing-helpers.hpp"
+#include "security/verification-helpers.hpp"
 
 #include "boost-test.hpp"
 #include "../identity-management-time-fixture.hpp"
@@ -61,6 +62,32 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_GT(i2.getName().at(command_interest::POS_TIMESTAMP), i1.getName().at(command_interest::POS_TIMESTAMP));
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  Identity id = addIdentity("/test");
+
+  CommandInterestSigner signer(m_keyChain);
+  BOOST_CHECK(signer.makeCommandInterests({}).empty());
+
+  Interest i0 = signer.makeCommandInterest("/hello/world");
+  std::vector<Interest> batch = signer.makeCommandInterests({"/hello/A", "/hello/B/!", "/hello/C"},
+                                                            signingByIdentity(id));
+  BOOST_REQUIRE_EQUAL(batch.size(), 3);
+  BOOST_CHECK_EQUAL(batch[0].getName().getPrefix(2), "/hello/A");
+  BOOST_CHECK_EQUAL(batch[1].getName().getPrefix(3), "/hello/B/!");
+  BOOST_CHECK_EQUAL(batch[2].getName().getPrefix(2), "/hello/C");
+
+  name::Component lastTimestamp = i0.getName().at(command_interest::POS_TIMESTAMP);
+  for (const Interest& interest : batch) {
+    BOOST_CHECK_EQUAL(interest.getName().at(command_interest::POS_SIG_INFO).blockFromValue().type(),
+                      tlv::SignatureInfo);
+    BOOST_CHECK_GT(interest.getName().at(command_interest::POS_TIMESTAMP), lastTimestamp);
+    lastTimestamp = interest.getName().at(command_interest::POS_TIMESTAMP);
+    BOOST_CHECK_EQUAL(interest.getCanBePrefix(), false);
+    BOOST_CHECK(verifySignature(interest, id.getDefaultKey()));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCommandInterestSigner
 BOOST_AUTO_TEST_SUITE_END() // Security
 
@@ -171,6 +171,40 @@ BOOST_AUTO_TEST_CASE(EmptyInput)
   BOOST_CHECK_EQUAL(os.buf()->size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Whitespace)
+{
+  auto decode = [] (const std::string& in) {
+    OBufferStream os;
+    bufferSource(in) >> base64Decode() >> streamSink(os);
+    ConstBufferPtr buf = os.buf();
+    return std::string(buf->begin(), buf->end());
+  };
+
+  BOOST_CHECK_EQUAL(decode("Zm9v\r\nYmFy\r\n"), "foobar");
+  BOOST_CHECK_EQUAL(decode(" Zm 9v\tYmFy "), "foobar");
+
+  // lines long enough to be decoded in blocks, broken by CR/LF and spaces
+  std::string line = "AAECAwQFBgcICQoLDA0ODwABAgMEBQYHCAkKCwwNDg8AAQIDBAUGBwgJCgsMDQ4P";
+  std::string expected = decode(line + line + line);
+  BOOST_CHECK_EQUAL(expected.size(), 144);
+  BOOST_CHECK_EQUAL(decode(line + "\r\n" + line + "\r\n" + line + "\r\n"), expected);
+  BOOST_CHECK_EQUAL(decode(line + " " + line.substr(0, 40) + " \r " + line.substr(40) + line),
+                    expected);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInput)
+{
+  auto decode = [] (const std::string& in) {
+    OBufferStream os;
+    bufferSource(in) >> base64Decode() >> streamSink(os);
+  };
+
+  BOOST_CHECK_NO_THROW(decode("Zm9v\nYmE=\n"));
+  BOOST_CHECK_THROW(decode("Zm9v*mE="), Error);
+  BOOST_CHECK_THROW(decode("Zm9vYg==Zg=="), Error);
+  BOOST_CHECK_THROW(decode("Zm9vYmE"), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestBase64Decode
 BOOST_AUTO_TEST_SUITE_END() // Transform
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -79,6 +79,24 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL_COLLECTIONS(in3.begin(), in3.end(), out3.begin(), out3.end());
 }
 
+BOOST_AUTO_TEST_CASE(MultipleBuffers)
+{
+  std::string in1 = "0123456701234567";
+  std::string in2 = "89abcdef";
+  uint8_t in3[] = {0x00, 0x01, 0x02};
+
+  std::ostringstream os1;
+  bufferSource(InputBuffers{}) >> streamSink(os1);
+  BOOST_CHECK_EQUAL(os1.str(), "");
+
+  std::ostringstream os2;
+  bufferSource(InputBuffers{{reinterpret_cast<const uint8_t*>(in1.data()), in1.size()},
+                            {in3, 0},
+                            {reinterpret_cast<const uint8_t*>(in2.data()), in2.size()},
+                            {in3, sizeof(in3)}}) >> streamSink(os2);
+  BOOST_CHECK_EQUAL(os2.str(), in1 + in2 + std::string("\x00\x01\x02", 3));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestBufferSource
 BOOST_AUTO_TEST_SUITE_END() // Transform
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -91,6 +91,12 @@ BOOST_AUTO_TEST_CASE(Rsa)
   auto sig = os2.buf();
 
   BOOST_CHECK(verifySignature(data, sizeof(data), sig->data(), sig->size(), pubKey->data(), pubKey->size()));
+
+  // discontiguous input yields the same signature as its concatenation
+  OBufferStream os3;
+  bufferSource(InputBuffers{{data, 1}, {data + 1, 0}, {data + 1, sizeof(data) - 1}})
+    >> signerFilter(DigestAlgorithm::SHA256, sKey) >> streamSink(os3);
+  BOOST_CHECK(*os3.buf() == *sig);
 }
 
 BOOST_AUTO_TEST_CASE(Ecdsa)
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/transform/span-sink.hpp"
+#include "security/transform/buffer-source.hpp"
+#include "security/transform/hex-encode.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace transform {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(Transform)
+BOOST_AUTO_TEST_SUITE(TestSpanSink)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  uint8_t in[] = {0x00, 0x01, 0x02, 0x03, 0x04};
+  uint8_t out[8] = {};
+  size_t size = 42;
+  SpanSink sink(out, sizeof(out), size);
+  BOOST_CHECK_EQUAL(size, 0);
+  BOOST_CHECK_EQUAL(sink.write(in, 3), 3);
+  BOOST_CHECK_EQUAL(sink.write(in + 3, 0), 0);
+  BOOST_CHECK_EQUAL(sink.write(in + 3, 2), 2);
+  sink.end();
+  BOOST_CHECK_EQUAL(size, 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(in, in + sizeof(in), out, out + size);
+  BOOST_CHECK_THROW(sink.write(in, 1), transform::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Chain)
+{
+  uint8_t in[] = {0xab, 0xcd};
+  char out[4];
+  size_t size = 0;
+  bufferSource(in, sizeof(in)) >> hexEncode() >> spanSink(reinterpret_cast<uint8_t*>(out),
+                                                           sizeof(out), size);
+  BOOST_CHECK_EQUAL(std::string(out, size), "abcd");
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  uint8_t in[] = {0x00, 0x01, 0x02, 0x03, 0x04};
+  uint8_t out[4];
+  size_t size = 0;
+  BOOST_CHECK_THROW(bufferSource(in, sizeof(in)) >> spanSink(out, sizeof(out), size), Error);
+
+  SpanSink sink(out, sizeof(out), size);
+  BOOST_CHECK_EQUAL(sink.write(in, 4), 4);
+  BOOST_CHECK_THROW(sink.write(in + 4, 1), Error);
+  BOOST_CHECK_EQUAL(size, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSpanSink
+BOOST_AUTO_TEST_SUITE_END() // Transform
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace transform
+} // namespace security
+} // namespace ndn
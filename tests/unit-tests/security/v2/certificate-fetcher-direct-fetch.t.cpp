@@ -30,6 +30,8 @@
 #include <boost/range/adaptor/strided.hpp>
 #include <boost/range/adaptor/sliced.hpp>
 
+#include <set>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -191,6 +193,36 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ValidateFailureInterest, T, Failures, Certifica
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(JoinFromAnotherFace, CertificateFetcherDirectFetchFixture<Cert>)
+{
+  size_t nValidated = 0;
+  auto onSuccess = [&] (const auto&) { ++nValidated; };
+  auto onFailure = [] (const auto&, const ValidationError& error) { BOOST_ERROR(error); };
+
+  // both packets are signed by the same uncached certificate, but arrived from different faces
+  this->interest.setTag(make_shared<lp::IncomingFaceIdTag>(456));
+  this->validator.validate(this->data, onSuccess, onFailure);
+  this->validator.validate(this->interest, onSuccess, onFailure);
+  this->mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nValidated, 2);
+
+  std::multiset<uint64_t> nextHops;
+  size_t nInfrastructureInterests = 0;
+  for (const auto& sentInterest : this->face.sentInterests) {
+    auto nextHopFaceIdTag = sentInterest.template getTag<lp::NextHopFaceIdTag>();
+    if (nextHopFaceIdTag == nullptr) {
+      ++nInfrastructureInterests;
+    }
+    else {
+      nextHops.insert(nextHopFaceIdTag->get());
+    }
+  }
+  // each certificate is fetched once from the infrastructure and once from each face
+  BOOST_CHECK_EQUAL(nInfrastructureInterests, 2);
+  BOOST_CHECK_EQUAL(nextHops.count(123), 2);
+  BOOST_CHECK_EQUAL(nextHops.count(456), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateFetcherDirectFetch
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
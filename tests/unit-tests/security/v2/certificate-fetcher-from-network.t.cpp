@@ -128,6 +128,71 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ValidateFailure, T, Failures, CertificateFetche
   BOOST_CHECK_GT(this->face.sentInterests.size(), 2);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(UnretrievableCache, T, Failures,
+                                 CertificateFetcherFromNetworkFixture<T>)
+{
+  VALIDATE_FAILURE(this->data, "Should fail, as interests don't bring data");
+  BOOST_CHECK_GT(this->face.sentInterests.size(), 2);
+  this->face.sentInterests.clear();
+
+  // the certificate is known to be unretrievable, so no Interest is sent
+  auto nHits = this->validator.getUnretrievableCertCache().getNHits();
+  VALIDATE_FAILURE(this->interest, "Should fail, as the certificate recently could not be "
+                                    "retrieved");
+  BOOST_CHECK_EQUAL(this->face.sentInterests.size(), 0);
+  BOOST_CHECK_EQUAL(this->validator.getUnretrievableCertCache().getNHits(), nHits + 1);
+
+  this->validator.resetUnretrievableCertificates();
+  VALIDATE_FAILURE(this->interest, "Should fail, as interests don't bring data");
+  BOOST_CHECK_GT(this->face.sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(CoalesceRequests, CertificateFetcherFromNetworkFixture<Cert>)
+{
+  size_t nValidated = 0;
+  auto onSuccess = [&] (const auto&) { ++nValidated; };
+  auto onFailure = [] (const auto&, const ValidationError& error) { BOOST_ERROR(error); };
+
+  // both packets are signed by the same uncached certificate
+  this->validator.validate(this->data, onSuccess, onFailure);
+  this->validator.validate(this->interest, onSuccess, onFailure);
+  this->mockNetworkOperations();
+
+  BOOST_CHECK_EQUAL(nValidated, 2);
+  BOOST_CHECK_EQUAL(this->face.sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(RetryBackoff, CertificateFetcherFromNetworkFixture<Nack>)
+{
+  std::vector<time::steady_clock::TimePoint> sendTimes;
+  util::signal::ScopedConnection connection =
+    this->face.onSendInterest.connect([&] (const Interest& interest) {
+      sendTimes.push_back(time::steady_clock::now());
+      this->io.post(bind(this->processInterest, interest));
+    });
+
+  bool hasFailed = false;
+  this->validator.validate(this->data,
+                           [] (const Data&) { BOOST_ERROR("validation should fail"); },
+                           [&] (const Data&, const ValidationError& error) {
+                             BOOST_CHECK_EQUAL(error.getCode(),
+                                               ValidationError::Code::CANNOT_RETRIEVE_CERT);
+                             hasFailed = true;
+                           });
+  this->advanceClocks(5_ms, 1000);
+  BOOST_CHECK(hasFailed);
+
+  // initial Interest and 3 retries, with randomized delays from non-overlapping, growing ranges
+  BOOST_REQUIRE_EQUAL(sendTimes.size(), 4);
+  time::nanoseconds previousGap = 0_ns;
+  for (size_t i = 1; i < sendTimes.size(); ++i) {
+    time::nanoseconds gap = sendTimes[i] - sendTimes[i - 1];
+    BOOST_CHECK_GE(gap, CertificateFetcherFromNetwork::INITIAL_RETRY_BACKOFF * (1 << (i - 1)) / 2);
+    BOOST_CHECK_GT(gap, previousGap);
+    previousGap = gap;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateFetcherFromNetwork
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
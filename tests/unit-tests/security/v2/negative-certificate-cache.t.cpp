@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/negative-certificate-cache.hpp"
+
+#include "boost-test.hpp"
+#include "../../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_FIXTURE_TEST_SUITE(TestNegativeCertificateCache, ndn::tests::UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Ttl)
+{
+  NegativeCertificateCache cache(10_s, 10);
+
+  cache.insert("/A/KEY");
+  BOOST_CHECK(cache.find("/A/KEY"));
+  BOOST_CHECK(!cache.find("/A"));
+  BOOST_CHECK(!cache.find("/A/KEY/1"));
+
+  advanceClocks(6_s);
+  BOOST_CHECK(cache.find("/A/KEY"));
+  cache.insert("/A/KEY"); // extends removal time
+
+  advanceClocks(6_s);
+  BOOST_CHECK(cache.find("/A/KEY"));
+
+  advanceClocks(6_s);
+  BOOST_CHECK(!cache.find("/A/KEY"));
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  NegativeCertificateCache cache(10_s, 3);
+
+  for (int i = 0; i < 3; ++i) {
+    cache.insert(Name("/A").appendNumber(i));
+    advanceClocks(1_s);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 3);
+
+  cache.insert("/B");
+  BOOST_CHECK_EQUAL(cache.size(), 3);
+  BOOST_CHECK(!cache.find(Name("/A").appendNumber(0)));
+  BOOST_CHECK(cache.find(Name("/A").appendNumber(1)));
+  BOOST_CHECK(cache.find(Name("/A").appendNumber(2)));
+  BOOST_CHECK(cache.find("/B"));
+
+  cache.erase("/B");
+  BOOST_CHECK(!cache.find("/B"));
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  NegativeCertificateCache cache;
+  BOOST_CHECK_EQUAL(cache.getNHits(), 0);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 0);
+
+  BOOST_CHECK(!cache.find("/A/KEY"));
+  cache.insert("/A/KEY");
+  BOOST_CHECK(cache.find("/A/KEY"));
+  BOOST_CHECK(cache.find("/A/KEY"));
+  BOOST_CHECK_EQUAL(cache.getNHits(), 2);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNegativeCertificateCache
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
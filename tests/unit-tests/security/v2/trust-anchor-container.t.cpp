@@ -26,6 +26,7 @@
 #include "boost-test.hpp"
 
 #include <boost/filesystem.hpp>
+#include <fstream>
 
 namespace ndn {
 namespace security {
@@ -156,6 +157,81 @@ BOOST_AUTO_TEST_CASE(DynamicAnchorFromDir)
   BOOST_CHECK_EQUAL(anchorContainer.getGroup("group").size(), 0);
 }
 
+#ifdef NDN_CXX_HAVE_INOTIFY
+BOOST_AUTO_TEST_CASE(WatchDir)
+{
+  boost::filesystem::remove(certPath2);
+
+  anchorContainer.enableWatch(io);
+  anchorContainer.insert("group", certDirPath.string(), 1_h, true /* isDir */);
+  auto& group = dynamic_cast<DynamicTrustAnchorGroup&>(anchorContainer.getGroup("group"));
+  BOOST_CHECK(group.isWatching());
+  BOOST_CHECK(anchorContainer.find(identity1.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 1);
+
+  // changes are applied without waiting for the refresh period
+  saveCertToFile(cert2, certPath2.string());
+  advanceClocks(1_ms);
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 2);
+
+  boost::filesystem::remove(certPath1);
+  advanceClocks(1_ms);
+  BOOST_CHECK(anchorContainer.find(identity1.getName()) == nullptr);
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 1);
+
+  // files that are not certificates are ignored
+  std::ofstream(certPath1.string()) << "not a certificate";
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(group.size(), 1);
+
+  // the group becomes empty when the directory is removed, and polls until it is recreated
+  boost::filesystem::remove_all(certDirPath);
+  advanceClocks(1_ms);
+  BOOST_CHECK(!group.isWatching());
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) == nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 0);
+
+  boost::filesystem::create_directory(certDirPath);
+  saveCertToFile(cert1, certPath1.string());
+  advanceClocks(1_h, 2);
+  BOOST_CHECK(anchorContainer.find(identity1.getName()) != nullptr);
+  BOOST_CHECK(group.isWatching());
+
+  saveCertToFile(cert2, certPath2.string());
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(group.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(WatchFile)
+{
+  anchorContainer.enableWatch(io);
+  anchorContainer.insert("group", certPath1.string(), 1_h);
+  auto& group = dynamic_cast<DynamicTrustAnchorGroup&>(anchorContainer.getGroup("group"));
+  BOOST_CHECK(group.isWatching());
+  BOOST_CHECK(anchorContainer.find(identity1.getName()) != nullptr);
+
+  // other files in the same directory are ignored
+  boost::filesystem::remove(certPath2);
+  saveCertToFile(cert2, certPath2.string());
+  advanceClocks(1_ms);
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) == nullptr);
+
+  // atomic replacement of the watched file
+  boost::filesystem::rename(certPath2, certPath1);
+  advanceClocks(1_ms);
+  BOOST_CHECK(anchorContainer.find(identity1.getName()) == nullptr);
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) != nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 1);
+
+  boost::filesystem::remove(certPath1);
+  advanceClocks(1_ms);
+  BOOST_CHECK(anchorContainer.find(identity2.getName()) == nullptr);
+  BOOST_CHECK_EQUAL(group.size(), 0);
+}
+#endif // NDN_CXX_HAVE_INOTIFY
+
 BOOST_FIXTURE_TEST_CASE(FindByInterest, AnchorContainerTestFixture)
 {
   anchorContainer.insert("group1", certPath1.string(), 1_s);
@@ -360,6 +360,45 @@ BOOST_FIXTURE_TEST_CASE(LimitedRecords, ValidationPolicyCommandInterestFixture<L
   VALIDATE_SUCCESS(i01, "Should succeed despite timestamp is reordered, because record has been evicted");
 }
 
+BOOST_FIXTURE_TEST_CASE(LimitedRecordsRefresh, ValidationPolicyCommandInterestFixture<LimitedRecordsOptions>)
+{
+  Identity id1 = this->addSubCertificate("/Security/V2/ValidatorFixture/Sub1", identity);
+  this->cache.insert(id1.getDefaultKey().getDefaultCertificate());
+  Identity id2 = this->addSubCertificate("/Security/V2/ValidatorFixture/Sub2", identity);
+  this->cache.insert(id2.getDefaultKey().getDefaultCertificate());
+  Identity id3 = this->addSubCertificate("/Security/V2/ValidatorFixture/Sub3", identity);
+  this->cache.insert(id3.getDefaultKey().getDefaultCertificate());
+  Identity id4 = this->addSubCertificate("/Security/V2/ValidatorFixture/Sub4", identity);
+  this->cache.insert(id4.getDefaultKey().getDefaultCertificate());
+
+  auto i10 = makeCommandInterest(id1); // signed at 0s
+  auto i20 = makeCommandInterest(id2); // signed at 0s
+  auto i3 = makeCommandInterest(id3);
+  auto i4 = makeCommandInterest(id4);
+  advanceClocks(1_s);
+  auto i11 = makeCommandInterest(id1); // signed at 1s
+
+  VALIDATE_SUCCESS(i10, "Should succeed");
+  rewindClockAfterValidation();
+
+  VALIDATE_SUCCESS(i20, "Should succeed");
+  rewindClockAfterValidation();
+
+  VALIDATE_SUCCESS(i3, "Should succeed");
+  rewindClockAfterValidation();
+
+  VALIDATE_SUCCESS(i11, "Should succeed, refreshes the record of id1");
+  rewindClockAfterValidation();
+
+  VALIDATE_SUCCESS(i4, "Should succeed, forgets identity id2 rather than id1");
+  rewindClockAfterValidation();
+
+  VALIDATE_FAILURE(i11, "Should fail, because the record of id1 is kept");
+  rewindClockAfterValidation();
+
+  VALIDATE_SUCCESS(i20, "Should succeed despite timestamp is not newer, because record has been evicted");
+}
+
 class UnlimitedRecordsOptions
 {
 public:
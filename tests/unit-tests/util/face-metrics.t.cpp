@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/face-metrics.hpp"
+#include "mgmt/dispatcher.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "../identity-management-time-fixture.hpp"
+#include "make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestFaceMetrics)
+
+BOOST_AUTO_TEST_CASE(HistogramBuckets)
+{
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(-1_ms), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(999_ns), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(3_us), 3);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(4_us), 4);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(7_us), 7);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(8_us), 8);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(9_us), 8);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(10_us), 9);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::days(365)),
+                    LatencyHistogram::N_BUCKETS - 1);
+
+  for (size_t i = 0; i < LatencyHistogram::N_BUCKETS; ++i) {
+    time::nanoseconds lowerBound = LatencyHistogram::getBucketLowerBound(i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(lowerBound), i);
+    if (i > 0) {
+      BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(lowerBound - 1_us), i - 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HistogramQuantile)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), 0_ns);
+
+  histogram.add(1_ms, 90);
+  histogram.add(100_ms, 10);
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.0), 896_us);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.9), 896_us);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.91), 98304_us);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0), 98304_us);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  FaceMetrics metrics;
+  metrics.nInInterests = 1;
+  metrics.nInData = 2;
+  metrics.nInNacks = 3;
+  metrics.nOutInterests = 4;
+  metrics.nOutData = 5;
+  metrics.nOutNacks = 6;
+  metrics.nSatisfiedInterests = 7;
+  metrics.nTimedOutInterests = 8;
+  metrics.nNackedInterests = 9;
+  metrics.nPitEntries = 10;
+  metrics.maxPitEntries = 11;
+  metrics.sendQueueLength = 12;
+  metrics.sendQueueBytes = 13;
+  metrics.nSuppressedInterests = 16;
+  metrics.satisfyLatency.add(5_ms, 14);
+  metrics.satisfyLatency.add(5_s, 15);
+
+  Block wire = metrics.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), tlv::Content);
+
+  FaceMetrics decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.nInInterests, 1);
+  BOOST_CHECK_EQUAL(decoded.nInData, 2);
+  BOOST_CHECK_EQUAL(decoded.nInNacks, 3);
+  BOOST_CHECK_EQUAL(decoded.nOutInterests, 4);
+  BOOST_CHECK_EQUAL(decoded.nOutData, 5);
+  BOOST_CHECK_EQUAL(decoded.nOutNacks, 6);
+  BOOST_CHECK_EQUAL(decoded.nSatisfiedInterests, 7);
+  BOOST_CHECK_EQUAL(decoded.nTimedOutInterests, 8);
+  BOOST_CHECK_EQUAL(decoded.nNackedInterests, 9);
+  BOOST_CHECK_EQUAL(decoded.nPitEntries, 10);
+  BOOST_CHECK_EQUAL(decoded.maxPitEntries, 11);
+  BOOST_CHECK_EQUAL(decoded.sendQueueLength, 12);
+  BOOST_CHECK_EQUAL(decoded.sendQueueBytes, 13);
+  BOOST_CHECK_EQUAL(decoded.nSuppressedInterests, 16);
+  BOOST_CHECK_EQUAL(decoded.satisfyLatency.getCount(), 29);
+  const LatencyHistogram& latency = decoded.satisfyLatency;
+  BOOST_CHECK_EQUAL(latency.getBucketCount(LatencyHistogram::getBucketIndex(5_ms)), 14);
+  BOOST_CHECK_EQUAL(latency.getBucketCount(LatencyHistogram::getBucketIndex(5_s)), 15);
+
+  BOOST_CHECK_THROW(FaceMetrics(Block(tlv::Name)), FaceMetrics::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Collector)
+{
+  FaceMetricsCollector collector;
+  collector.recordOutInterest();
+  collector.recordOutInterest();
+  collector.recordInData();
+  collector.recordSatisfiedInterest(20_ms);
+  collector.recordTimedOutInterest();
+  collector.recordSuppressedInterest();
+  collector.recordPitSize(5);
+  collector.recordPitSize(2);
+
+  FaceMetrics metrics = collector.snapshot();
+  BOOST_CHECK_EQUAL(metrics.nOutInterests, 2);
+  BOOST_CHECK_EQUAL(metrics.nInData, 1);
+  BOOST_CHECK_EQUAL(metrics.nSatisfiedInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nTimedOutInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nSuppressedInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nPitEntries, 2);
+  BOOST_CHECK_EQUAL(metrics.maxPitEntries, 5);
+  BOOST_CHECK_EQUAL(metrics.satisfyLatency.getQuantile(0.5),
+                    LatencyHistogram::getBucketLowerBound(LatencyHistogram::getBucketIndex(20_ms)));
+}
+
+BOOST_FIXTURE_TEST_CASE(StatusDataset, IdentityManagementTimeFixture)
+{
+  DummyClientFace face(io, m_keyChain, {true, true});
+  mgmt::Dispatcher dispatcher(face, m_keyChain);
+  dispatcher.addStatusDataset("face-metrics", mgmt::makeAcceptAllAuthorization(),
+                              makeFaceMetricsDatasetHandler(face));
+  dispatcher.addTopPrefix("/localhost/app", false);
+  advanceClocks(1_ms);
+
+  face.expressInterest(*makeInterest("/A"), nullptr, nullptr, nullptr);
+  advanceClocks(1_ms);
+
+  face.receive(*makeInterest("/localhost/app/face-metrics"));
+  advanceClocks(1_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  const Data& data = face.sentData.back();
+  FaceMetrics metrics(Block(tlv::Content, make_shared<Buffer>(data.getContent().value(),
+                                                              data.getContent().value_size())));
+  BOOST_CHECK_EQUAL(metrics.nOutInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nInInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nPitEntries, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceMetrics
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/face-pool.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+#include "make-interest-data.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class FacePoolFixture : public IdentityManagementFixture
+{
+protected:
+  /** \brief make a FaceCreator whose Faces answer every Interest with Data,
+   *         unless the Interest name starts with /drop
+   */
+  FacePool::FaceCreator
+  makeAnsweringFaces()
+  {
+    return [this] (boost::asio::io_service& io) {
+      auto face = make_unique<DummyClientFace>(io, m_keyChain,
+                                               DummyClientFace::Options{false, false});
+      DummyClientFace* facePtr = face.get();
+      face->onSendInterest.connect([facePtr] (const Interest& interest) {
+        if (Name("/drop").isPrefixOf(interest.getName())) {
+          return;
+        }
+        auto data = makeData(interest.getName());
+        facePtr->getIoService().post([facePtr, data] { facePtr->receive(*data); });
+      });
+      return face;
+    };
+  }
+
+  /** \brief process callbackIo until \p pred is satisfied or 5 seconds have elapsed
+   *
+   *  Each iteration blocks until a callback is posted to callbackIo, so the wait ends as
+   *  soon as the last expected callback has been processed.
+   */
+  template<typename Predicate>
+  void
+  waitUntil(const Predicate& pred)
+  {
+    bool hasExpired = false;
+    boost::asio::steady_timer deadline(callbackIo, std::chrono::seconds(5));
+    deadline.async_wait([&] (const boost::system::error_code& error) {
+      hasExpired = !error;
+    });
+
+    callbackIo.reset();
+    while (!pred() && !hasExpired) {
+      callbackIo.run_one();
+    }
+    deadline.cancel();
+    callbackIo.reset();
+    callbackIo.poll();
+  }
+
+protected:
+  boost::asio::io_service callbackIo;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestFacePool, FacePoolFixture)
+
+BOOST_AUTO_TEST_CASE(ZeroFaces)
+{
+  BOOST_CHECK_THROW(FacePool(0, FacePool::ShardingPolicy::NAME_HASH, makeAnsweringFaces()),
+                    FacePool::Error);
+}
+
+BOOST_AUTO_TEST_CASE(NameHash)
+{
+  FacePool pool(4, FacePool::ShardingPolicy::NAME_HASH, makeAnsweringFaces());
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+
+  std::set<size_t> used;
+  for (int i = 0; i < 100; ++i) {
+    Name name = Name("/A").appendNumber(i);
+    size_t index = pool.selectFace(name);
+    BOOST_CHECK_LT(index, 4);
+    BOOST_CHECK_EQUAL(pool.selectFace(name), index);
+    used.insert(index);
+  }
+  BOOST_CHECK_GT(used.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RoundRobin)
+{
+  FacePool pool(3, FacePool::ShardingPolicy::ROUND_ROBIN, makeAnsweringFaces());
+
+  for (size_t i = 0; i < 9; ++i) {
+    BOOST_CHECK_EQUAL(pool.selectFace("/A"), i % 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MergedData)
+{
+  FacePool pool(callbackIo, 3, FacePool::ShardingPolicy::ROUND_ROBIN, makeAnsweringFaces());
+
+  const size_t nInterests = 30;
+  size_t nData = 0;
+  std::set<size_t> faces;
+  for (size_t i = 0; i < nInterests; ++i) {
+    auto handle = pool.expressInterest(*makeInterest(Name("/A").appendNumber(i)),
+                                       [&] (const Interest& interest, const Data& data) {
+                                         BOOST_CHECK_EQUAL(interest.getName(), data.getName());
+                                         ++nData;
+                                       },
+                                       bind([] { BOOST_ERROR("unexpected Nack"); }),
+                                       bind([] { BOOST_ERROR("unexpected timeout"); }));
+    faces.insert(handle.getFaceIndex());
+  }
+  BOOST_CHECK_EQUAL(faces.size(), 3);
+
+  waitUntil([&] { return nData == nInterests; });
+  BOOST_CHECK_EQUAL(nData, nInterests);
+}
+
+BOOST_AUTO_TEST_CASE(MergedTimeout)
+{
+  FacePool pool(callbackIo, 2, FacePool::ShardingPolicy::NAME_HASH, makeAnsweringFaces());
+
+  size_t nTimeouts = 0;
+  for (int i = 0; i < 4; ++i) {
+    pool.expressInterest(*makeInterest(Name("/drop").appendNumber(i), false, 50_ms),
+                         bind([] { BOOST_ERROR("unexpected Data"); }),
+                         bind([] { BOOST_ERROR("unexpected Nack"); }),
+                         [&] (const Interest&) { ++nTimeouts; });
+  }
+
+  waitUntil([&] { return nTimeouts == 4; });
+  BOOST_CHECK_EQUAL(nTimeouts, 4);
+}
+
+BOOST_AUTO_TEST_CASE(RemovePendingInterest)
+{
+  // a single Face times out Interests in expiry order and posts the callbacks in that order,
+  // so /drop/1 would be reported before /drop/2 had it not been removed
+  FacePool pool(callbackIo, 1, FacePool::ShardingPolicy::NAME_HASH, makeAnsweringFaces());
+
+  std::vector<Name> timedOut;
+  auto onTimeout = [&] (const Interest& interest) { timedOut.push_back(interest.getName()); };
+  auto handle = pool.expressInterest(*makeInterest("/drop/1", false, 50_ms),
+                                     nullptr, nullptr, onTimeout);
+  pool.expressInterest(*makeInterest("/drop/2", false, 200_ms), nullptr, nullptr, onTimeout);
+  pool.removePendingInterest(handle);
+
+  waitUntil([&] { return !timedOut.empty(); });
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 1);
+  BOOST_CHECK_EQUAL(timedOut.front(), "/drop/2");
+}
+
+BOOST_AUTO_TEST_CASE(Shutdown)
+{
+  FacePool pool(2, FacePool::ShardingPolicy::NAME_HASH, makeAnsweringFaces());
+  pool.expressInterest(*makeInterest("/drop/1", false, 10_s), nullptr, nullptr, nullptr);
+  pool.shutdown(); // should not block until the Interest times out
+  pool.shutdown(); // no effect
+  BOOST_CHECK(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFacePool
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -26,6 +26,8 @@
 #include "security/detail/openssl.hpp"
 
 #include <cmath>
+#include <set>
+#include <thread>
 
 namespace ndn {
 namespace tests {
@@ -136,6 +138,56 @@ BOOST_AUTO_TEST_CASE(GenerateRandomBytes)
   BOOST_WARN_LE(getDeviation(counts, sizeof(buf)), 0.230);
 }
 
+BOOST_AUTO_TEST_CASE(Engine)
+{
+  random::RandomNumberEngine e1(42);
+  random::RandomNumberEngine e2(42);
+  random::RandomNumberEngine e3(43);
+  for (int i = 0; i < 10; ++i) {
+    uint64_t n = e1();
+    BOOST_CHECK_EQUAL(n, e2());
+    BOOST_CHECK_NE(n, e3());
+  }
+
+  std::uniform_int_distribution<int> distribution(1, 6);
+  for (int i = 0; i < 100; ++i) {
+    int n = distribution(random::getRandomNumberEngine());
+    BOOST_CHECK_GE(n, 1);
+    BOOST_CHECK_LE(n, 6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PerThreadEngine)
+{
+  random::RandomNumberEngine* mainEngine = &random::getRandomNumberEngine();
+  BOOST_CHECK_EQUAL(&random::getRandomNumberEngine(), mainEngine);
+
+  random::RandomNumberEngine* otherEngine = nullptr;
+  uint64_t otherNumber = 0;
+  std::thread thread([&] {
+    otherEngine = &random::getRandomNumberEngine();
+    otherNumber = random::generateWord64();
+  });
+  thread.join();
+  BOOST_CHECK_NE(otherEngine, mainEngine);
+  BOOST_CHECK_NE(otherNumber, random::generateWord64());
+}
+
+BOOST_AUTO_TEST_CASE(SecureBytesPool)
+{
+  // small requests are served from a pool, and never return the same bytes twice
+  std::set<uint64_t> words;
+  for (int i = 0; i < 1000; ++i) {
+    words.insert(random::generateSecureWord64());
+  }
+  BOOST_CHECK_EQUAL(words.size(), 1000);
+
+  uint8_t buf[32] = {0};
+  uint8_t zeros[32] = {0};
+  random::generateSecureBytes(buf, sizeof(buf));
+  BOOST_CHECK_NE(std::memcmp(buf, zeros, sizeof(buf)), 0);
+}
+
 // This fixture uses OpenSSL routines to set a dummy random generator that always fails
 class FailRandMethodFixture
 {
@@ -20,12 +20,14 @@
  */
 
 #include "util/string-helper.hpp"
+#include "util/detail/text-codec.hpp"
 #include "encoding/buffer.hpp"
 
 #include "boost-test.hpp"
 
 #include <cctype>
 #include <cstring>
+#include <random>
 
 namespace ndn {
 namespace util {
@@ -107,6 +109,115 @@ BOOST_AUTO_TEST_CASE(FromHex)
   BOOST_CHECK_THROW(fromHex("1234z"), StringHelperError);
 }
 
+BOOST_AUTO_TEST_CASE(ToBase64)
+{
+  auto encode = [] (const std::string& s, bool needBreak) {
+    return toBase64(reinterpret_cast<const uint8_t*>(s.data()), s.size(), needBreak);
+  };
+
+  // RFC 4648 section 10
+  BOOST_CHECK_EQUAL(encode("", false), "");
+  BOOST_CHECK_EQUAL(encode("f", false), "Zg==");
+  BOOST_CHECK_EQUAL(encode("fo", false), "Zm8=");
+  BOOST_CHECK_EQUAL(encode("foo", false), "Zm9v");
+  BOOST_CHECK_EQUAL(encode("foob", false), "Zm9vYg==");
+  BOOST_CHECK_EQUAL(encode("fooba", false), "Zm9vYmE=");
+  BOOST_CHECK_EQUAL(encode("foobar", false), "Zm9vYmFy");
+
+  BOOST_CHECK_EQUAL(encode("", true), "");
+  BOOST_CHECK_EQUAL(encode("foobar", true), "Zm9vYmFy\n");
+  BOOST_CHECK_EQUAL(encode(std::string(48, '\xff'), true), std::string(64, '/') + "\n");
+  BOOST_CHECK_EQUAL(encode(std::string(49, '\xff'), true), std::string(64, '/') + "\n/w==\n");
+  BOOST_CHECK_EQUAL(encode(std::string(49, '\xff'), false), std::string(64, '/') + "/w==");
+
+  const uint8_t bytes[] = {0xfb, 0xff, 0xbf};
+  Buffer buffer(bytes, sizeof(bytes));
+  BOOST_CHECK_EQUAL(toBase64(buffer), "+/+/\n");
+  BOOST_CHECK_EQUAL(toBase64(Buffer{}), "");
+}
+
+BOOST_AUTO_TEST_CASE(FromBase64)
+{
+  auto decode = [] (const std::string& s) {
+    auto buffer = fromBase64(s);
+    return std::string(buffer->begin(), buffer->end());
+  };
+
+  BOOST_CHECK_EQUAL(decode(""), "");
+  BOOST_CHECK_EQUAL(decode("Zg=="), "f");
+  BOOST_CHECK_EQUAL(decode("Zm8="), "fo");
+  BOOST_CHECK_EQUAL(decode("Zm9v"), "foo");
+  BOOST_CHECK_EQUAL(decode("Zm9vYg=="), "foob");
+  BOOST_CHECK_EQUAL(decode("Zm9vYmE="), "fooba");
+  BOOST_CHECK_EQUAL(decode("Zm9vYmFy"), "foobar");
+  BOOST_CHECK_EQUAL(decode("+/+/"), "\xfb\xff\xbf");
+
+  // whitespace is ignored anywhere
+  BOOST_CHECK_EQUAL(decode("Zm9v\nYmE=\n"), "fooba");
+  BOOST_CHECK_EQUAL(decode(" Z m 9 v\r\n\tYg =\n= "), "foob");
+  BOOST_CHECK_EQUAL(decode(std::string(64, '/') + "\n/w==\n"), std::string(49, '\xff'));
+
+  BOOST_CHECK_THROW(fromBase64("Zm9"), StringHelperError); // incomplete group
+  BOOST_CHECK_THROW(fromBase64("Zg="), StringHelperError); // incomplete padding
+  BOOST_CHECK_THROW(fromBase64("Z==="), StringHelperError); // too much padding
+  BOOST_CHECK_THROW(fromBase64("=Zg="), StringHelperError);
+  BOOST_CHECK_THROW(fromBase64("Zg==Zg=="), StringHelperError); // data after padding
+  BOOST_CHECK_THROW(fromBase64("Zm9v-_-_"), StringHelperError); // base64url alphabet
+  BOOST_CHECK_THROW(fromBase64(std::string(64, 'A') + "*AAA"), StringHelperError);
+}
+
+BOOST_AUTO_TEST_CASE(SimdLevels)
+{
+  using detail::SimdLevel;
+
+  std::mt19937 rng(20180101);
+  std::vector<Buffer> inputs;
+  for (size_t size = 0; size < 300; ++size) {
+    Buffer input(size);
+    std::generate(input.begin(), input.end(), [&rng] { return static_cast<uint8_t>(rng()); });
+    inputs.push_back(std::move(input));
+  }
+
+  // reference results from the scalar code path
+  SimdLevel defaultLevel = detail::getSimdLevel();
+  detail::setSimdLevel(SimdLevel::NONE);
+  std::vector<std::string> hex, base64;
+  for (const Buffer& input : inputs) {
+    hex.push_back(toHex(input, false));
+    base64.push_back(toBase64(input));
+  }
+
+  for (SimdLevel level : {SimdLevel::SSSE3, SimdLevel::AVX2}) {
+    if (detail::setSimdLevel(level) != level) {
+      BOOST_TEST_MESSAGE("SIMD level " << static_cast<int>(level) << " is not supported");
+      continue;
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      BOOST_CHECK_EQUAL(toHex(inputs[i], false), hex[i]);
+      BOOST_CHECK(*fromHex(hex[i]) == inputs[i]);
+      BOOST_CHECK_EQUAL(toBase64(inputs[i]), base64[i]);
+      BOOST_CHECK(*fromBase64(base64[i]) == inputs[i]);
+
+      if (i > 0) {
+        // an invalid character in any position is detected
+        std::string badHex = hex[i];
+        badHex[rng() % badHex.size()] = 'g';
+        BOOST_CHECK_THROW(fromHex(badHex), StringHelperError);
+
+        std::string badBase64 = base64[i];
+        size_t pos = rng() % badBase64.size();
+        if (badBase64[pos] != '\n') {
+          badBase64[pos] = '*';
+          BOOST_CHECK_THROW(fromBase64(badBase64), StringHelperError);
+        }
+      }
+    }
+  }
+
+  detail::setSimdLevel(defaultLevel);
+}
+
 BOOST_AUTO_TEST_CASE(ToHexChar)
 {
   static const std::vector<std::pair<unsigned int, char>> hexMap{